@@ -1,6 +1,12 @@
 #include "api.h"
 #include "Arduino.h"
+#include "ptx_serial_tx.h"
+#include "ptx_io.h"
+#include "ptx_adc_sampler.h"
+#include "ptx_sensor_filter.h"
+#include <avr/eeprom.h>
 #include <stdarg.h>
+#include <string.h>
 
 // NOTE!!!
 // Don't assume the below API follows good coding or PTx conventions.
@@ -27,57 +33,52 @@ static void door_sensor_IRQ_handler()
 }
 
 // returns voltage in millivolts
+// Run-time entry points; the pin/channel mapping and scaling live in ptx_io.h
 uint16_t read_voltage(input_t input)
-{ 
-  if (input == TEMPERATURE_SENSOR)
+{
+#if PTX_ADC_SAMPLER_ENABLED
+  // The sampler owns the ADC: report its latest reading instead of converting
+  uint16_t vref_mv_q;
+  uint16_t signal_mv_q;
+  ptx_adc_sampler_last_mv_q(&vref_mv_q, &signal_mv_q);
+  switch (input)
   {
-    return (uint32_t)analogRead(A0) * 5000 / 1023;
-    //return //450 ~-10V;//2598 ~175;//2715 ~185;//2656;//~180
+    case TEMPERATURE_SENSOR:           return (uint16_t)(signal_mv_q >> PTX_OVERSAMPLE_BITS);
+    case TEMPERATURE_SENSOR_REFERENCE: return (uint16_t)(vref_mv_q >> PTX_OVERSAMPLE_BITS);
+    default:                           return 0;
   }
-  else if (input == TEMPERATURE_SENSOR_REFERENCE)
+#else
+  switch (input)
   {
-    //return (uint32_t)analogRead(A1) * 5000 / 1023;
-    return ((uint32_t)analogRead(A1) * 1000 / 1023) + 4500; //Range from 4.5V to 5.5V for easier testing
-    //return 4500;
+    case TEMPERATURE_SENSOR:           return ptx_io_read_mv<TEMPERATURE_SENSOR>();
+    case TEMPERATURE_SENSOR_REFERENCE: return ptx_io_read_mv<TEMPERATURE_SENSOR_REFERENCE>();
+    default:                           return 0;
   }
-
-  return 0;
+#endif
 }
 
 // true for on, false for off
 void set_output(output_t output, bool output_state)
 {
-  if (output == GAS_VALVE)
-  {
-    digitalWrite(GAS_VALVE_PIN, output_state);
-  }
-  else if (output == SYS_LED_STATUS)
-  {
-    digitalWrite(SYS_LED_STATUS_PIN, output_state);
-  }
-  else if (output == IGNITER)
+  switch (output)
   {
-    digitalWrite(IGNITER_PIN, output_state);
+    case GAS_VALVE:      ptx_io_write<GAS_VALVE>(output_state); break;
+    case SYS_LED_STATUS: ptx_io_write<SYS_LED_STATUS>(output_state); break;
+    case IGNITER:        ptx_io_write<IGNITER>(output_state); break;
+    default:             break;
   }
-
 }
 
 // read current output state
 bool read_output(output_t output)
 {
-  if (output == GAS_VALVE)
-  {
-    return digitalRead(GAS_VALVE_PIN) == HIGH;
-  }
-  else if (output == SYS_LED_STATUS)
+  switch (output)
   {
-    return digitalRead(SYS_LED_STATUS_PIN) == HIGH;
+    case GAS_VALVE:      return ptx_io_read<GAS_VALVE>();
+    case SYS_LED_STATUS: return ptx_io_read<SYS_LED_STATUS>();
+    case IGNITER:        return ptx_io_read<IGNITER>();
+    default:             return false;
   }
-  else if (output == IGNITER)
-  {
-    return digitalRead(IGNITER_PIN) == HIGH;
-  }
-  return false;
 }
 
 uint32_t get_millis()
@@ -93,5 +94,31 @@ void serial_printf(const char * format, ...)
   vsnprintf(buffer, 256, format, args);
   va_end (args);
 
-  Serial.print(buffer);
+  ptx_serial_tx_write(buffer, (uint16_t)strlen(buffer), PTX_TX_PRIO_NORMAL);
+}
+
+void serial_service(void)
+{
+  const uint8_t* data;
+  uint16_t count;
+
+  while ((count = ptx_serial_tx_peek(&data)) > 0U)
+  {
+    int room = Serial.availableForWrite();
+    if (room <= 0) break;
+    if (count > (uint16_t)room) count = (uint16_t)room;
+
+    Serial.write(data, count);
+    ptx_serial_tx_consume(count);
+  }
+}
+
+void read_eeprom(uint16_t address, void * data, uint16_t length)
+{
+  eeprom_read_block(data, (const void *)(uintptr_t)address, length);
+}
+
+void update_eeprom(uint16_t address, const void * data, uint16_t length)
+{
+  eeprom_update_block(data, (void *)(uintptr_t)address, length);
 }
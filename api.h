@@ -46,6 +46,7 @@ typedef enum
 void setup_api();
 
 // returns voltage in millivolts
+// With PTX_ADC_SAMPLER_ENABLED, the sampler's latest reading (ptx_adc_sampler.h): it owns the ADC
 uint16_t read_voltage(input_t input);
 
 /**
@@ -66,8 +67,22 @@ bool read_output(output_t output);
 uint32_t get_millis();
 
 // note that float %f format is not supported
+// queued in the serial TX queue, never blocks (dropped if the queue is full)
 void serial_printf(const char * format, ...);
 
+// write queued serial output, only as much as the UART buffer takes without blocking
+// call once per loop()
+void serial_service(void);
+
+#define EEPROM_SIZE_BYTES       1024U   //ATmega328P
+
+// copy length bytes of EEPROM from address into data
+void read_eeprom(uint16_t address, void * data, uint16_t length);
+// write length bytes of data to EEPROM at address
+// only bytes that differ are written: each cell wears out with erase/write cycles
+// blocks ~3.4 ms per byte written
+void update_eeprom(uint16_t address, const void * data, uint16_t length);
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,299 @@
+/**
+ * @file ptx_batch.cpp
+ * @brief Implementation of the batched control step (scalar and AVX2 kernels)
+ */
+#include "gateway/ptx_batch.h"
+#include "ptx_oven_control.h"
+#include "ptx_temperature.h"
+#include "ptx_calibration.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define PTI_BATCH_AVX2 1
+#include <immintrin.h>
+#else
+#define PTI_BATCH_AVX2 0
+#endif
+
+/* Calibration tables are addressed as int32 offsets from the first one */
+#define PTI_CAL_STRIDE      ((int32_t)(sizeof(ptx_cal_table_t) / sizeof(int32_t)))
+#define PTI_CAL_MIN_IDX     ((int32_t)(offsetof(ptx_cal_table_t, temp_min_mc) / sizeof(int32_t)))
+#define PTI_CAL_MAX_IDX     ((int32_t)(offsetof(ptx_cal_table_t, temp_max_mc) / sizeof(int32_t)))
+
+static const int32_t* pti_cal_base(void) {
+    return ptx_cal_get_table(0)->temp_mc;
+}
+
+static const ptx_cal_table_t* pti_cal_at(int32_t offset) {
+    return (const ptx_cal_table_t*)(pti_cal_base() + offset);
+}
+
+template <typename T>
+static bool pti_alloc(T** field, uint32_t n) {
+    *field = (T*)calloc(n, sizeof(T));
+    return *field != NULL;
+}
+
+bool ptx_batch_init(ptx_batch_t* batch, uint32_t count) {
+    memset(batch, 0, sizeof(*batch));
+    uint32_t cap = (count + PTX_BATCH_LANES - 1U) & ~(PTX_BATCH_LANES - 1U);
+
+    bool ok = pti_alloc(&batch->vref_mv, cap) && pti_alloc(&batch->signal_mv, cap) &&
+              pti_alloc(&batch->door_open, cap) &&
+              pti_alloc(&batch->vref_min_mv, cap) && pti_alloc(&batch->vref_max_mv, cap) &&
+              pti_alloc(&batch->temp_on_mc, cap) && pti_alloc(&batch->temp_off_mc, cap) &&
+              pti_alloc(&batch->ignition_ms, cap) && pti_alloc(&batch->cal_offset, cap) &&
+              pti_alloc(&batch->temperature_mc, cap) && pti_alloc(&batch->state, cap) &&
+              pti_alloc(&batch->flags, cap) && pti_alloc(&batch->ignition_attempt, cap) &&
+              pti_alloc(&batch->ignition_start_ms, cap);
+    if (!ok) {
+        ptx_batch_free(batch);
+        return false;
+    }
+
+    batch->count = count;
+    batch->capacity = cap;
+    for (uint32_t i = 0; i < cap; ++i) {
+        ptx_batch_set_config(batch, i, ptx_oven_get_config());
+        batch->temperature_mc[i] = PTX_TEMP_MIN_MC;
+        batch->state[i] = PTX_HEATING_STATE_IDLE;
+    }
+    return true;
+}
+
+void ptx_batch_free(ptx_batch_t* batch) {
+    free(batch->vref_mv);
+    free(batch->signal_mv);
+    free(batch->door_open);
+    free(batch->vref_min_mv);
+    free(batch->vref_max_mv);
+    free(batch->temp_on_mc);
+    free(batch->temp_off_mc);
+    free(batch->ignition_ms);
+    free(batch->cal_offset);
+    free(batch->temperature_mc);
+    free(batch->state);
+    free(batch->flags);
+    free(batch->ignition_attempt);
+    free(batch->ignition_start_ms);
+    memset(batch, 0, sizeof(*batch));
+}
+
+void ptx_batch_set_config(ptx_batch_t* batch, uint32_t oven, const ptx_oven_config_t* config) {
+    ptx_oven_thresholds_t th;
+    ptx_oven_config_thresholds(config, &th);
+
+    batch->vref_min_mv[oven] = th.vref_min_mv;
+    batch->vref_max_mv[oven] = th.vref_max_mv;
+    batch->temp_on_mc[oven]  = th.temp_on_mc;
+    batch->temp_off_mc[oven] = th.temp_off_mc;
+    batch->ignition_ms[oven] = config->ignition_duration_ms;
+    batch->cal_offset[oven]  = (int32_t)(ptx_cal_get_table(config->probe_profile)->temp_mc - pti_cal_base());
+}
+
+/*
+ * Scalar kernel: the controller's fault evaluation, temperature and
+ * ptx_update_heating() for one oven, on the batch arrays.
+ */
+static void pti_step_one(ptx_batch_t* b, uint32_t i, uint32_t now_ms) {
+    uint16_t vref_mv = b->vref_mv[i];
+    uint16_t signal_mv = b->signal_mv[i];
+    ptx_temp_recip_t recip;
+    ptx_temp_recip_reset(&recip);
+
+    bool vref_bad = ((int32_t)vref_mv < b->vref_min_mv[i]) || ((int32_t)vref_mv > b->vref_max_mv[i]);
+    bool signal_bad = !ptx_temp_signal_in_range(vref_mv, signal_mv);
+    int32_t temp_mc = ptx_temp_compute_mc(pti_cal_at(b->cal_offset[i]), &recip, vref_mv, signal_mv);
+
+    uint32_t flags = b->flags[i] & (PTX_BATCH_GAS | PTX_BATCH_IGNITER);
+    int32_t state = b->state[i];
+    uint32_t attempt = b->ignition_attempt[i];
+
+    if ((b->door_open[i] != 0U) || vref_bad || signal_bad) {
+        flags = 0;
+        state = PTX_HEATING_STATE_IDLE;     /* The attempt count outlives the fault */
+    } else {
+        switch (state) {
+            case PTX_HEATING_STATE_IDLE:
+                if (temp_mc <= b->temp_on_mc[i]) {
+                    attempt = (uint8_t)(attempt + 1U);
+                    flags = PTX_BATCH_GAS | PTX_BATCH_IGNITER;
+                    state = PTX_HEATING_STATE_IGNITING;
+                    b->ignition_start_ms[i] = now_ms;
+                }
+                break;
+            case PTX_HEATING_STATE_IGNITING:
+                if ((uint32_t)(now_ms - b->ignition_start_ms[i]) >= b->ignition_ms[i]) {
+                    flags &= ~PTX_BATCH_IGNITER;
+                    state = PTX_HEATING_STATE_HEATING;
+                    attempt = 0;
+                }
+                break;
+            case PTX_HEATING_STATE_HEATING:
+                if (temp_mc >= b->temp_off_mc[i]) {
+                    flags = 0;
+                    state = PTX_HEATING_STATE_IDLE;
+                    attempt = 0;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (vref_bad) flags |= PTX_BATCH_VREF_FAULT;
+    if (signal_bad) flags |= PTX_BATCH_SIGNAL_FAULT;
+
+    b->temperature_mc[i] = temp_mc;
+    b->state[i] = state;
+    b->flags[i] = flags;
+    b->ignition_attempt[i] = attempt;
+}
+
+void ptx_batch_step_scalar(ptx_batch_t* batch, uint32_t now_ms) {
+    for (uint32_t i = 0; i < batch->count; ++i) {
+        pti_step_one(batch, i, now_ms);
+    }
+}
+
+#if PTI_BATCH_AVX2
+/* a >= b, unsigned 32-bit lanes */
+__attribute__((target("avx2")))
+static inline __m256i pti_cmpge_epu32(__m256i a, __m256i b) {
+    return _mm256_cmpeq_epi32(_mm256_max_epu32(a, b), a);
+}
+
+/* floor(0xFFFFFFFF / v) for 4 lanes, as the uint32 bit pattern (exact: see ptx_temp_compute_mc) */
+__attribute__((target("avx2")))
+static inline __m128i pti_recip4(__m128i v) {
+    const __m256d two31 = _mm256_set1_pd(2147483648.0);
+    const __m256d two32 = _mm256_set1_pd(4294967296.0);
+
+    __m256d q = _mm256_floor_pd(_mm256_div_pd(_mm256_set1_pd(4294967295.0), _mm256_cvtepi32_pd(v)));
+    /* Quotients >= 2^31 do not fit a signed conversion: shift them down by 2^32 first */
+    q = _mm256_sub_pd(q, _mm256_and_pd(_mm256_cmp_pd(q, two31, _CMP_GE_OQ), two32));
+    return _mm256_cvttpd_epi32(q);
+}
+
+__attribute__((target("avx2")))
+static void pti_step_avx2(ptx_batch_t* b, uint32_t now_ms) {
+    const int* cal = (const int*)pti_cal_base();
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i now = _mm256_set1_epi32((int)now_ms);
+    const __m256i s_idle = _mm256_set1_epi32(PTX_HEATING_STATE_IDLE);
+    const __m256i s_igniting = _mm256_set1_epi32(PTX_HEATING_STATE_IGNITING);
+    const __m256i s_heating = _mm256_set1_epi32(PTX_HEATING_STATE_HEATING);
+    const __m256i f_gas = _mm256_set1_epi32(PTX_BATCH_GAS);
+    const __m256i f_ign = _mm256_set1_epi32(PTX_BATCH_IGNITER);
+    const __m256i f_vref = _mm256_set1_epi32(PTX_BATCH_VREF_FAULT);
+    const __m256i f_signal = _mm256_set1_epi32(PTX_BATCH_SIGNAL_FAULT);
+
+    for (uint32_t i = 0; i < b->count; i += PTX_BATCH_LANES) {
+        __m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(b->vref_mv + i)));
+        __m256i s = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(b->signal_mv + i)));
+        __m256i door = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(b->door_open + i)));
+        __m256i vmin = _mm256_loadu_si256((const __m256i*)(b->vref_min_mv + i));
+        __m256i vmax = _mm256_loadu_si256((const __m256i*)(b->vref_max_mv + i));
+        __m256i off = _mm256_loadu_si256((const __m256i*)(b->cal_offset + i));
+
+        /* Range faults (all products below 2^23: signed compares are exact) */
+        __m256i s100 = _mm256_mullo_epi32(s, _mm256_set1_epi32(100));
+        __m256i lo = _mm256_mullo_epi32(v, _mm256_set1_epi32(PTX_SIGNAL_MIN_PCT));
+        __m256i hi = _mm256_mullo_epi32(v, _mm256_set1_epi32(PTX_SIGNAL_MAX_PCT));
+        __m256i vref_bad = _mm256_or_si256(_mm256_cmpgt_epi32(vmin, v), _mm256_cmpgt_epi32(v, vmax));
+        __m256i signal_bad = _mm256_or_si256(_mm256_cmpgt_epi32(lo, s100), _mm256_cmpgt_epi32(s100, hi));
+        __m256i sat_lo = _mm256_andnot_si256(_mm256_cmpgt_epi32(s100, lo), _mm256_set1_epi32(-1));
+        __m256i sat_hi = _mm256_andnot_si256(_mm256_cmpgt_epi32(hi, s100), _mm256_set1_epi32(-1));
+
+        /* Temperature: Q32 ratio through the reciprocal, then table interpolation */
+        __m256i recip = _mm256_set_m128i(pti_recip4(_mm256_extracti128_si256(v, 1)),
+                                         pti_recip4(_mm256_castsi256_si128(v)));
+        __m256i ratio = _mm256_mullo_epi32(s, recip);
+        __m256i seg = _mm256_add_epi32(off, _mm256_srli_epi32(ratio, 32 - PTX_CAL_SEGMENT_BITS));
+        __m256i frac = _mm256_and_si256(_mm256_srli_epi32(ratio, 16 - PTX_CAL_SEGMENT_BITS),
+                                        _mm256_set1_epi32(0xFFFF));
+        __m256i t0 = _mm256_i32gather_epi32(cal, seg, 4);
+        __m256i t1 = _mm256_i32gather_epi32(cal, _mm256_add_epi32(seg, one), 4);
+        __m256i temp = _mm256_add_epi32(t0, _mm256_srai_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(t1, t0), frac), 16));
+
+        __m256i tmax = _mm256_i32gather_epi32(cal, _mm256_add_epi32(off, _mm256_set1_epi32(PTI_CAL_MAX_IDX)), 4);
+        __m256i tmin = _mm256_i32gather_epi32(cal, _mm256_add_epi32(off, _mm256_set1_epi32(PTI_CAL_MIN_IDX)), 4);
+        temp = _mm256_blendv_epi8(temp, tmax, sat_hi);
+        temp = _mm256_blendv_epi8(temp, tmin, sat_lo);
+
+        /* Heating state machine, as masks */
+        __m256i state = _mm256_loadu_si256((const __m256i*)(b->state + i));
+        __m256i flags = _mm256_loadu_si256((const __m256i*)(b->flags + i));
+        __m256i attempt = _mm256_loadu_si256((const __m256i*)(b->ignition_attempt + i));
+        __m256i start = _mm256_loadu_si256((const __m256i*)(b->ignition_start_ms + i));
+        __m256i ign_ms = _mm256_loadu_si256((const __m256i*)(b->ignition_ms + i));
+        __m256i on_mc = _mm256_loadu_si256((const __m256i*)(b->temp_on_mc + i));
+        __m256i off_mc = _mm256_loadu_si256((const __m256i*)(b->temp_off_mc + i));
+
+        __m256i fault = _mm256_or_si256(_mm256_or_si256(vref_bad, signal_bad),
+                                        _mm256_xor_si256(_mm256_cmpeq_epi32(door, zero), _mm256_set1_epi32(-1)));
+        __m256i ok = _mm256_xor_si256(fault, _mm256_set1_epi32(-1));
+
+        __m256i start_ign = _mm256_and_si256(ok, _mm256_and_si256(_mm256_cmpeq_epi32(state, s_idle),
+                                                                  _mm256_xor_si256(_mm256_cmpgt_epi32(temp, on_mc), _mm256_set1_epi32(-1))));
+        __m256i ign_done = _mm256_and_si256(ok, _mm256_and_si256(_mm256_cmpeq_epi32(state, s_igniting),
+                                                                 pti_cmpge_epu32(_mm256_sub_epi32(now, start), ign_ms)));
+        __m256i heat_off = _mm256_and_si256(ok, _mm256_and_si256(_mm256_cmpeq_epi32(state, s_heating),
+                                                                 _mm256_xor_si256(_mm256_cmpgt_epi32(off_mc, temp), _mm256_set1_epi32(-1))));
+        __m256i to_idle = _mm256_or_si256(fault, heat_off);
+
+        state = _mm256_blendv_epi8(state, s_idle, to_idle);
+        state = _mm256_blendv_epi8(state, s_igniting, start_ign);
+        state = _mm256_blendv_epi8(state, s_heating, ign_done);
+
+        flags = _mm256_and_si256(flags, _mm256_or_si256(f_gas, f_ign));
+        flags = _mm256_andnot_si256(to_idle, flags);
+        flags = _mm256_andnot_si256(_mm256_and_si256(ign_done, f_ign), flags);
+        flags = _mm256_or_si256(flags, _mm256_and_si256(start_ign, _mm256_or_si256(f_gas, f_ign)));
+        flags = _mm256_or_si256(flags, _mm256_and_si256(vref_bad, f_vref));
+        flags = _mm256_or_si256(flags, _mm256_and_si256(signal_bad, f_signal));
+
+        attempt = _mm256_andnot_si256(_mm256_or_si256(heat_off, ign_done), attempt);
+        attempt = _mm256_blendv_epi8(attempt,
+                                     _mm256_and_si256(_mm256_add_epi32(attempt, one), _mm256_set1_epi32(0xFF)),
+                                     start_ign);
+        start = _mm256_blendv_epi8(start, now, start_ign);
+
+        _mm256_storeu_si256((__m256i*)(b->temperature_mc + i), temp);
+        _mm256_storeu_si256((__m256i*)(b->state + i), state);
+        _mm256_storeu_si256((__m256i*)(b->flags + i), flags);
+        _mm256_storeu_si256((__m256i*)(b->ignition_attempt + i), attempt);
+        _mm256_storeu_si256((__m256i*)(b->ignition_start_ms + i), start);
+    }
+}
+#endif
+
+bool ptx_batch_has_simd(void) {
+#if PTI_BATCH_AVX2
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+#else
+    return false;
+#endif
+}
+
+bool ptx_batch_step_simd(ptx_batch_t* batch, uint32_t now_ms) {
+#if PTI_BATCH_AVX2
+    if (ptx_batch_has_simd()) {
+        pti_step_avx2(batch, now_ms);
+        return true;
+    }
+#endif
+    (void)batch;
+    (void)now_ms;
+    return false;
+}
+
+void ptx_batch_step(ptx_batch_t* batch, uint32_t now_ms) {
+    if (!ptx_batch_step_simd(batch, now_ms)) {
+        ptx_batch_step_scalar(batch, now_ms);
+    }
+}
@@ -0,0 +1,112 @@
+/**
+ * @file ptx_batch.h
+ * @brief Batched structure-of-arrays control step for many ovens (gateway only)
+ * @details One call evaluates temperature, range faults and the heating state
+ *          machine of every oven in the batch. Each field is a separate array
+ *          indexed by oven, padded to a multiple of PTX_BATCH_LANES, so the
+ *          step runs PTX_BATCH_LANES ovens per instruction. The AVX2 kernel is
+ *          selected at run time when the CPU supports it; otherwise a scalar
+ *          loop runs the same step.
+ *
+ *          Inputs are the filtered readings, i.e. what ptx_sensor_filter
+ *          returns. Per oven the step produces exactly what the integer
+ *          (PTX_FIXED_POINT) controller produces for the same readings, with
+ *          PTX_FLAME_DETECT_ENABLED=0 (ignition assumed to succeed): the
+ *          scalar kernel calls the same temperature and range functions, the
+ *          AVX2 kernel is integer arithmetic bit-identical to them.
+ *
+ *          Not for the board: this lives outside the sketch directory and
+ *          needs a hosted C++ runtime.
+ */
+#ifndef PTX_BATCH_H
+#define PTX_BATCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ptx_oven_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PTX_BATCH_LANES         8U          // Ovens per SIMD step; arrays are padded to this
+
+/* Per-oven flags */
+#define PTX_BATCH_GAS           0x01U       // Gas valve command
+#define PTX_BATCH_IGNITER       0x02U       // Igniter command
+#define PTX_BATCH_VREF_FAULT    0x04U       // vref outside [vref_min, vref_max]
+#define PTX_BATCH_SIGNAL_FAULT  0x08U       // signal outside [10%, 90%] of vref
+
+/**
+ * @brief Batch of ovens in structure-of-arrays layout
+ * @note All arrays hold capacity entries; entries past count are padding.
+ */
+typedef struct {
+    uint32_t  count;                // Ovens in the batch
+    uint32_t  capacity;             // count rounded up to PTX_BATCH_LANES
+
+    /* Inputs, written by the caller before each step */
+    uint16_t* vref_mv;              // Filtered reference voltage (mV)
+    uint16_t* signal_mv;            // Filtered signal voltage (mV)
+    uint8_t*  door_open;            // Non-zero: door open
+
+    /* Configuration, written by ptx_batch_set_config() */
+    int32_t*  vref_min_mv;
+    int32_t*  vref_max_mv;
+    int32_t*  temp_on_mc;
+    int32_t*  temp_off_mc;
+    uint32_t* ignition_ms;
+    int32_t*  cal_offset;           // Calibration table of the probe, in int32 from table 0
+
+    /* State and outputs */
+    int32_t*  temperature_mc;       // Computed temperature (m°C)
+    int32_t*  state;                // ptx_heating_state_t
+    uint32_t* flags;                // PTX_BATCH_* flags
+    uint32_t* ignition_attempt;
+    uint32_t* ignition_start_ms;
+} ptx_batch_t;
+
+/**
+ * @brief Allocate a batch; every oven starts idle with the process-wide configuration
+ * @return false if memory could not be allocated (batch left empty)
+ */
+bool ptx_batch_init(ptx_batch_t* batch, uint32_t count);
+
+/**
+ * @brief Release the arrays of a batch
+ */
+void ptx_batch_free(ptx_batch_t* batch);
+
+/**
+ * @brief Set the configuration of one oven
+ * @note Derived with ptx_oven_config_thresholds(), like the controller.
+ */
+void ptx_batch_set_config(ptx_batch_t* batch, uint32_t oven, const ptx_oven_config_t* config);
+
+/**
+ * @brief Run one control step for every oven, using the fastest kernel available
+ * @param now_ms Current time (ms)
+ */
+void ptx_batch_step(ptx_batch_t* batch, uint32_t now_ms);
+
+/**
+ * @brief Scalar kernel (reference)
+ */
+void ptx_batch_step_scalar(ptx_batch_t* batch, uint32_t now_ms);
+
+/**
+ * @brief SIMD kernel
+ * @return false (and nothing done) if this CPU or build has no SIMD kernel
+ */
+bool ptx_batch_step_simd(ptx_batch_t* batch, uint32_t now_ms);
+
+/**
+ * @brief True if ptx_batch_step() uses the SIMD kernel
+ */
+bool ptx_batch_has_simd(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_BATCH_H */
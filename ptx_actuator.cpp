@@ -1,37 +1,131 @@
 /**
  * @file ptx_actuator.cpp
  * @brief Implementation of actuator control layer
+ * @details The commanded state of each output is cached and the hardware is
+ *          written only when it changes. Each write is read back; a mismatch
+ *          is counted and drops the cached state so the next command writes
+ *          again. Without an injected I/O table, pins are bound at compile
+ *          time through ptx_io.h, so on AVR each write and read-back is a
+ *          single port instruction.
  */
 #include "ptx_actuator.h"
-#include "api.h"
+#include "ptx_critical.h"
+#include "ptx_io.h"
+#include "ptx_oven_control.h"
+#include <stddef.h>
 
-void ptx_actuator_init(void) {
+#if PTX_IO_DIRECT
+// The pin input synchronizer needs one cycle before PINx shows a PORTx write
+static inline void pti_settle(void) {
+    __asm__ __volatile__("nop");
+}
+#else
+static inline void pti_settle(void) {
+}
+#endif
+
+// Write an output through the injected table or the board binding, return the readback
+template <output_t O>
+static inline bool pti_write_read(const ptx_io_table_t* io, bool on) {
+    if (io != NULL) {
+        io->write(io->user, O, on);
+        return io->read(io->user, O);
+    }
+    ptx_io_write<O>(on);
+    pti_settle();
+    return ptx_io_read<O>();
+}
+
+// Write an output, verify it, and remember it
+template <output_t O>
+static void pti_drive(ptx_actuator_t* act, volatile ptx_actuator_output_t* cache,
+                      const ptx_io_table_t* io, bool on) {
+    if (pti_write_read<O>(io, on) == on) {
+        cache->on = on;
+        cache->valid = true;
+    } else {
+        cache->valid = false;
+        act->readback_faults = (uint16_t)(act->readback_faults + 1U);
+    }
+}
+
+// Drive only if the command differs from the cached state
+template <output_t O>
+static void pti_command(ptx_actuator_t* act, volatile ptx_actuator_output_t* cache,
+                        const ptx_io_table_t* io, bool on) {
+    ptx_irq_state_t irq = ptx_irq_save();
+    if (!cache->valid || (cache->on != on)) {
+        pti_drive<O>(act, cache, io, on);
+    }
+    ptx_irq_restore(irq);
+}
+
+void ptx_actuator_init_ctx(ptx_actuator_t* act, const ptx_io_table_t* io) {
     /* Start with all actuators OFF for safety */
-    set_output(GAS_VALVE, 0);
-    set_output(IGNITER, 0);
+    ptx_irq_state_t irq = ptx_irq_save();
+    act->readback_faults = 0;
+    pti_drive<GAS_VALVE>(act, &act->gas, io, false);
+    pti_drive<IGNITER>(act, &act->igniter, io, false);
+    act->led.valid = false;
+    ptx_irq_restore(irq);
+}
+
+void ptx_actuator_set_gas_ctx(ptx_actuator_t* act, const ptx_io_table_t* io, bool enable) {
+    pti_command<GAS_VALVE>(act, &act->gas, io, enable);
+}
+
+void ptx_actuator_set_igniter_ctx(ptx_actuator_t* act, const ptx_io_table_t* io, bool enable) {
+    pti_command<IGNITER>(act, &act->igniter, io, enable);
+}
+
+void ptx_actuator_set_system_led_status_ctx(ptx_actuator_t* act, const ptx_io_table_t* io, bool enable) {
+    pti_command<SYS_LED_STATUS>(act, &act->led, io, enable);
+}
+
+void ptx_actuator_emergency_stop_ctx(ptx_actuator_t* act, const ptx_io_table_t* io) {
+    /* Never trust the cache here: always drive both outputs */
+    ptx_irq_state_t irq = ptx_irq_save();
+    pti_drive<GAS_VALVE>(act, &act->gas, io, false);
+    pti_drive<IGNITER>(act, &act->igniter, io, false);
+    ptx_irq_restore(irq);
+}
+
+uint16_t ptx_actuator_get_readback_faults_ctx(const ptx_actuator_t* act) {
+    ptx_irq_state_t irq = ptx_irq_save();
+    uint16_t faults = act->readback_faults;
+    ptx_irq_restore(irq);
+    return faults;
+}
+
+/* Single-oven API: the oven instance's actuator, so its cache stays the controller's */
+void ptx_actuator_init(void) {
+    ptx_actuator_init_ctx(ptx_oven_get_actuator(), NULL);
 }
 
 void ptx_actuator_set_gas(bool enable) {
-    set_output(GAS_VALVE, enable ? 1 : 0);
+    ptx_actuator_set_gas_ctx(ptx_oven_get_actuator(), NULL, enable);
 }
 
 void ptx_actuator_set_igniter(bool enable) {
-    set_output(IGNITER, enable ? 1 : 0);
+    ptx_actuator_set_igniter_ctx(ptx_oven_get_actuator(), NULL, enable);
 }
 
 void ptx_actuator_set_system_led_status(bool enable) {
-    set_output(SYS_LED_STATUS, enable ? 1 : 0);
+    ptx_actuator_set_system_led_status_ctx(ptx_oven_get_actuator(), NULL, enable);
 }
 
 void ptx_actuator_emergency_stop(void) {
-    set_output(GAS_VALVE, 0);
-    set_output(IGNITER, 0);
+    ptx_actuator_emergency_stop_ctx(ptx_oven_get_actuator(), NULL);
 }
 
 bool ptx_actuator_get_gas_state(void) {
-    return read_output(GAS_VALVE);
+    return ptx_io_read<GAS_VALVE>();
 }
 
 bool ptx_actuator_get_igniter_state(void) {
-    return read_output(IGNITER);
+    return ptx_io_read<IGNITER>();
+}
+
+uint16_t ptx_actuator_get_readback_faults(void) {
+    return ptx_actuator_get_readback_faults_ctx(ptx_oven_get_actuator());
 }
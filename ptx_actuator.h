@@ -1,17 +1,39 @@
 /**
  * @file ptx_actuator.h
  * @brief Actuator control abstraction layer (gas valve, igniter)
- * @details Provides clean interface between application logic and hardware API
+ * @details Provides clean interface between application logic and hardware API.
+ *          Setters only touch the hardware when the commanded state changes.
  */
 #ifndef PTX_ACTUATOR_H
 #define PTX_ACTUATOR_H
 
+#include <stdint.h>
 #include <stdbool.h>
+#include "ptx_io.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief Cached commanded state of one output
+ */
+typedef struct {
+    bool valid;                 // false: state unknown, next command writes
+    bool on;                    // Last command that read back correctly
+} ptx_actuator_output_t;
+
+/**
+ * @brief Actuator state of one oven instance
+ * @note Written from the main loop and the door interrupt
+ */
+typedef struct {
+    volatile ptx_actuator_output_t gas;
+    volatile ptx_actuator_output_t igniter;
+    volatile ptx_actuator_output_t led;
+    volatile uint16_t readback_faults;  // Writes whose readback did not match
+} ptx_actuator_t;
+
 /**
  * @brief Initialize actuator outputs
  * @note Ensures all actuators start in safe state (OFF)
@@ -54,6 +76,25 @@ void ptx_actuator_emergency_stop(void);
  */
 void ptx_actuator_set_system_led_status(bool enable);
 
+/**
+ * @brief Number of writes whose readback did not match the command
+ * @note A mismatch makes the next command for that output write again
+ */
+uint16_t ptx_actuator_get_readback_faults(void);
+
+/*
+ * Per-instance variants. io selects the hardware: NULL drives this board
+ * through the compile-time bindings, otherwise the injected table is used.
+ * The functions above operate on the single-oven instance's actuator
+ * (ptx_oven_get_actuator()) with io = NULL.
+ */
+void ptx_actuator_init_ctx(ptx_actuator_t* act, const ptx_io_table_t* io);
+void ptx_actuator_set_gas_ctx(ptx_actuator_t* act, const ptx_io_table_t* io, bool enable);
+void ptx_actuator_set_igniter_ctx(ptx_actuator_t* act, const ptx_io_table_t* io, bool enable);
+void ptx_actuator_set_system_led_status_ctx(ptx_actuator_t* act, const ptx_io_table_t* io, bool enable);
+void ptx_actuator_emergency_stop_ctx(ptx_actuator_t* act, const ptx_io_table_t* io);
+uint16_t ptx_actuator_get_readback_faults_ctx(const ptx_actuator_t* act);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,179 @@
+/**
+ * @file ptx_adc_sampler.cpp
+ * @brief Implementation of the interrupt-driven ADC sampler
+ */
+#include "ptx_adc_sampler.h"
+#include "ptx_critical.h"
+#include "ptx_io.h"
+#include "ptx_sensor_filter.h"
+
+#if (PTX_ADC_RING_SIZE & (PTX_ADC_RING_SIZE - 1U)) != 0U || PTX_ADC_RING_SIZE > 128U
+#error "PTX_ADC_RING_SIZE must be a power of two no larger than 128"
+#endif
+
+#if PTX_ADC_SAMPLER_ENABLED && defined(__AVR__) && !PTX_IO_DIRECT
+#error "PTX_ADC_SAMPLER_ENABLED drives the ATmega328P registers directly"
+#endif
+
+#define PTI_ADC_MASK (PTX_ADC_RING_SIZE - 1U)
+
+/* Ordering of the slot contents against the index that publishes them */
+#define PTI_LOAD_ACQUIRE(p)         __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define PTI_LOAD_RELAXED(p)         __atomic_load_n((p), __ATOMIC_RELAXED)
+#define PTI_STORE_RELEASE(p, v)     __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+typedef struct {
+    uint16_t vref;              // Raw counts, A1
+    uint16_t signal;            // Raw counts, A0
+} pti_adc_pair_t;
+
+/* Free-running indices; head is written by the interrupt only, tail by the main loop only */
+static pti_adc_pair_t pti_adc_ring[PTX_ADC_RING_SIZE];
+static uint8_t pti_adc_head = 0;
+static uint8_t pti_adc_tail = 0;
+static uint16_t pti_adc_dropped = 0;    /* Interrupt only */
+
+/* Interrupt only: input being converted, and the vref half of the pair */
+static bool pti_adc_on_signal = false;
+static uint16_t pti_adc_vref = 0;
+
+/* Main loop only: decimation, and the last reading, repeated when nothing new was converted */
+static ptx_decimator_t pti_adc_decimator;
+static uint16_t pti_adc_vref_mv_q = 0;
+static uint16_t pti_adc_signal_mv_q = 0;
+
+void ptx_adc_sampler_reset(void) {
+    PTI_STORE_RELEASE(&pti_adc_head, 0);
+    PTI_STORE_RELEASE(&pti_adc_tail, 0);
+    PTI_STORE_RELEASE(&pti_adc_dropped, 0);
+    pti_adc_on_signal = false;
+    pti_adc_vref = 0;
+    ptx_decimator_init(&pti_adc_decimator, PTX_OVERSAMPLE_BITS);
+    pti_adc_vref_mv_q = 0;
+    pti_adc_signal_mv_q = 0;
+}
+
+bool ptx_adc_sampler_on_conversion(uint16_t raw) {
+    if (!pti_adc_on_signal) {
+        pti_adc_vref = raw;
+        pti_adc_on_signal = true;
+        return true;
+    }
+    pti_adc_on_signal = false;
+
+    uint8_t head = PTI_LOAD_RELAXED(&pti_adc_head);
+    uint8_t tail = PTI_LOAD_ACQUIRE(&pti_adc_tail);
+    if ((uint8_t)(head - tail) >= PTX_ADC_RING_SIZE) {
+        PTI_STORE_RELEASE(&pti_adc_dropped, (uint16_t)(PTI_LOAD_RELAXED(&pti_adc_dropped) + 1U));
+        return false;
+    }
+
+    pti_adc_pair_t* slot = &pti_adc_ring[head & PTI_ADC_MASK];
+    slot->vref = pti_adc_vref;
+    slot->signal = raw;
+    PTI_STORE_RELEASE(&pti_adc_head, (uint8_t)(head + 1U));
+    return false;
+}
+
+void ptx_adc_sampler_read_mv_q(uint16_t* vref_mv_q, uint16_t* signal_mv_q) {
+    uint8_t tail = PTI_LOAD_RELAXED(&pti_adc_tail);
+    uint8_t head = PTI_LOAD_ACQUIRE(&pti_adc_head);
+    uint32_t vref_sum = 0;
+    uint32_t signal_sum = 0;
+    uint16_t outputs = 0;
+
+    /* Decimate every queued pair; a partial group carries over to the next call */
+    for (; tail != head; ++tail) {
+        const pti_adc_pair_t* slot = &pti_adc_ring[tail & PTI_ADC_MASK];
+        uint16_t vref_q;
+        uint16_t signal_q;
+        if (ptx_decimator_push(&pti_adc_decimator, slot->vref, slot->signal, &vref_q, &signal_q)) {
+            vref_sum += vref_q;
+            signal_sum += signal_q;
+            outputs++;
+        }
+    }
+    PTI_STORE_RELEASE(&pti_adc_tail, tail);
+
+    if (outputs > 0U) {
+        /* Rounded mean output, through the same scaling as an on-demand read */
+        uint16_t half = (uint16_t)(outputs / 2U);
+        pti_adc_vref_mv_q = ptx_input_traits<TEMPERATURE_SENSOR_REFERENCE>::to_mv_q(
+            (uint16_t)((vref_sum + half) / outputs), PTX_OVERSAMPLE_BITS);
+        pti_adc_signal_mv_q = ptx_input_traits<TEMPERATURE_SENSOR>::to_mv_q(
+            (uint16_t)((signal_sum + half) / outputs), PTX_OVERSAMPLE_BITS);
+    }
+    *vref_mv_q = pti_adc_vref_mv_q;
+    *signal_mv_q = pti_adc_signal_mv_q;
+}
+
+void ptx_adc_sampler_last_mv_q(uint16_t* vref_mv_q, uint16_t* signal_mv_q) {
+    *vref_mv_q = pti_adc_vref_mv_q;
+    *signal_mv_q = pti_adc_signal_mv_q;
+}
+
+uint16_t ptx_adc_sampler_dropped(void) {
+    /* Two-byte read on AVR: keep the producer out for its duration */
+    ptx_irq_state_t irq = ptx_irq_save();
+    uint16_t dropped = PTI_LOAD_RELAXED(&pti_adc_dropped);
+    ptx_irq_restore(irq);
+    return dropped;
+}
+
+#if PTX_IO_DIRECT && PTX_ADC_SAMPLER_ENABLED
+
+#define PTI_ADC_PRESCALE    ((1U << ADPS2) | (1U << ADPS1) | (1U << ADPS0))    // clk/128
+
+static inline uint8_t pti_adc_admux(bool signal) {
+    /* AVcc reference, right-adjusted, as ptx_io_read_mv() */
+    return (uint8_t)((1U << REFS0) | (signal ? ptx_input_traits<TEMPERATURE_SENSOR>::channel
+                                             : ptx_input_traits<TEMPERATURE_SENSOR_REFERENCE>::channel));
+}
+
+ISR(ADC_vect) {
+    uint16_t raw = ADC;
+    TIFR1 = (uint8_t)(1U << OCF1B);     /* The trigger is the flag's rising edge: re-arm it */
+    ADMUX = pti_adc_admux(ptx_adc_sampler_on_conversion(raw));
+}
+
+void ptx_adc_sampler_start(uint16_t rate_hz) {
+    if (rate_hz < PTX_ADC_SAMPLE_HZ_MIN) rate_hz = PTX_ADC_SAMPLE_HZ_MIN;
+    if (rate_hz > PTX_ADC_SAMPLE_HZ_MAX) rate_hz = PTX_ADC_SAMPLE_HZ_MAX;
+
+    ptx_adc_sampler_stop();
+    ptx_adc_sampler_reset();
+
+    /* Timer1 in CTC mode at clk/8; compare B at TOP starts each conversion */
+    TCCR1A = 0;
+    TCCR1B = 0;
+    TCNT1 = 0;
+    OCR1A = (uint16_t)((F_CPU / 8UL) / rate_hz - 1UL);
+    OCR1B = OCR1A;
+    TIFR1 = (uint8_t)(1U << OCF1B);
+
+    ADMUX = pti_adc_admux(false);
+    ADCSRB = (uint8_t)((1U << ADTS2) | (1U << ADTS0));     // Timer1 compare match B
+    ADCSRA = (uint8_t)((1U << ADEN) | (1U << ADATE) | (1U << ADIE) | (1U << ADIF) | PTI_ADC_PRESCALE);
+    TCCR1B = (uint8_t)((1U << WGM12) | (1U << CS11));
+
+    /* The first pair, so the first reading is real */
+    while (PTI_LOAD_ACQUIRE(&pti_adc_head) == 0U) { }
+}
+
+void ptx_adc_sampler_stop(void) {
+    TCCR1B = 0;
+    ADCSRA = (uint8_t)((1U << ADEN) | (1U << ADIF) | PTI_ADC_PRESCALE);
+    ADCSRB = 0;
+}
+
+#else
+
+void ptx_adc_sampler_start(uint16_t rate_hz) {
+    (void)rate_hz;
+    ptx_adc_sampler_reset();
+}
+
+void ptx_adc_sampler_stop(void) {
+}
+
+#endif /* PTX_IO_DIRECT && PTX_ADC_SAMPLER_ENABLED */
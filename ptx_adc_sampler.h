@@ -0,0 +1,118 @@
+/**
+ * @file ptx_adc_sampler.h
+ * @brief Timer-triggered, interrupt-driven ADC sampler of the probe inputs
+ * @details Timer1 compare match B starts a conversion PTX_ADC_SAMPLE_HZ times
+ *          a second. The ADC interrupt stores the result and switches the
+ *          multiplexer to the other input, so A1 (vref) and A0 (signal)
+ *          alternate and a vref/signal pair completes every two conversions.
+ *          Pairs of raw counts go into a lock-free single-producer/
+ *          single-consumer ring, with the same scheme as ptx_event_queue: the
+ *          interrupt owns head, the main loop owns tail, both single bytes.
+ *          When the ring is full the new pair is dropped and counted.
+ *
+ *          The control loop takes every pair queued since its previous call
+ *          in one go, decimates and averages them: it never waits for a
+ *          conversion, and the probe is oversampled at no cost to it. Size
+ *          the ring for one control period: PTX_ADC_SAMPLE_HZ / 2 pairs per
+ *          second.
+ *
+ *          Only the ATmega328P binding (direct register I/O) drives the
+ *          hardware. The ring and the interrupt body are plain code, so the
+ *          host tests feed conversions through ptx_adc_sampler_on_conversion().
+ */
+#ifndef PTX_ADC_SAMPLER_H
+#define PTX_ADC_SAMPLER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Read the probe through the sampler instead of blocking conversions
+ * @note Defaults to 1 on the ATmega328P, 0 elsewhere. Takes Timer1 and the ADC
+ *       interrupt; analogRead() must not be used while it runs.
+ */
+#ifndef PTX_ADC_SAMPLER_ENABLED
+#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__)
+#define PTX_ADC_SAMPLER_ENABLED 1
+#else
+#define PTX_ADC_SAMPLER_ENABLED 0
+#endif
+#endif
+
+/**
+ * @brief Conversions per second, both inputs together
+ */
+#ifndef PTX_ADC_SAMPLE_HZ
+#define PTX_ADC_SAMPLE_HZ 1000U
+#endif
+
+/**
+ * @brief Ring capacity in vref/signal pairs (power of two, at most 128)
+ * @note 64 pairs hold 128 ms at 1 kHz: one 100 ms control period with margin.
+ */
+#ifndef PTX_ADC_RING_SIZE
+#define PTX_ADC_RING_SIZE 64U
+#endif
+
+#define PTX_ADC_SAMPLE_HZ_MIN   50U     // Slowest rate Timer1 reaches at clk/8
+#define PTX_ADC_SAMPLE_HZ_MAX   8000U   // A conversion takes ~104 us at clk/128
+
+/**
+ * @brief Empty the ring, clear the drop counter and restart at vref
+ * @note Not safe while the sampler runs
+ */
+void ptx_adc_sampler_reset(void);
+
+/**
+ * @brief Reset, then start the timer-triggered conversions
+ * @param rate_hz Conversions per second, clamped to
+ *        [PTX_ADC_SAMPLE_HZ_MIN, PTX_ADC_SAMPLE_HZ_MAX]
+ * @note On the board, returns once the first pair is in (two conversions).
+ *       Elsewhere only resets.
+ */
+void ptx_adc_sampler_start(uint16_t rate_hz);
+
+/**
+ * @brief Stop the conversions and give the ADC back to on-demand reads
+ */
+void ptx_adc_sampler_stop(void);
+
+/**
+ * @brief Interrupt body: store one conversion of the input selected before it
+ * @param raw 10-bit result
+ * @return true if the next conversion is the signal (A0), false for vref (A1)
+ * @note Called from the ADC interrupt on the board, directly by host tests.
+ */
+bool ptx_adc_sampler_on_conversion(uint16_t raw);
+
+/**
+ * @brief Reading from the pairs queued since the previous call
+ * @details The pairs go through a 4^n decimator (ptx_decimator_t, n =
+ *          PTX_OVERSAMPLE_BITS); the outputs completed in this call are
+ *          averaged and scaled to millivolts with n fractional bits.
+ * @note Repeats the previous reading if no output completed, and reports 0 on
+ *       both inputs before the first one.
+ */
+void ptx_adc_sampler_read_mv_q(uint16_t* vref_mv_q, uint16_t* signal_mv_q);
+
+/**
+ * @brief The reading last returned by ptx_adc_sampler_read_mv_q()
+ * @note Leaves the queued pairs to the next ptx_adc_sampler_read_mv_q().
+ */
+void ptx_adc_sampler_last_mv_q(uint16_t* vref_mv_q, uint16_t* signal_mv_q);
+
+/**
+ * @brief Number of pairs dropped because the ring was full
+ * @note Wraps at 65535; the controller's periodic log reports its growth.
+ */
+uint16_t ptx_adc_sampler_dropped(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_ADC_SAMPLER_H */
@@ -0,0 +1,138 @@
+/**
+ * @file ptx_calibration.cpp
+ * @brief Calibration profiles and compile-time table generation
+ * @note The generator only uses C++11 constexpr (single-return functions,
+ *       recursion instead of loops) so it also builds with the stock Arduino
+ *       AVR toolchain (-std=gnu++11).
+ */
+#include "ptx_calibration.h"
+#include "ptx_temperature.h"
+#include "ptx_progmem.h"
+
+namespace {
+
+/* One measured calibration point */
+struct pti_cal_point_t {
+    double ratio;       // signal / vref
+    double temp_c;      // reference temperature (°C)
+};
+
+/*
+ * Calibration profiles.
+ * Points must be sorted by ratio; the curve is piecewise linear between them
+ * and the end segments are extended. Adding a probe means adding a point list
+ * here and a matching ptx_cal_profile_t entry.
+ */
+constexpr pti_cal_point_t pti_nominal_points[] = {
+    { 0.10, -10.0 },
+    { 0.90, 300.0 },
+};
+
+constexpr pti_cal_point_t pti_bench_5pt_points[] = {
+    { 0.10, -10.0 },
+    { 0.30,  68.0 },
+    { 0.50, 145.6 },
+    { 0.70, 222.1 },
+    { 0.90, 297.0 },
+};
+
+/* Compile-time index sequence 0..N-1 (no <utility> on AVR) */
+template <int... I> struct pti_index_seq {};
+template <int N, int... I> struct pti_make_index_seq : pti_make_index_seq<N - 1, N - 1, I...> {};
+template <int... I> struct pti_make_index_seq<0, I...> { typedef pti_index_seq<I...> type; };
+
+constexpr double pti_lerp(const pti_cal_point_t& a, const pti_cal_point_t& b, double r) {
+    return a.temp_c + (b.temp_c - a.temp_c) * (r - a.ratio) / (b.ratio - a.ratio);
+}
+
+// Evaluate the piecewise-linear curve at ratio r, searching from segment k
+constexpr double pti_eval(const pti_cal_point_t* p, int n, double r, int k = 1) {
+    return ((k >= n - 1) || (r <= p[k].ratio)) ? pti_lerp(p[k - 1], p[k], r)
+                                                : pti_eval(p, n, r, k + 1);
+}
+
+constexpr int32_t pti_to_mc(double c) {
+    return (int32_t)(c * 1000.0 + ((c < 0.0) ? -0.5 : 0.5));
+}
+
+template <int N, int... I>
+constexpr ptx_cal_table_t pti_build(const pti_cal_point_t (&p)[N], pti_index_seq<I...>) {
+    return ptx_cal_table_t{
+        { pti_to_mc(pti_eval(p, N, (double)I / PTX_CAL_SEGMENTS))... },
+        pti_to_mc(pti_eval(p, N, PTX_SIGNAL_MIN_PCT / 100.0)),
+        pti_to_mc(pti_eval(p, N, PTX_SIGNAL_MAX_PCT / 100.0)),
+    };
+}
+
+template <int N>
+constexpr ptx_cal_table_t pti_build_table(const pti_cal_point_t (&p)[N]) {
+    static_assert(N >= 2, "a calibration profile needs at least two points");
+    return pti_build(p, typename pti_make_index_seq<PTX_CAL_TABLE_SIZE>::type());
+}
+
+} // namespace
+
+/* Generated tables, one per ptx_cal_profile_t, in flash */
+static constexpr ptx_cal_table_t pti_cal_tables[PTX_CAL_PROFILE_COUNT] PTX_PROGMEM = {
+    pti_build_table(pti_nominal_points),
+    pti_build_table(pti_bench_5pt_points),
+};
+
+const ptx_cal_table_t* ptx_cal_get_table(uint8_t profile) {
+    if (profile >= PTX_CAL_PROFILE_COUNT) {
+        profile = PTX_CAL_PROFILE_NOMINAL;
+    }
+    return &pti_cal_tables[profile];
+}
+
+int32_t ptx_cal_lookup_mc(const ptx_cal_table_t* table, uint32_t ratio_q32) {
+    /* Top bits select the segment, the next 16 bits are the position inside it */
+    uint8_t i = (uint8_t)(ratio_q32 >> (32U - PTX_CAL_SEGMENT_BITS));
+    int32_t frac = (int32_t)((ratio_q32 >> (16U - PTX_CAL_SEGMENT_BITS)) & 0xFFFFUL);
+
+    int32_t t0 = ptx_pgm_read_i32(&table->temp_mc[i]);
+    int32_t t1 = ptx_pgm_read_i32(&table->temp_mc[i + 1U]);
+
+    /* Segment span is well below 32 °C, so the product fits in 32 bits */
+    return t0 + (((t1 - t0) * frac) >> 16);
+}
+
+uint32_t ptx_cal_ratio_above_q32(const ptx_cal_table_t* table, int32_t temp_mc) {
+    uint32_t lo = 0;
+    uint32_t hi = 0xFFFFFFFFUL;
+
+    if (ptx_cal_lookup_mc(table, lo) > temp_mc) return lo;
+    if (ptx_cal_lookup_mc(table, hi) <= temp_mc) return hi;
+
+    /* lookup(lo) <= temp_mc < lookup(hi) */
+    while ((hi - lo) > 1U) {
+        uint32_t mid = lo + ((hi - lo) >> 1);
+        if (ptx_cal_lookup_mc(table, mid) > temp_mc) {
+            hi = mid;
+        } else {
+            lo = mid;
+        }
+    }
+    return hi;
+}
+
+float ptx_cal_lookup_c(const ptx_cal_table_t* table, float ratio) {
+    float pos = ratio * (float)PTX_CAL_SEGMENTS;
+    if (pos < 0.0f) pos = 0.0f;
+
+    uint8_t i = (pos < (float)PTX_CAL_SEGMENTS) ? (uint8_t)pos : (uint8_t)(PTX_CAL_SEGMENTS - 1U);
+    float frac = pos - (float)i;
+
+    int32_t t0 = ptx_pgm_read_i32(&table->temp_mc[i]);
+    int32_t t1 = ptx_pgm_read_i32(&table->temp_mc[i + 1U]);
+
+    return ((float)t0 + (float)(t1 - t0) * frac) / 1000.0f;
+}
+
+int32_t ptx_cal_temp_min_mc(const ptx_cal_table_t* table) {
+    return ptx_pgm_read_i32(&table->temp_min_mc);
+}
+
+int32_t ptx_cal_temp_max_mc(const ptx_cal_table_t* table) {
+    return ptx_pgm_read_i32(&table->temp_max_mc);
+}
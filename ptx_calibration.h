@@ -0,0 +1,95 @@
+/**
+ * @file ptx_calibration.h
+ * @brief Probe calibration profiles: signal/vref ratio to temperature
+ * @details Each profile is a short list of measured (ratio, temperature) points.
+ *          At compile time the points are expanded into a uniform table over
+ *          the ratio [0, 1) that lives in flash. A lookup indexes the table
+ *          directly from the top bits of the ratio and interpolates linearly
+ *          between neighbouring entries, so the cost is O(1) and identical for
+ *          every reading.
+ *
+ *          The profile in use is a runtime configuration value
+ *          (ptx_oven_set_probe_profile()), so swapping probes is a
+ *          configuration change, not a code change.
+ */
+#ifndef PTX_CALIBRATION_H
+#define PTX_CALIBRATION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PTX_CAL_SEGMENT_BITS    6U                              // log2 of table segments
+#define PTX_CAL_SEGMENTS        (1U << PTX_CAL_SEGMENT_BITS)    // 64 segments over ratio [0, 1)
+#define PTX_CAL_TABLE_SIZE      (PTX_CAL_SEGMENTS + 1U)         // entries, both ends included
+
+/**
+ * @brief Available probe profiles
+ */
+typedef enum {
+    PTX_CAL_PROFILE_NOMINAL = 0,    // Datasheet curve: -10 °C at 10% vref, 300 °C at 90% vref
+    PTX_CAL_PROFILE_BENCH_5PT,      // 5-point bench calibration, slightly compressed at the hot end
+    PTX_CAL_PROFILE_COUNT
+} ptx_cal_profile_t;
+
+#ifndef PTX_CAL_DEFAULT_PROFILE
+#define PTX_CAL_DEFAULT_PROFILE PTX_CAL_PROFILE_NOMINAL
+#endif
+
+/**
+ * @brief Compile-time generated calibration table (stored in flash)
+ */
+typedef struct {
+    int32_t temp_mc[PTX_CAL_TABLE_SIZE];    // Temperature (m°C) at ratio i / PTX_CAL_SEGMENTS
+    int32_t temp_min_mc;                    // Temperature at the lower signal limit (10% vref)
+    int32_t temp_max_mc;                    // Temperature at the upper signal limit (90% vref)
+} ptx_cal_table_t;
+
+/**
+ * @brief Get the table of a profile
+ * @param profile Profile id; out-of-range ids return the nominal profile
+ * @return Pointer to the flash-resident table
+ */
+const ptx_cal_table_t* ptx_cal_get_table(uint8_t profile);
+
+/**
+ * @brief Integer lookup
+ * @param table Calibration table
+ * @param ratio_q32 signal/vref ratio in Q0.32
+ * @return Temperature (m°C)
+ */
+int32_t ptx_cal_lookup_mc(const ptx_cal_table_t* table, uint32_t ratio_q32);
+
+/**
+ * @brief Inverse of ptx_cal_lookup_mc() for thresholds
+ * @param table Calibration table
+ * @param temp_mc Temperature (m°C)
+ * @return Smallest ratio (Q0.32) whose lookup is above temp_mc, so that
+ *         lookup(r) > temp_mc exactly when r >= the result; 0xFFFFFFFF if none
+ * @note Bisects with ptx_cal_lookup_mc() (32 lookups): for configuration
+ *       changes, not per reading. Tables never decrease with the ratio.
+ */
+uint32_t ptx_cal_ratio_above_q32(const ptx_cal_table_t* table, int32_t temp_mc);
+
+/**
+ * @brief Float lookup
+ * @param table Calibration table
+ * @param ratio signal/vref ratio, [0, 1)
+ * @return Temperature (°C)
+ */
+float ptx_cal_lookup_c(const ptx_cal_table_t* table, float ratio);
+
+/**
+ * @brief Saturation values of a table
+ */
+int32_t ptx_cal_temp_min_mc(const ptx_cal_table_t* table);
+int32_t ptx_cal_temp_max_mc(const ptx_cal_table_t* table);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_CALIBRATION_H */
@@ -0,0 +1,199 @@
+/**
+ * @file ptx_config_store.cpp
+ * @brief EEPROM records of the configuration, round-robin over slots
+ */
+#include "ptx_config_store.h"
+#include "ptx_oven_config.h"
+#include "api.h"
+#include <string.h>
+
+#if (PTX_CONFIG_STORE_SLOTS < 2U) || (PTX_CONFIG_STORE_SLOTS > 8U)
+#error "PTX_CONFIG_STORE_SLOTS must be 2..8"
+#endif
+#if (PTX_CONFIG_STORE_ADDR + PTX_CONFIG_STORE_SLOTS * PTX_CONFIG_RECORD_SIZE) > EEPROM_SIZE_BYTES
+#error "Configuration store does not fit the EEPROM"
+#endif
+
+/* Record layout, little-endian */
+#define PTI_REC_MAGIC           0U
+#define PTI_REC_VERSION         1U
+#define PTI_REC_SEQUENCE        2U      // u16, newer records count up
+#define PTI_REC_HEADER_SIZE     4U
+#define PTI_REC_IGNITION_MS     4U      // u32
+#define PTI_REC_LOG_MS          8U      // u32
+#define PTI_REC_FAULT_MS        12U     // u32
+#define PTI_REC_RESUME_MS       16U     // u32
+#define PTI_REC_VREF_MIN_MV     20U     // u16
+#define PTI_REC_VREF_MAX_MV     22U     // u16
+#define PTI_REC_TARGET_MC       24U     // i32
+#define PTI_REC_DELTA_MC        28U     // i32
+#define PTI_REC_ATTEMPTS        32U     // u8
+#define PTI_REC_PROFILE         33U     // u8
+#define PTI_REC_PERIOD_MS       34U     // u16
+#define PTI_REC_CRC             36U     // u16, of every byte before it
+
+#define PTI_NO_SLOT             0xFFU
+
+/* What the slot headers say, read again by each load and save */
+typedef struct {
+    uint16_t sequences[PTX_CONFIG_STORE_SLOTS];
+    uint8_t  candidates;                // Slots holding a record of this format, as a bitmask
+    uint8_t  newest;                    // Slot with the newest header, PTI_NO_SLOT if none
+    uint16_t next_sequence;             // Past every header, so a new record always wins
+} pti_scan_t;
+
+static uint16_t pti_slot_addr(uint8_t slot) {
+    return (uint16_t)(PTX_CONFIG_STORE_ADDR + (uint16_t)slot * PTX_CONFIG_RECORD_SIZE);
+}
+
+// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), a byte at a time without a table
+static uint16_t pti_crc16(const uint8_t* data, uint8_t length) {
+    uint16_t crc = 0xFFFFU;
+    for (uint8_t i = 0; i < length; ++i) {
+        uint8_t x = (uint8_t)((crc >> 8) ^ data[i]);
+        x ^= (uint8_t)(x >> 4);
+        crc = (uint16_t)((crc << 8) ^ ((uint16_t)x << 12) ^ ((uint16_t)x << 5) ^ x);
+    }
+    return crc;
+}
+
+static void pti_put_u16(uint8_t* at, uint16_t value) {
+    at[0] = (uint8_t)value;
+    at[1] = (uint8_t)(value >> 8);
+}
+
+static void pti_put_u32(uint8_t* at, uint32_t value) {
+    pti_put_u16(at, (uint16_t)value);
+    pti_put_u16(at + 2, (uint16_t)(value >> 16));
+}
+
+static uint16_t pti_get_u16(const uint8_t* at) {
+    return (uint16_t)(at[0] | ((uint16_t)at[1] << 8));
+}
+
+static uint32_t pti_get_u32(const uint8_t* at) {
+    return pti_get_u16(at) | ((uint32_t)pti_get_u16(at + 2) << 16);
+}
+
+// Serial-number order, so the sequence may wrap
+static bool pti_newer(uint16_t a, uint16_t b) {
+    return (int16_t)(uint16_t)(a - b) > 0;
+}
+
+static void pti_encode(const ptx_oven_config_t* config, uint16_t sequence, uint8_t* rec) {
+    rec[PTI_REC_MAGIC] = PTX_CONFIG_RECORD_MAGIC;
+    rec[PTI_REC_VERSION] = PTX_CONFIG_RECORD_VERSION;
+    pti_put_u16(&rec[PTI_REC_SEQUENCE], sequence);
+    pti_put_u32(&rec[PTI_REC_IGNITION_MS], config->ignition_duration_ms);
+    pti_put_u32(&rec[PTI_REC_LOG_MS], config->periodic_log_ms);
+    pti_put_u32(&rec[PTI_REC_FAULT_MS], config->sensor_fault_window_ms);
+    pti_put_u32(&rec[PTI_REC_RESUME_MS], config->auto_resume_delay_ms);
+    pti_put_u16(&rec[PTI_REC_VREF_MIN_MV], (uint16_t)ptx_oven_round_milli(config->vref_min_v));
+    pti_put_u16(&rec[PTI_REC_VREF_MAX_MV], (uint16_t)ptx_oven_round_milli(config->vref_max_v));
+    pti_put_u32(&rec[PTI_REC_TARGET_MC], (uint32_t)ptx_oven_round_milli(config->temp_target_c));
+    pti_put_u32(&rec[PTI_REC_DELTA_MC], (uint32_t)ptx_oven_round_milli(config->temp_delta_c));
+    rec[PTI_REC_ATTEMPTS] = config->max_ignition_attempts;
+    rec[PTI_REC_PROFILE] = config->probe_profile;
+    pti_put_u16(&rec[PTI_REC_PERIOD_MS], config->iteration_period);
+    pti_put_u16(&rec[PTI_REC_CRC], pti_crc16(rec, PTI_REC_CRC));
+}
+
+// false if the CRC does not match
+static bool pti_decode(const uint8_t* rec, ptx_oven_config_t* config) {
+    if (pti_get_u16(&rec[PTI_REC_CRC]) != pti_crc16(rec, PTI_REC_CRC)) {
+        return false;
+    }
+    config->ignition_duration_ms = pti_get_u32(&rec[PTI_REC_IGNITION_MS]);
+    config->periodic_log_ms = pti_get_u32(&rec[PTI_REC_LOG_MS]);
+    config->sensor_fault_window_ms = pti_get_u32(&rec[PTI_REC_FAULT_MS]);
+    config->auto_resume_delay_ms = pti_get_u32(&rec[PTI_REC_RESUME_MS]);
+    config->vref_min_v = pti_get_u16(&rec[PTI_REC_VREF_MIN_MV]) / 1000.0f;
+    config->vref_max_v = pti_get_u16(&rec[PTI_REC_VREF_MAX_MV]) / 1000.0f;
+    config->temp_target_c = (int32_t)pti_get_u32(&rec[PTI_REC_TARGET_MC]) / 1000.0f;
+    config->temp_delta_c = (int32_t)pti_get_u32(&rec[PTI_REC_DELTA_MC]) / 1000.0f;
+    config->max_ignition_attempts = rec[PTI_REC_ATTEMPTS];
+    config->probe_profile = rec[PTI_REC_PROFILE];
+    config->iteration_period = pti_get_u16(&rec[PTI_REC_PERIOD_MS]);
+    return true;
+}
+
+// Read the header of every slot
+static void pti_scan(pti_scan_t* scan) {
+    scan->candidates = 0;
+    scan->newest = PTI_NO_SLOT;
+    scan->next_sequence = 0;
+
+    for (uint8_t slot = 0; slot < PTX_CONFIG_STORE_SLOTS; ++slot) {
+        uint8_t header[PTI_REC_HEADER_SIZE];
+        read_eeprom(pti_slot_addr(slot), header, sizeof(header));
+        if ((header[PTI_REC_MAGIC] != PTX_CONFIG_RECORD_MAGIC) ||
+            (header[PTI_REC_VERSION] != PTX_CONFIG_RECORD_VERSION)) {
+            continue;
+        }
+        uint16_t sequence = pti_get_u16(&header[PTI_REC_SEQUENCE]);
+        scan->sequences[slot] = sequence;
+        scan->candidates |= (uint8_t)(1U << slot);
+
+        /* Valid or not: the next record must be newer than every header */
+        if ((scan->newest == PTI_NO_SLOT) || !pti_newer(scan->next_sequence, sequence)) {
+            scan->next_sequence = (uint16_t)(sequence + 1U);
+            scan->newest = slot;
+        }
+    }
+}
+
+bool ptx_config_store_load(void) {
+    pti_scan_t scan;
+    pti_scan(&scan);
+    uint8_t candidates = scan.candidates;
+
+    /* Newest first; a record is read in full only once it is the best left */
+    while (candidates != 0U) {
+        uint8_t best = PTI_NO_SLOT;
+        for (uint8_t slot = 0; slot < PTX_CONFIG_STORE_SLOTS; ++slot) {
+            if (((candidates & (1U << slot)) != 0U) &&
+                ((best == PTI_NO_SLOT) || pti_newer(scan.sequences[slot], scan.sequences[best]))) {
+                best = slot;
+            }
+        }
+        candidates &= (uint8_t)~(1U << best);
+
+        uint8_t rec[PTX_CONFIG_RECORD_SIZE];
+        ptx_oven_config_t config;
+        read_eeprom(pti_slot_addr(best), rec, sizeof(rec));
+        if (pti_decode(rec, &config) && ptx_oven_set_config(&config)) {
+            return true;
+        }
+    }
+
+    ptx_oven_reset_config_to_defaults();
+    return false;
+}
+
+bool ptx_config_store_save(void) {
+    pti_scan_t scan;
+    ptx_oven_config_t config;
+    uint8_t rec[PTX_CONFIG_RECORD_SIZE];
+    uint8_t back[PTX_CONFIG_RECORD_SIZE];
+
+    /* From the headers, not from the last load: a save may come first */
+    pti_scan(&scan);
+    (void)ptx_oven_config_snapshot(&config);
+
+    /* Unchanged since the newest record: no wear */
+    if (scan.newest != PTI_NO_SLOT) {
+        read_eeprom(pti_slot_addr(scan.newest), back, sizeof(back));
+        pti_encode(&config, scan.sequences[scan.newest], rec);
+        if (memcmp(rec, back, sizeof(rec)) == 0) {
+            return true;
+        }
+    }
+
+    uint8_t slot = (scan.newest == PTI_NO_SLOT) ? 0U
+                 : (uint8_t)((scan.newest + 1U) % PTX_CONFIG_STORE_SLOTS);
+    pti_encode(&config, scan.next_sequence, rec);
+    update_eeprom(pti_slot_addr(slot), rec, sizeof(rec));
+
+    read_eeprom(pti_slot_addr(slot), back, sizeof(back));
+    return memcmp(rec, back, sizeof(rec)) == 0;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file ptx_config_store.h
+ * @brief Configuration persisted to EEPROM
+ * @details The configuration is stored as a compact binary record: a header
+ *          (magic, format version, sequence number), the parameters as
+ *          little-endian integers in milli-units, then a CRC-16/CCITT of all
+ *          of it. Floats are kept at the milli-unit resolution the integer
+ *          pipelines already round them to.
+ *
+ *          Records go round-robin into PTX_CONFIG_STORE_SLOTS slots, each
+ *          save into the slot after the newest one, so the cells wear
+ *          PTX_CONFIG_STORE_SLOTS times slower. The newest record whose CRC and
+ *          configuration are valid wins at boot: a save cut short by a power
+ *          loss fails its CRC and the previous record is used instead.
+ *
+ *          The boot load reads the headers only, then whole records newest
+ *          first until one is valid. Usually that is the headers and one
+ *          record (70 bytes); at worst every header and every record once
+ *          (336 bytes), well under a millisecond at 16 MHz.
+ */
+#ifndef PTX_CONFIG_STORE_H
+#define PTX_CONFIG_STORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PTX_CONFIG_RECORD_MAGIC     0xC7U
+#define PTX_CONFIG_RECORD_VERSION   1U      // Bump when the record layout changes
+#define PTX_CONFIG_RECORD_SIZE      38U     // Bytes, CRC included
+
+#ifndef PTX_CONFIG_STORE_ADDR
+#define PTX_CONFIG_STORE_ADDR       0U      // First EEPROM byte of the store
+#endif
+
+#ifndef PTX_CONFIG_STORE_SLOTS
+#define PTX_CONFIG_STORE_SLOTS      8U      // Records in rotation, at most 8
+#endif
+
+/**
+ * @brief Publish the newest valid stored configuration
+ * @return false if none was found: the defaults are published instead
+ * @note Call at boot, before ptx_oven_control_init(). Records of another
+ *       format version are ignored.
+ */
+bool ptx_config_store_load(void);
+
+/**
+ * @brief Store the active configuration in the next slot
+ * @return false if the record did not read back as written
+ * @note Does nothing if the newest record already holds it. Finds the newest
+ *       record from the slot headers itself, so no load is needed first. Each
+ *       EEPROM byte written blocks ~3.4 ms on the board: save after a retune,
+ *       not from the control loop.
+ */
+bool ptx_config_store_save(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_CONFIG_STORE_H */
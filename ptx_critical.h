@@ -0,0 +1,46 @@
+/**
+ * @file ptx_critical.h
+ * @brief Short interrupt-masked critical sections
+ * @details Used around data shared between interrupt handlers and the main loop.
+ *          On AVR the global interrupt flag is saved and cleared, then restored.
+ *          The host build is single-threaded with no interrupts, so it is a no-op.
+ */
+#ifndef PTX_CRITICAL_H
+#define PTX_CRITICAL_H
+
+#include <stdint.h>
+
+#if defined(__AVR__)
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#endif
+
+typedef uint8_t ptx_irq_state_t;
+
+/**
+ * @brief Enter a critical section
+ * @return Previous interrupt state, to pass to ptx_irq_restore()
+ */
+static inline ptx_irq_state_t ptx_irq_save(void) {
+#if defined(__AVR__)
+    ptx_irq_state_t state = SREG;
+    cli();
+    return state;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Leave a critical section
+ * @param state Value returned by the matching ptx_irq_save()
+ */
+static inline void ptx_irq_restore(ptx_irq_state_t state) {
+#if defined(__AVR__)
+    SREG = state;
+#else
+    (void)state;
+#endif
+}
+
+#endif /* PTX_CRITICAL_H */
@@ -8,8 +8,51 @@ Then check `notes.md`.
 #include "api.h"
 #include "ptx_logging.h"
 #include "ptx_actuator.h"
+#include "ptx_adc_sampler.h"
+#include "ptx_config_store.h"
 #include "ptx_oven_config.h"
 #include "ptx_oven_control.h"
+#include "ptx_scheduler.h"
+#include "ptx_sensor_filter.h"
+
+#define TX_SERVICE_PERIOD_MS  5   // 64-byte UART buffer empties in ~5.5 ms at 115200 baud
+
+static int8_t control_task_id = PTX_SCHED_INVALID;
+static int8_t sched_log_task_id = PTX_SCHED_INVALID;
+
+// Control loop at the configured iteration period
+static void control_task(uint32_t now_ms)
+{
+  (void)now_ms;
+  ptx_oven_control_update();
+
+  // Follow runtime changes of iteration_period
+  ptx_sched_set_period(control_task_id, ptx_oven_get_iteration_period());
+}
+
+// Move queued log output to the UART without blocking
+static void tx_service_task(uint32_t now_ms)
+{
+  (void)now_ms;
+  ptx_log_drain();
+}
+
+// Control task timing, next to the controller's own periodic status
+static void sched_log_task(uint32_t now_ms)
+{
+  (void)now_ms;
+  ptx_sched_stats_t stats;
+  if (ptx_sched_get_stats(control_task_id, &stats)) {
+    PTX_LOGF_PERIODIC("sched runs=%lu overruns=%u late_max=%ums late_last=%ums",
+             (unsigned long)stats.runs,
+             (unsigned)stats.overruns,
+             (unsigned)stats.max_lateness_ms,
+             (unsigned)stats.last_lateness_ms);
+  }
+
+  // Follow runtime changes of periodic_log_ms
+  ptx_sched_set_period(sched_log_task_id, ptx_oven_get_periodic_log_ms());
+}
 
 void setup() {
 
@@ -19,9 +62,19 @@ void setup() {
   //Wrapper API
   setup_api();
 
+  // Tuning saved before the last power cycle, else the defaults
+  ptx_config_store_load();
+
   // Intialize controller
   ptx_oven_control_init();
 
+  // Control first: when both are due it runs before the serial work
+  uint32_t now = millis();
+  ptx_sched_init();
+  control_task_id = ptx_sched_add(control_task, ptx_oven_get_iteration_period(), now);
+  ptx_sched_add(tx_service_task, TX_SERVICE_PERIOD_MS, now);
+  sched_log_task_id = ptx_sched_add(sched_log_task, ptx_oven_get_periodic_log_ms(), now + ptx_oven_get_periodic_log_ms());
+
   PTX_LOGF("Elf oven 2000 starting up.");
   PTX_LOGF("Days without fire incident: %i\n", 0);
 }
@@ -29,14 +82,9 @@ void setup() {
 
 void door_sensor_interrupt_handler(bool voltage_high)
 {
-  // @TODO: add small filtering for stability if needed
-  if (voltage_high) {
-    PTX_LOGF("[WARNING] Door is opened");
-    ptx_actuator_emergency_stop();
-  }
-
-  // Propagate state to controller; controller loop will handle any logging.
-  ptx_oven_set_door_state(voltage_high);
+  // Interrupt context: stop gas, timestamp and queue the edge; the control
+  // task logs it. No formatting or serial output here.
+  ptx_oven_door_isr(voltage_high);
 }
 
 void loop() {
@@ -52,13 +100,18 @@ void loop() {
 #if 0
   test_hardware();
 #endif
-  // Run oven control loop
-  ptx_oven_control_update();
-
-  // Delay 100 ms. Because temperature changes very slowly, Safety is guaranteed by the door interrupt, not the loop speed
-  //delay(ptx_oven_get_iteration_period());
-  delay(100);
+  // Run due tasks against absolute deadlines: the control period does not
+  // depend on how long the previous iteration or the logging took
+  ptx_sched_run(millis());
+}
 
+// Wait, moving queued serial output to the UART meanwhile
+static void drain_for_ms(uint32_t duration_ms)
+{
+  uint32_t start = millis();
+  do {
+    ptx_log_drain();
+  } while ((uint32_t)(millis() - start) < duration_ms);
 }
 
 // Simple hardware test
@@ -69,11 +122,23 @@ void test_hardware()
   while(1)
   {
     //Read sensor
+#if PTX_ADC_SAMPLER_ENABLED
+    // The sampler started by ptx_oven_control_init() owns the ADC
+    uint16_t vref_mv_q;
+    uint16_t signal_mv_q;
+    ptx_adc_sampler_read_mv_q(&vref_mv_q, &signal_mv_q);
+    sensor_voltage = (uint16_t)(signal_mv_q >> PTX_OVERSAMPLE_BITS);
+    serial_printf("sensor_voltage %i\n", sensor_voltage);
+
+    sensor_voltage = (uint16_t)(vref_mv_q >> PTX_OVERSAMPLE_BITS);
+    serial_printf("sensor_voltage_ref %i\n", sensor_voltage);
+#else
     sensor_voltage = read_voltage(TEMPERATURE_SENSOR);
     serial_printf("sensor_voltage %i\n", sensor_voltage);
 
     sensor_voltage = read_voltage(TEMPERATURE_SENSOR_REFERENCE);
     serial_printf("sensor_voltage_ref %i\n", sensor_voltage);
+#endif
 
     //Toggle all ouput
     // set_output(GAS_VALVE, true);
@@ -83,7 +148,7 @@ void test_hardware()
     ptx_actuator_set_gas(true);
     ptx_actuator_set_igniter(true);
     ptx_actuator_set_system_led_status(true);
-    delay(1000);
+    drain_for_ms(1000);
 
     // set_output(GAS_VALVE, false);
     // set_output(SYS_LED_STATUS, false);
@@ -92,6 +157,6 @@ void test_hardware()
     ptx_actuator_set_gas(false);
     ptx_actuator_set_igniter(false);
     ptx_actuator_set_system_led_status(false);
-    delay(1000);
+    drain_for_ms(1000);
   }
 }
\ No newline at end of file
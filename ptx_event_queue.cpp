@@ -0,0 +1,62 @@
+/**
+ * @file ptx_event_queue.cpp
+ * @brief Implementation of the lock-free SPSC event queue
+ */
+#include "ptx_event_queue.h"
+#include "ptx_critical.h"
+
+#if (PTX_EVENT_QUEUE_SIZE & (PTX_EVENT_QUEUE_SIZE - 1U)) != 0U || PTX_EVENT_QUEUE_SIZE > 128U
+#error "PTX_EVENT_QUEUE_SIZE must be a power of two no larger than 128"
+#endif
+
+#define PTI_EVENT_MASK (PTX_EVENT_QUEUE_SIZE - 1U)
+
+/* Ordering of the slot contents against the index that publishes them */
+#define PTI_LOAD_ACQUIRE(p)         __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define PTI_LOAD_RELAXED(p)         __atomic_load_n((p), __ATOMIC_RELAXED)
+#define PTI_STORE_RELEASE(p, v)     __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+/* Free-running indices; head is written by the producer only, tail by the consumer only */
+static ptx_event_t pti_events[PTX_EVENT_QUEUE_SIZE];
+static uint8_t pti_head = 0;
+static uint8_t pti_tail = 0;
+static uint16_t pti_dropped = 0;    /* Producer only */
+
+void ptx_event_queue_reset(void) {
+    PTI_STORE_RELEASE(&pti_head, 0);
+    PTI_STORE_RELEASE(&pti_tail, 0);
+    PTI_STORE_RELEASE(&pti_dropped, 0);
+}
+
+bool ptx_event_push(const ptx_event_t* event) {
+    uint8_t head = PTI_LOAD_RELAXED(&pti_head);
+    uint8_t tail = PTI_LOAD_ACQUIRE(&pti_tail);
+
+    if ((uint8_t)(head - tail) >= PTX_EVENT_QUEUE_SIZE) {
+        PTI_STORE_RELEASE(&pti_dropped, (uint16_t)(PTI_LOAD_RELAXED(&pti_dropped) + 1U));
+        return false;
+    }
+
+    pti_events[head & PTI_EVENT_MASK] = *event;
+    PTI_STORE_RELEASE(&pti_head, (uint8_t)(head + 1U));
+    return true;
+}
+
+bool ptx_event_pop(ptx_event_t* event) {
+    uint8_t tail = PTI_LOAD_RELAXED(&pti_tail);
+    uint8_t head = PTI_LOAD_ACQUIRE(&pti_head);
+
+    if (head == tail) return false;
+
+    *event = pti_events[tail & PTI_EVENT_MASK];
+    PTI_STORE_RELEASE(&pti_tail, (uint8_t)(tail + 1U));
+    return true;
+}
+
+uint16_t ptx_event_dropped(void) {
+    /* Two-byte read on AVR: keep the producer out for its duration */
+    ptx_irq_state_t irq = ptx_irq_save();
+    uint16_t dropped = PTI_LOAD_RELAXED(&pti_dropped);
+    ptx_irq_restore(irq);
+    return dropped;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file ptx_event_queue.h
+ * @brief Lock-free single-producer/single-consumer event queue (ISR -> main loop)
+ * @details The producer is one interrupt handler, the consumer is the main
+ *          loop. Each side owns one index: the producer fills a slot and then
+ *          publishes it by advancing head (release), the consumer reads the
+ *          slot after seeing head (acquire) and then frees it by advancing
+ *          tail. No interrupt masking is needed; the indices are single bytes,
+ *          which AVR reads and writes atomically.
+ *
+ *          When the queue is full the new event is dropped and counted. State
+ *          that must never be lost (e.g. the door level) is kept separately by
+ *          the producer; events only carry what happened and when.
+ */
+#ifndef PTX_EVENT_QUEUE_H
+#define PTX_EVENT_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Queue capacity in events (power of two, at most 128)
+ */
+#ifndef PTX_EVENT_QUEUE_SIZE
+#define PTX_EVENT_QUEUE_SIZE 8U
+#endif
+
+/**
+ * @brief Event kinds
+ */
+typedef enum {
+    PTX_EVENT_NONE = 0,
+    PTX_EVENT_DOOR,             // Door edge; value = 1 open, 0 closed
+} ptx_event_type_t;
+
+/**
+ * @brief One event
+ */
+typedef struct {
+    uint8_t  type;              // ptx_event_type_t
+    uint8_t  value;             // Event-specific value
+    uint32_t time_us;           // micros() when the edge was seen
+    uint32_t ack_us;            // micros() when the handler's immediate action was done
+} ptx_event_t;
+
+/**
+ * @brief Empty the queue and clear the drop counter
+ * @note Not safe while the producer may run
+ */
+void ptx_event_queue_reset(void);
+
+/**
+ * @brief Queue an event (producer side, interrupt context)
+ * @return false if the queue was full and the event was dropped
+ */
+bool ptx_event_push(const ptx_event_t* event);
+
+/**
+ * @brief Take the oldest event (consumer side, main loop)
+ * @return false if the queue is empty
+ */
+bool ptx_event_pop(ptx_event_t* event);
+
+/**
+ * @brief Number of events dropped because the queue was full
+ */
+uint16_t ptx_event_dropped(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_EVENT_QUEUE_H */
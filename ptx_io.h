@@ -0,0 +1,158 @@
+/**
+ * @file ptx_io.h
+ * @brief I/O binding for output_t / input_t
+ * @details ptx_io_table_t is a run-time I/O table that a caller can inject per
+ *          oven instance (a gateway driving many ovens, a simulator).
+ *
+ *          For the board itself, ptx_io_write<GAS_VALVE>(on), ptx_io_read<GAS_VALVE>() and
+ *          ptx_io_read_mv<TEMPERATURE_SENSOR>() resolve the pin, port, bit
+ *          and ADC channel at compile time from the api.h mapping, so there
+ *          is no run-time branching on the output/input id.
+ *
+ *          ATmega328P: direct PORTx/PINx access (a single sbi/cbi/sbic) and
+ *                      direct ADC conversion on the mapped channel.
+ *          Other AVR:  digitalWrite()/digitalRead()/analogRead() with a
+ *                      constant pin number.
+ *          Host:       set_output()/read_output()/read_voltage() from api.h,
+ *                      i.e. the test mock.
+ */
+#ifndef PTX_IO_H
+#define PTX_IO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Injected I/O table for one oven instance
+ * @note Every callback receives user unchanged; NULL tables mean "this board",
+ *       bound at compile time below.
+ */
+typedef struct {
+    void*    user;                                              // Instance handle for the callbacks
+    uint16_t (*read_mv)(void* user, input_t input);             // Sample an input (mV)
+    void     (*write)(void* user, output_t output, bool on);    // Drive an output
+    bool     (*read)(void* user, output_t output);              // Read back an output
+} ptx_io_table_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef __cplusplus
+
+#if defined(__AVR__)
+#include <Arduino.h>
+#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__)
+#define PTX_IO_DIRECT 1
+#endif
+#endif
+
+#ifndef PTX_IO_DIRECT
+#define PTX_IO_DIRECT 0
+#endif
+
+/* Output id -> Arduino pin */
+template <output_t O> struct ptx_output_traits;
+template <> struct ptx_output_traits<GAS_VALVE>      { static constexpr uint8_t pin = GAS_VALVE_PIN; };
+template <> struct ptx_output_traits<SYS_LED_STATUS> { static constexpr uint8_t pin = SYS_LED_STATUS_PIN; };
+template <> struct ptx_output_traits<IGNITER>        { static constexpr uint8_t pin = IGNITER_PIN; };
+
+/* Input id -> ADC channel and counts-to-millivolts scaling.
+   to_mv_q() scales counts with `bits` fractional bits (oversampled) to
+   millivolts with the same fractional bits. */
+template <input_t I> struct ptx_input_traits;
+template <> struct ptx_input_traits<TEMPERATURE_SENSOR> {
+    static constexpr uint8_t channel = 0;           // A0
+    static inline uint16_t to_mv_q(uint16_t raw_q, uint8_t bits) {
+        (void)bits;
+        return (uint16_t)((uint32_t)raw_q * 5000U / 1023U);
+    }
+    static inline uint16_t to_mv(uint16_t raw) {
+        return to_mv_q(raw, 0);
+    }
+};
+template <> struct ptx_input_traits<TEMPERATURE_SENSOR_REFERENCE> {
+    static constexpr uint8_t channel = 1;           // A1
+    static inline uint16_t to_mv_q(uint16_t raw_q, uint8_t bits) {
+        /* Range from 4.5 V to 5.5 V for easier testing */
+        return (uint16_t)(((uint32_t)raw_q * 1000U / 1023U) + (4500UL << bits));
+    }
+    static inline uint16_t to_mv(uint16_t raw) {
+        return to_mv_q(raw, 0);
+    }
+};
+
+#if PTX_IO_DIRECT
+/* ATmega328P data-space register addresses: D0-D7 on port D, D8-D13 on port B */
+template <uint8_t Pin> struct ptx_dpin {
+    static_assert(Pin <= 13U, "direct I/O maps digital pins D0-D13 only");
+    static constexpr uint16_t port_addr = (Pin < 8U) ? 0x2BU : 0x25U;  // PORTD / PORTB
+    static constexpr uint16_t pin_addr  = (Pin < 8U) ? 0x29U : 0x23U;  // PIND / PINB
+    static constexpr uint8_t  mask      = (uint8_t)(1U << ((Pin < 8U) ? Pin : (Pin - 8U)));
+
+    static inline void write(bool on) {
+        volatile uint8_t* port = (volatile uint8_t*)port_addr;
+        if (on) *port |= mask;
+        else    *port &= (uint8_t)~mask;
+    }
+    static inline bool read(void) {
+        return ((*(volatile uint8_t*)pin_addr) & mask) != 0U;
+    }
+};
+#endif
+
+/**
+ * @brief Drive an output
+ */
+template <output_t O>
+inline void ptx_io_write(bool on) {
+#if PTX_IO_DIRECT
+    ptx_dpin<ptx_output_traits<O>::pin>::write(on);
+#elif defined(__AVR__)
+    digitalWrite(ptx_output_traits<O>::pin, on ? HIGH : LOW);
+#else
+    set_output(O, on);
+#endif
+}
+
+/**
+ * @brief Read back the level of an output pin
+ */
+template <output_t O>
+inline bool ptx_io_read(void) {
+#if PTX_IO_DIRECT
+    return ptx_dpin<ptx_output_traits<O>::pin>::read();
+#elif defined(__AVR__)
+    return digitalRead(ptx_output_traits<O>::pin) == HIGH;
+#else
+    return read_output(O);
+#endif
+}
+
+/**
+ * @brief Convert an input and return it in millivolts
+ * @note Blocks for one ADC conversion (~104 us at the Arduino prescaler)
+ */
+template <input_t I>
+inline uint16_t ptx_io_read_mv(void) {
+#if PTX_IO_DIRECT
+    /* AVcc reference, right-adjusted, mapped channel */
+    ADMUX = (uint8_t)((1U << REFS0) | ptx_input_traits<I>::channel);
+    ADCSRA |= (uint8_t)(1U << ADSC);
+    while (ADCSRA & (1U << ADSC)) { }
+    return ptx_input_traits<I>::to_mv(ADC);
+#elif defined(__AVR__)
+    return ptx_input_traits<I>::to_mv((uint16_t)analogRead(A0 + ptx_input_traits<I>::channel));
+#else
+    return read_voltage(I);
+#endif
+}
+
+#endif /* __cplusplus */
+
+#endif /* PTX_IO_H */
@@ -0,0 +1,118 @@
+/**
+ * @file ptx_log_ring.cpp
+ * @brief Implementation of the deferred-logging ring buffer
+ */
+#include "ptx_log_ring.h"
+#include "ptx_critical.h"
+
+#if (PTX_LOG_RING_SIZE & (PTX_LOG_RING_SIZE - 1U)) != 0U || PTX_LOG_RING_SIZE > 32768U
+#error "PTX_LOG_RING_SIZE must be a power of two no larger than 32768"
+#endif
+
+#define PTI_RING_MASK (PTX_LOG_RING_SIZE - 1U)
+
+/* Fill limit per priority, as in the serial TX queue */
+static const uint16_t pti_fill_limit[PTX_TX_PRIO_COUNT] = {
+    PTX_LOG_RING_SIZE / 2U,             /* PTX_TX_PRIO_LOW */
+    (PTX_LOG_RING_SIZE / 4U) * 3U,      /* PTX_TX_PRIO_NORMAL */
+    PTX_LOG_RING_SIZE,                  /* PTX_TX_PRIO_HIGH */
+};
+
+/* Free-running indices; used bytes = head - tail */
+static uint8_t pti_ring[PTX_LOG_RING_SIZE];
+static volatile uint16_t pti_head = 0;
+static volatile uint16_t pti_tail = 0;
+static volatile uint16_t pti_dropped = 0;
+
+void ptx_log_ring_reset(void) {
+    ptx_irq_state_t irq = ptx_irq_save();
+    pti_head = 0;
+    pti_tail = 0;
+    pti_dropped = 0;
+    ptx_irq_restore(irq);
+}
+
+bool ptx_log_ring_write(const uint8_t* data, uint8_t len, ptx_tx_prio_t prio) {
+    bool written = false;
+
+    if ((unsigned)prio >= PTX_TX_PRIO_COUNT) {
+        prio = PTX_TX_PRIO_NORMAL;
+    }
+
+    /* Producers: main loop and interrupt handlers */
+    ptx_irq_state_t irq = ptx_irq_save();
+    uint16_t head = pti_head;
+    uint16_t used = (uint16_t)(head - pti_tail);
+
+    if ((uint32_t)used + len <= pti_fill_limit[prio]) {
+        uint16_t start = head & PTI_RING_MASK;
+        uint16_t first = (uint16_t)(PTX_LOG_RING_SIZE - start);
+        if (first > len) first = len;
+
+        memcpy(&pti_ring[start], data, first);
+        memcpy(&pti_ring[0], data + first, (size_t)(len - first));
+        pti_head = (uint16_t)(head + len);
+        written = true;
+    } else {
+        pti_dropped = (uint16_t)(pti_dropped + 1U);
+    }
+    ptx_irq_restore(irq);
+
+    return written;
+}
+
+uint16_t ptx_log_ring_peek(const uint8_t** data) {
+    ptx_irq_state_t irq = ptx_irq_save();
+    uint16_t head = pti_head;
+    ptx_irq_restore(irq);
+
+    uint16_t tail = pti_tail;
+    uint16_t used = (uint16_t)(head - tail);
+    uint16_t start = tail & PTI_RING_MASK;
+    uint16_t contiguous = (uint16_t)(PTX_LOG_RING_SIZE - start);
+
+    *data = &pti_ring[start];
+    return (used < contiguous) ? used : contiguous;
+}
+
+uint8_t ptx_log_ring_peek_record(uint8_t* out) {
+    ptx_irq_state_t irq = ptx_irq_save();
+    uint16_t head = pti_head;
+    ptx_irq_restore(irq);
+
+    uint16_t tail = pti_tail;
+    uint16_t used = (uint16_t)(head - tail);
+    if (used < 2U) return 0;
+
+    /* Records are written whole, so the length byte and payload are all there */
+    uint16_t len = (uint16_t)(pti_ring[(uint16_t)(tail + 1U) & PTI_RING_MASK] + 2U);
+    if (len > used || len > PTX_LOG_RECORD_MAX) return 0;
+
+    uint16_t start = tail & PTI_RING_MASK;
+    uint16_t first = (uint16_t)(PTX_LOG_RING_SIZE - start);
+    if (first > len) first = len;
+
+    memcpy(out, &pti_ring[start], first);
+    memcpy(out + first, &pti_ring[0], (size_t)(len - first));
+    return (uint8_t)len;
+}
+
+void ptx_log_ring_consume(uint16_t count) {
+    ptx_irq_state_t irq = ptx_irq_save();
+    pti_tail = (uint16_t)(pti_tail + count);
+    ptx_irq_restore(irq);
+}
+
+uint16_t ptx_log_ring_used(void) {
+    ptx_irq_state_t irq = ptx_irq_save();
+    uint16_t used = (uint16_t)(pti_head - pti_tail);
+    ptx_irq_restore(irq);
+    return used;
+}
+
+uint16_t ptx_log_ring_dropped(void) {
+    ptx_irq_state_t irq = ptx_irq_save();
+    uint16_t dropped = pti_dropped;
+    ptx_irq_restore(irq);
+    return dropped;
+}
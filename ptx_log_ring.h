@@ -0,0 +1,169 @@
+/**
+ * @file ptx_log_ring.h
+ * @brief Binary log records and the RAM ring buffer used by deferred logging
+ * @details In deferred mode (PTX_LOG_DEFERRED) a log call does not format
+ *          anything. It copies a compact binary record into this ring buffer;
+ *          the main loop drains the ring to the serial port when it is idle,
+ *          and tools/ptx_log_decode.py turns the stream back into text.
+ *
+ *          Record layout (little endian):
+ *            u8  PTX_LOG_SYNC
+ *            u8  payload length
+ *            u32 timestamp (ms)
+ *            u16 file id      (FNV-1a of the source file basename, folded to 16 bits)
+ *            u16 line
+ *            args, each one of:
+ *              'i' i32        integer argument
+ *              's' u8 n, n x char  string argument (truncated to PTX_LOG_STR_MAX)
+ *
+ *          (file id, line) identifies the format string; the decoder finds it
+ *          by scanning the sources for log calls.
+ *
+ *          Records carry the priority of the text line they stand for, with the
+ *          fill limits of the serial TX queue (ptx_serial_tx.h): low up to 1/2
+ *          of the ring, normal up to 3/4, high the whole ring. Periodic records
+ *          filling the ring cannot crowd out an error.
+ */
+#ifndef PTX_LOG_RING_H
+#define PTX_LOG_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "ptx_serial_tx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Ring buffer capacity in bytes (power of two)
+ */
+#ifndef PTX_LOG_RING_SIZE
+#if defined(__AVR__)
+#define PTX_LOG_RING_SIZE 128U
+#else
+#define PTX_LOG_RING_SIZE 1024U
+#endif
+#endif
+
+#define PTX_LOG_SYNC            0xA5U   // First byte of every record
+#define PTX_LOG_HEADER_SIZE     10U     // sync, length, timestamp, file id, line
+#define PTX_LOG_RECORD_MAX      64U     // Largest record, header included
+#define PTX_LOG_STR_MAX         24U     // Longest string argument kept
+
+#define PTX_LOG_ARG_INT         'i'
+#define PTX_LOG_ARG_STR         's'
+
+/**
+ * @brief Record being assembled on the caller's stack
+ */
+typedef struct {
+    uint8_t len;                        /**< Bytes used in buf */
+    uint8_t buf[PTX_LOG_RECORD_MAX];    /**< Encoded record */
+} ptx_log_record_t;
+
+/**
+ * @brief Start a record
+ */
+static inline void ptx_log_record_begin(ptx_log_record_t* rec, uint32_t time_ms,
+                                        uint16_t file_id, uint16_t line) {
+    rec->buf[0] = PTX_LOG_SYNC;
+    rec->buf[1] = 0;
+    rec->buf[2] = (uint8_t)time_ms;
+    rec->buf[3] = (uint8_t)(time_ms >> 8);
+    rec->buf[4] = (uint8_t)(time_ms >> 16);
+    rec->buf[5] = (uint8_t)(time_ms >> 24);
+    rec->buf[6] = (uint8_t)file_id;
+    rec->buf[7] = (uint8_t)(file_id >> 8);
+    rec->buf[8] = (uint8_t)line;
+    rec->buf[9] = (uint8_t)(line >> 8);
+    rec->len = PTX_LOG_HEADER_SIZE;
+}
+
+/**
+ * @brief Append an integer argument (dropped if the record is full)
+ */
+static inline void ptx_log_record_put_int(ptx_log_record_t* rec, int32_t value) {
+    if (rec->len + 5U > PTX_LOG_RECORD_MAX) return;
+    uint8_t* p = &rec->buf[rec->len];
+    p[0] = PTX_LOG_ARG_INT;
+    p[1] = (uint8_t)value;
+    p[2] = (uint8_t)((uint32_t)value >> 8);
+    p[3] = (uint8_t)((uint32_t)value >> 16);
+    p[4] = (uint8_t)((uint32_t)value >> 24);
+    rec->len += 5U;
+}
+
+/**
+ * @brief Append a string argument (truncated to fit)
+ */
+static inline void ptx_log_record_put_str(ptx_log_record_t* rec, const char* str) {
+    if (rec->len + 2U > PTX_LOG_RECORD_MAX) return;
+    size_t n = (str != NULL) ? strlen(str) : 0U;
+    size_t room = PTX_LOG_RECORD_MAX - rec->len - 2U;
+    if (n > PTX_LOG_STR_MAX) n = PTX_LOG_STR_MAX;
+    if (n > room) n = room;
+
+    rec->buf[rec->len] = PTX_LOG_ARG_STR;
+    rec->buf[rec->len + 1U] = (uint8_t)n;
+    memcpy(&rec->buf[rec->len + 2U], str, n);
+    rec->len = (uint8_t)(rec->len + 2U + n);
+}
+
+/**
+ * @brief Finish a record: fill in the payload length
+ */
+static inline void ptx_log_record_end(ptx_log_record_t* rec) {
+    rec->buf[1] = (uint8_t)(rec->len - 2U);
+}
+
+/**
+ * @brief Drop all buffered bytes and clear the drop counter
+ */
+void ptx_log_ring_reset(void);
+
+/**
+ * @brief Append a whole record
+ * @param prio Priority; the ring fills only up to its limit
+ * @return false if it did not fit; the record is dropped and counted
+ * @note Safe to call from interrupt context
+ */
+bool ptx_log_ring_write(const uint8_t* data, uint8_t len, ptx_tx_prio_t prio);
+
+/**
+ * @brief Get the readable bytes that are contiguous in memory
+ * @param data Set to the first readable byte
+ * @return Number of contiguous readable bytes (0 if empty)
+ * @note Single consumer only (the idle-time drain)
+ */
+uint16_t ptx_log_ring_peek(const uint8_t** data);
+
+/**
+ * @brief Copy out the oldest whole record without releasing it
+ * @param out Buffer of at least PTX_LOG_RECORD_MAX bytes
+ * @return Record length (0 if the ring is empty)
+ * @note Release it with ptx_log_ring_consume() once it has been forwarded
+ */
+uint8_t ptx_log_ring_peek_record(uint8_t* out);
+
+/**
+ * @brief Release bytes returned by ptx_log_ring_peek() or ptx_log_ring_peek_record()
+ */
+void ptx_log_ring_consume(uint16_t count);
+
+/**
+ * @brief Number of bytes waiting to be drained
+ */
+uint16_t ptx_log_ring_used(void);
+
+/**
+ * @brief Number of records dropped because the ring was full
+ */
+uint16_t ptx_log_ring_dropped(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_LOG_RING_H */
@@ -4,58 +4,117 @@
  */
 
 #include "ptx_logging.h"
+#include "ptx_serial_tx.h"
+#include "ptx_progmem.h"
+#include "api.h"
 #include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
 
 void ptx_log_init() {
     Serial.begin(115200);
     while (!Serial) { ; }
 }
 
-//Get log file name
-const char* ptx_get_filename(const char* path) {
-    const char* filename = "log"; 
-    return filename;
+#define PTI_LOG_LINE_MAX 160U      // Whole line: prefix, message and "\r\n"
+
+// Write the "[time][filename:line] " prefix; returns its length
+// file is a PROGMEM string on AVR (PTX_LOG_FILENAME)
+static size_t pti_log_prefix(char* buffer, size_t size, const char* file, int line) {
+    int n = ptx_snprintf_P(buffer, size, PTX_PSTR("[%lu][%" PTX_PRI_PSTR ":%d] "),
+                           (unsigned long)millis(), file, line);
+    if (n < 0) return 0;
+    return ((size_t)n < size) ? (size_t)n : size - 1U;
+}
+
+// Errors and warnings must survive a full queue
+static ptx_tx_prio_t pti_log_classify(const char* msg) {
+    if ((ptx_strncmp_P(msg, PTX_PSTR("[ERROR"), 6) == 0) || (ptx_strncmp_P(msg, PTX_PSTR("[WARN"), 5) == 0)) {
+        return PTX_TX_PRIO_HIGH;
+    }
+    return PTX_TX_PRIO_NORMAL;
+}
+
+// Terminate the line and queue it whole
+static void pti_log_queue(char* buffer, size_t len, ptx_tx_prio_t prio) {
+    if (len > PTI_LOG_LINE_MAX - 2U) len = PTI_LOG_LINE_MAX - 2U;
+    buffer[len++] = '\r';
+    buffer[len++] = '\n';
+    ptx_serial_tx_write(buffer, (uint16_t)len, prio);
+}
+
+// Format into the line after the prefix; format is in flash on AVR
+static void pti_log_vformat(const char* file, int line, ptx_tx_prio_t prio,
+                            const char* format, va_list args) {
+    char buffer[PTI_LOG_LINE_MAX];
+    size_t n = pti_log_prefix(buffer, PTI_LOG_LINE_MAX - 2U, file, line);
+
+    char* msg = &buffer[n];
+    msg[0] = '\0';
+    ptx_vsnprintf_P(msg, PTI_LOG_LINE_MAX - 2U - n, format, args);
+    if (prio == PTX_TX_PRIO_NORMAL) prio = pti_log_classify(msg);
+
+    pti_log_queue(buffer, n + strlen(msg), prio);
 }
 
 //Basic logging function
 void ptx_log(const char* file, int line, const char* msg) {
-    unsigned long currentTime = millis();
-    const char* filename = ptx_get_filename(file);
-    
+    char buffer[PTI_LOG_LINE_MAX];
+    size_t n = pti_log_prefix(buffer, PTI_LOG_LINE_MAX - 2U, file, line);
+    size_t len = strlen(msg);
+
     // Format: [time][filename:line] message
-    Serial.print("[");
-    Serial.print(currentTime);
-    Serial.print("][");
-    Serial.print(filename);
-    Serial.print(":");
-    Serial.print(line);
-    Serial.print("] ");
-    Serial.println(msg);
+    if (len > PTI_LOG_LINE_MAX - 2U - n) len = PTI_LOG_LINE_MAX - 2U - n;
+    memcpy(&buffer[n], msg, len);
+    pti_log_queue(buffer, n + len, pti_log_classify(msg));
 }
 
 //Formatted logging function
 void ptx_logf(const char* file, int line, const char* format, ...) {
-    char buffer[256];
     va_list args;
     
     va_start(args, format);
-    vsnprintf(buffer, sizeof(buffer), format, args);
+    pti_log_vformat(file, line, PTX_TX_PRIO_NORMAL, format, args);
     va_end(args);
-    
-    ptx_log(file, line, buffer);
 }
 
-//Formatted logging function
-void ptx_dbg_logf(const char* file, int line, const char* format, ...) {
+//Periodic status logging: first to go when the TX queue backs up
+void ptx_logf_periodic(const char* file, int line, const char* format, ...) {
+    va_list args;
+
+    va_start(args, format);
+    pti_log_vformat(file, line, PTX_TX_PRIO_LOW, format, args);
+    va_end(args);
+}
 
-#if DEBUG_EN
-    char buffer[256];
+//Leveled logging function: the level picks the TX priority
+void ptx_logf_level(const char* file, int line, uint8_t level, const char* format, ...) {
+    ptx_tx_prio_t prio = PTX_TX_PRIO_NORMAL;
     va_list args;
-    
+
+    if (level <= PTX_LOG_LEVEL_DEBUG) {
+        prio = PTX_TX_PRIO_LOW;
+    } else if (level >= PTX_LOG_LEVEL_WARN) {
+        prio = PTX_TX_PRIO_HIGH;
+    }
+
     va_start(args, format);
-    vsnprintf(buffer, sizeof(buffer), format, args);
+    pti_log_vformat(file, line, prio, format, args);
     va_end(args);
-    
-    ptx_log(file, line, buffer);
+}
+
+//Move deferred records into the TX queue, then push queued bytes to Serial
+void ptx_log_drain(void) {
+#if PTX_LOG_DEFERRED
+    uint8_t rec[PTX_LOG_RECORD_MAX];
+    uint8_t len;
+
+    /* Records wait in the log ring until the TX queue has room, so none are lost here */
+    while ((len = ptx_log_ring_peek_record(rec)) > 0U) {
+        if (ptx_serial_tx_room(PTX_TX_PRIO_NORMAL) < len) break;
+        ptx_serial_tx_write((const char*)rec, len, PTX_TX_PRIO_NORMAL);
+        ptx_log_ring_consume(len);
+    }
 #endif
+    serial_service();
 }
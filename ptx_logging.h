@@ -1,13 +1,20 @@
 /**
  * @file ptx_logging.h
  * @brief PTX Logging library for Arduino projects
- * @details Provides formatted logging with timestamp, filename and line number
+ * @details Provides formatted logging with timestamp, filename and line number.
+ *          Format strings and file names stay in flash (PTX_PSTR) on AVR, so
+ *          they take no SRAM; the format argument of ptx_logf*() is a
+ *          PROGMEM pointer there and must be a string literal in the macros.
+ *          Log calls never block: complete lines go through the serial TX
+ *          queue (ptx_serial_tx.h). Lines starting with [ERROR or [WARN are
+ *          queued at high priority.
  */
 
 #ifndef PTX_LOGGING_H
 #define PTX_LOGGING_H
 
 #include <Arduino.h>
+#include "ptx_progmem.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -16,23 +23,127 @@ extern "C" {
 #define DEBUG_EN 0      //1: Enable debug log and otherwise
 
 /**
- * @brief Log macro with automatic file and line detection
- * @param msg Message string to debug log
+ * @brief Log levels, most verbose first
+ */
+#define PTX_LOG_LEVEL_TRACE     0
+#define PTX_LOG_LEVEL_DEBUG     1
+#define PTX_LOG_LEVEL_INFO      2
+#define PTX_LOG_LEVEL_WARN      3
+#define PTX_LOG_LEVEL_ERROR     4
+#define PTX_LOG_LEVEL_NONE      5
+
+/**
+ * @brief Project-wide threshold: calls below it are compiled out
+ */
+#ifndef PTX_LOG_LEVEL
+#if DEBUG_EN
+#define PTX_LOG_LEVEL PTX_LOG_LEVEL_DEBUG
+#else
+#define PTX_LOG_LEVEL PTX_LOG_LEVEL_INFO
+#endif
+#endif
+
+/**
+ * @brief Per-module threshold
+ * @details A source file may lower or raise its own threshold by defining
+ *          PTX_LOG_MODULE_LEVEL before its first #include. The check is done
+ *          by the preprocessor, so a disabled call expands to ((void)0): no
+ *          call, no format string, no argument evaluation.
+ */
+#ifndef PTX_LOG_MODULE_LEVEL
+#define PTX_LOG_MODULE_LEVEL PTX_LOG_LEVEL
+#endif
+
+/**
+ * @brief Deferred binary logging
+ * @details 0: log calls format text and print it immediately.
+ *          1: log calls only copy a binary record (file id, line, timestamp,
+ *          raw arguments) into a RAM ring buffer; ptx_log_drain() sends it to
+ *          Serial at idle time and tools/ptx_log_decode.py restores the text.
+ *          Arguments are stored as 32-bit integers or short strings.
  */
-#define PTX_DBG_LOGF(format, ...) ptx_dbg_logf(__FILE__, __LINE__, format, ##__VA_ARGS__)
+#ifndef PTX_LOG_DEFERRED
+#define PTX_LOG_DEFERRED 0
+#endif
+
+#if PTX_LOG_DEFERRED
+
+/* Priorities follow the text mode; those of literal formats are resolved at compile time */
+#define PTX_LOG(msg) ptx_log_deferred(PTX_LOG_FILE_ID, __LINE__, ptx_log_classify(msg, PTX_TX_PRIO_NORMAL), msg)
+#define PTX_LOGF(format, ...) ptx_log_deferred(PTX_LOG_FILE_ID, __LINE__, \
+        ptx_log_constant<ptx_tx_prio_t, ptx_log_classify(format, PTX_TX_PRIO_NORMAL)>::value, ##__VA_ARGS__)
+#define PTX_LOGF_PERIODIC(format, ...) ptx_log_deferred(PTX_LOG_FILE_ID, __LINE__, PTX_TX_PRIO_LOW, ##__VA_ARGS__)
+#define PTX_LOG_AT(level, format, ...) ptx_log_deferred(PTX_LOG_FILE_ID, __LINE__, \
+        ptx_log_constant<ptx_tx_prio_t, ptx_log_level_prio(level, format)>::value, ##__VA_ARGS__)
+
+#else
 
 /**
  * @brief Log macro with automatic file and line detection
- * @param msg Message string to log
+ * @param msg Message string to log (SRAM; may be a runtime string)
  */
-#define PTX_LOG(msg) ptx_log(__FILE__, __LINE__, msg)
+#define PTX_LOG(msg) ptx_log(PTX_LOG_FILENAME, __LINE__, msg)
 
 /**
  * @brief Log macro with printf-style formatting
  * @param format Printf-style format string
  * @param ... Variable arguments for formatting
  */
-#define PTX_LOGF(format, ...) ptx_logf(__FILE__, __LINE__, format, ##__VA_ARGS__)
+#define PTX_LOGF(format, ...) ptx_logf(PTX_LOG_FILENAME, __LINE__, PTX_PSTR(format), ##__VA_ARGS__)
+
+/**
+ * @brief Log macro for periodic status lines
+ * @details Queued at low priority: dropped first when the serial link falls behind
+ */
+#define PTX_LOGF_PERIODIC(format, ...) ptx_logf_periodic(PTX_LOG_FILENAME, __LINE__, PTX_PSTR(format), ##__VA_ARGS__)
+
+/**
+ * @brief Unconditional leveled log; use the PTX_LOG_<LEVEL> macros instead
+ */
+#define PTX_LOG_AT(level, format, ...) ptx_logf_level(PTX_LOG_FILENAME, __LINE__, level, PTX_PSTR(format), ##__VA_ARGS__)
+
+#endif /* PTX_LOG_DEFERRED */
+
+/**
+ * @brief Leveled log macros with printf-style formatting
+ * @details Compiled out when the level is below PTX_LOG_MODULE_LEVEL.
+ *          Arguments of a disabled call are not evaluated, so they must not
+ *          have side effects.
+ */
+#if PTX_LOG_MODULE_LEVEL <= PTX_LOG_LEVEL_TRACE
+#define PTX_LOG_TRACE(format, ...) PTX_LOG_AT(PTX_LOG_LEVEL_TRACE, format, ##__VA_ARGS__)
+#else
+#define PTX_LOG_TRACE(format, ...) ((void)0)
+#endif
+
+#if PTX_LOG_MODULE_LEVEL <= PTX_LOG_LEVEL_DEBUG
+#define PTX_LOG_DEBUG(format, ...) PTX_LOG_AT(PTX_LOG_LEVEL_DEBUG, format, ##__VA_ARGS__)
+#else
+#define PTX_LOG_DEBUG(format, ...) ((void)0)
+#endif
+
+#if PTX_LOG_MODULE_LEVEL <= PTX_LOG_LEVEL_INFO
+#define PTX_LOG_INFO(format, ...) PTX_LOG_AT(PTX_LOG_LEVEL_INFO, format, ##__VA_ARGS__)
+#else
+#define PTX_LOG_INFO(format, ...) ((void)0)
+#endif
+
+#if PTX_LOG_MODULE_LEVEL <= PTX_LOG_LEVEL_WARN
+#define PTX_LOG_WARN(format, ...) PTX_LOG_AT(PTX_LOG_LEVEL_WARN, format, ##__VA_ARGS__)
+#else
+#define PTX_LOG_WARN(format, ...) ((void)0)
+#endif
+
+#if PTX_LOG_MODULE_LEVEL <= PTX_LOG_LEVEL_ERROR
+#define PTX_LOG_ERROR(format, ...) PTX_LOG_AT(PTX_LOG_LEVEL_ERROR, format, ##__VA_ARGS__)
+#else
+#define PTX_LOG_ERROR(format, ...) ((void)0)
+#endif
+
+/**
+ * @brief Debug log macro (same as PTX_LOG_DEBUG)
+ */
+#define PTX_DBG_LOGF(format, ...) PTX_LOG_DEBUG(format, ##__VA_ARGS__)
 
 /**
  * @brief Initialize logging system
@@ -52,23 +163,153 @@ void ptx_log(const char* file, int line, const char* msg);
  * @brief Formatted logging function
  * @param file Source file name (automatically provided by macro)
  * @param line Line number (automatically provided by macro)
- * @param format Printf-style format string
+ * @param format Printf-style format string (PROGMEM on AVR)
  * @param ... Variable arguments for formatting
  */
 void ptx_logf(const char* file, int line, const char* format, ...);
 
+/**
+ * @brief Formatted logging at low TX priority (periodic status)
+ * @param file Source file name (automatically provided by macro)
+ * @param line Line number (automatically provided by macro)
+ * @param format Printf-style format string (PROGMEM on AVR)
+ * @param ... Variable arguments for formatting
+ */
+void ptx_logf_periodic(const char* file, int line, const char* format, ...);
 
-void ptx_dbg_logf(const char* file, int line, const char* format, ...);
+/**
+ * @brief Formatted logging at a given level
+ * @param file Source file name (automatically provided by macro)
+ * @param line Line number (automatically provided by macro)
+ * @param level PTX_LOG_LEVEL_xxx; selects the TX priority
+ *              (TRACE/DEBUG low, INFO normal, WARN/ERROR high)
+ * @param format Printf-style format string (PROGMEM on AVR)
+ * @param ... Variable arguments for formatting
+ */
+void ptx_logf_level(const char* file, int line, uint8_t level, const char* format, ...);
+
+/**
+ * @brief Flush pending log output to Serial without blocking
+ * @details Moves deferred-log records into the serial TX queue (deferred mode),
+ *          then calls serial_service() to write what the hardware TX buffer
+ *          can take right now. The rest waits for the next call.
+ * @note Call from the main loop when the control work is done
+ */
+void ptx_log_drain(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef __cplusplus
+#include "ptx_log_ring.h"
+#include "ptx_serial_tx.h"
+
+constexpr const char* ptx_log_basename(const char* p, const char* base) {
+    return (*p == '\0') ? base : ptx_log_basename(p + 1, ((*p == '/') || (*p == '\\')) ? p + 1 : base);
+}
 
 /**
  * @brief Extract filename from full path
  * @param path Full file path
  * @return Pointer to filename portion
  */
-const char* ptx_get_filename(const char* path);
+constexpr const char* ptx_get_filename(const char* path) {
+    return ptx_log_basename(path, path);
+}
 
-#ifdef __cplusplus
+constexpr size_t ptx_log_strlen(const char* s) {
+    return (*s == '\0') ? 0U : 1U + ptx_log_strlen(s + 1);
 }
-#endif
+
+/* Basename as its own PROGMEM char array: the full __FILE__ path never reaches flash */
+template <char... C> struct ptx_log_chars {
+    static constexpr char value[sizeof...(C) + 1U] PTX_PROGMEM = { C..., '\0' };
+};
+template <char... C> constexpr char ptx_log_chars<C...>::value[sizeof...(C) + 1U] PTX_PROGMEM;
+
+template <size_t... I> struct ptx_log_seq {};
+template <size_t N, size_t... I> struct ptx_log_make_seq : ptx_log_make_seq<N - 1U, N - 1U, I...> {};
+template <size_t... I> struct ptx_log_make_seq<0U, I...> { typedef ptx_log_seq<I...> type; };
+
+template <typename F, typename Seq> struct ptx_log_name_of;
+template <typename F, size_t... I> struct ptx_log_name_of<F, ptx_log_seq<I...> > {
+    typedef ptx_log_chars<ptx_get_filename(F::path())[I]...> type;
+};
+
+/* F::path() returns __FILE__; the same basename shares one array per program */
+template <typename F> inline const char* ptx_log_name() {
+    return ptx_log_name_of<F, typename ptx_log_make_seq<ptx_log_strlen(ptx_get_filename(F::path()))>::type>::type::value;
+}
+
+#define PTX_LOG_FILENAME ([]() -> const char* { \
+        struct ptx_log_file { static constexpr const char* path() { return __FILE__; } }; \
+        return ptx_log_name<ptx_log_file>(); }())
+
+/* Compile-time file id: FNV-1a of the basename of __FILE__, folded to 16 bits */
+
+constexpr uint32_t ptx_log_fnv1a(const char* s, uint32_t h) {
+    return (*s == '\0') ? h : ptx_log_fnv1a(s + 1, (uint32_t)((h ^ (uint8_t)*s) * 16777619UL));
+}
+
+constexpr uint16_t ptx_log_fold16(uint32_t h) {
+    return (uint16_t)((h >> 16) ^ (h & 0xFFFFUL));
+}
+
+constexpr uint16_t ptx_log_file_id(const char* path) {
+    return ptx_log_fold16(ptx_log_fnv1a(ptx_log_basename(path, path), 2166136261UL));
+}
+
+template <typename T, T V> struct ptx_log_constant { static constexpr T value = V; };
+
+/* Forces the id to be computed by the compiler, not at run time */
+#define PTX_LOG_FILE_ID (ptx_log_constant<uint16_t, ptx_log_file_id(__FILE__)>::value)
+
+/* TX priority of a message, as in text mode: lines starting with [ERROR or [WARN are high */
+
+constexpr bool ptx_log_starts_with(const char* s, const char* prefix) {
+    return (*prefix == '\0') || ((*s == *prefix) && ptx_log_starts_with(s + 1, prefix + 1));
+}
+
+constexpr ptx_tx_prio_t ptx_log_classify(const char* msg, ptx_tx_prio_t prio) {
+    return (ptx_log_starts_with(msg, "[ERROR") || ptx_log_starts_with(msg, "[WARN")) ? PTX_TX_PRIO_HIGH : prio;
+}
+
+/* Same mapping as ptx_logf_level(): TRACE/DEBUG low, INFO normal, WARN/ERROR high */
+constexpr ptx_tx_prio_t ptx_log_level_prio(uint8_t level, const char* format) {
+    return (level <= PTX_LOG_LEVEL_DEBUG) ? PTX_TX_PRIO_LOW
+         : (level >= PTX_LOG_LEVEL_WARN) ? PTX_TX_PRIO_HIGH
+         : ptx_log_classify(format, PTX_TX_PRIO_NORMAL);
+}
+
+/* Argument encoders: strings are copied, everything else is stored as int32 */
+inline void ptx_log_put(ptx_log_record_t* rec, const char* str) { ptx_log_record_put_str(rec, str); }
+inline void ptx_log_put(ptx_log_record_t* rec, char* str) { ptx_log_record_put_str(rec, str); }
+template <typename T>
+inline void ptx_log_put(ptx_log_record_t* rec, T value) { ptx_log_record_put_int(rec, (int32_t)value); }
+
+inline void ptx_log_put_all(ptx_log_record_t*) {}
+template <typename T, typename... Rest>
+inline void ptx_log_put_all(ptx_log_record_t* rec, T first, Rest... rest) {
+    ptx_log_put(rec, first);
+    ptx_log_put_all(rec, rest...);
+}
+
+/**
+ * @brief Deferred log call: encode a binary record into the log ring
+ * @param file_id PTX_LOG_FILE_ID of the calling file
+ * @param line Line of the log call
+ * @param prio Priority of the record in the log ring
+ * @param args Raw format arguments
+ */
+template <typename... Args>
+inline void ptx_log_deferred(uint16_t file_id, uint16_t line, ptx_tx_prio_t prio, Args... args) {
+    ptx_log_record_t rec;
+    ptx_log_record_begin(&rec, (uint32_t)millis(), file_id, line);
+    ptx_log_put_all(&rec, args...);
+    ptx_log_record_end(&rec);
+    ptx_log_ring_write(rec.buf, rec.len, prio);
+}
+#endif /* __cplusplus */
 
 #endif // PTX_LOGGING_H
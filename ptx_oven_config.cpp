@@ -3,117 +3,261 @@
  * @brief Implementation of runtime-configurable oven parameters
  */
 #include "ptx_oven_config.h"
+#include "ptx_calibration.h"
+#include "ptx_critical.h"
+#include "ptx_temperature.h"
 #include <stddef.h>
 
-/* Internal configuration state */
-static ptx_oven_config_t pti_oven_config = {
-    .ignition_duration_ms   = 5000U,  	/* 5 seconds igniter ON */
-    .periodic_log_ms        = 1000U,  	/* log every second */
-    .sensor_fault_window_ms = 1000U,  	/* fault after 1s out-of-range */
-    .auto_resume_delay_ms   = 3000U,  	/* resume after 3s valid */
-    .vref_min_v             = 4.5f,   	/* min vref */
-    .vref_max_v             = 5.5f,   	/* max vref */
-    .temp_target_c          = 180.0f, 	/* target temperature */
-    .temp_delta_c           = 5.0f,   	/* hysteresis half-band */
-    .max_ignition_attempts  = 3U,     	/* 3 ignition retry attempts */
-	  .iteration_period        = 100U,		/* 100ms */
-};
+/* The one set of defaults: boot, ptx_oven_reset_config_to_defaults() and a blank EEPROM */
+#define PTI_CONFIG_DEFAULTS {                                               \
+    .ignition_duration_ms   = 5000U,    /* 5 seconds igniter ON */          \
+    .periodic_log_ms        = 1000U,    /* log every second */              \
+    .sensor_fault_window_ms = 1000U,    /* fault after 1s out-of-range */   \
+    .auto_resume_delay_ms   = 3000U,    /* resume after 3s valid */         \
+    .vref_min_v             = 4.5f,     /* min vref */                      \
+    .vref_max_v             = 5.5f,     /* max vref */                      \
+    .temp_target_c          = 180.0f,   /* target temperature */            \
+    .temp_delta_c           = 2.0f,     /* hysteresis half-band */          \
+    .max_ignition_attempts  = 3U,       /* 3 ignition retry attempts */     \
+    .probe_profile          = PTX_CAL_DEFAULT_PROFILE,  /* probe calibration */ \
+    .iteration_period       = 100U,     /* 100ms */                         \
+}
+
+static const ptx_oven_config_t pti_config_defaults = PTI_CONFIG_DEFAULTS;
+
+/* Internal configuration state: the active buffer is pti_config_buf[generation & 1] */
+static ptx_oven_config_t pti_config_buf[2] = { PTI_CONFIG_DEFAULTS };
+
+/* Bumped on every publish so consumers can refresh values derived from the config */
+static uint16_t pti_config_revision = 0;
+
+#define PTI_LOAD_ACQUIRE(p)         __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define PTI_LOAD_RELAXED(p)         __atomic_load_n((p), __ATOMIC_RELAXED)
+#define PTI_STORE_RELEASE(p, v)     __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+// Whole generation: a 16-bit load takes two instructions on AVR
+static uint16_t pti_generation(void) {
+    ptx_irq_state_t irq = ptx_irq_save();
+    uint16_t generation = PTI_LOAD_ACQUIRE(&pti_config_revision);
+    ptx_irq_restore(irq);
+    return generation;
+}
+
+// Only the low bit of the generation matters: no critical section
+static const ptx_oven_config_t* pti_active(void) {
+    return &pti_config_buf[PTI_LOAD_ACQUIRE(&pti_config_revision) & 1U];
+}
+
+// Inactive buffer, to write the next configuration into (writer side)
+static ptx_oven_config_t* pti_staging(void) {
+    uint16_t generation = PTI_LOAD_RELAXED(&pti_config_revision);
+
+    /* A snapshot of the previous generation may still be copying this buffer:
+       order the publish it will see before the writes */
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    return &pti_config_buf[(generation + 1U) & 1U];
+}
+
+// Inactive buffer, loaded with the active configuration
+static ptx_oven_config_t* pti_stage(void) {
+    ptx_oven_config_t* next = pti_staging();
+    *next = pti_config_buf[PTI_LOAD_RELAXED(&pti_config_revision) & 1U];
+    return next;
+}
+
+// Make the staged buffer active if it is valid
+static bool pti_publish(void) {
+    uint16_t generation = PTI_LOAD_RELAXED(&pti_config_revision);
+    if (ptx_oven_config_validate(&pti_config_buf[(generation + 1U) & 1U]) != PTX_CONFIG_OK) {
+        return false;
+    }
+
+    ptx_irq_state_t irq = ptx_irq_save();
+    PTI_STORE_RELEASE(&pti_config_revision, (uint16_t)(generation + 1U));
+    ptx_irq_restore(irq);
+    return true;
+}
+
+int32_t ptx_oven_round_milli(float value) {
+    return (int32_t)(value * 1000.0f + ((value < 0.0f) ? -0.5f : 0.5f));
+}
+
+void ptx_oven_config_thresholds(const ptx_oven_config_t* config, ptx_oven_thresholds_t* out) {
+    out->vref_min_mv = (uint16_t)ptx_oven_round_milli(config->vref_min_v);
+    out->vref_max_mv = (uint16_t)ptx_oven_round_milli(config->vref_max_v);
+    out->temp_on_mc  = ptx_oven_round_milli(config->temp_target_c - config->temp_delta_c);
+    out->temp_off_mc = ptx_oven_round_milli(config->temp_target_c + config->temp_delta_c);
+
+    /* The same hysteresis as signal/vref ratios: no table lookup needed to decide */
+    const ptx_cal_table_t* cal = ptx_cal_get_table(config->probe_profile);
+    out->on_ratio_q32  = ptx_cal_ratio_above_q32(cal, out->temp_on_mc);
+    out->off_ratio_q32 = ptx_cal_ratio_above_q32(cal, out->temp_off_mc - 1);
+}
+
+ptx_oven_config_error_t ptx_oven_config_validate(const ptx_oven_config_t* config) {
+    if (config == NULL) {
+        return PTX_CONFIG_ERR_NULL;
+    }
+    if ((config->ignition_duration_ms == 0U) || (config->periodic_log_ms == 0U) ||
+        (config->iteration_period == 0U)) {
+        return PTX_CONFIG_ERR_TIMING;
+    }
+    /* Written so that NaN fails every check */
+    if (!(config->vref_min_v > 0.0f) || !(config->vref_min_v < config->vref_max_v) ||
+        !(config->vref_max_v <= PTX_CONFIG_VREF_LIMIT_V)) {
+        return PTX_CONFIG_ERR_VREF_RANGE;
+    }
+    if (!(config->temp_delta_c > 0.0f) ||
+        !(config->temp_target_c - config->temp_delta_c > PTX_TEMP_MIN_C) ||
+        !(config->temp_target_c + config->temp_delta_c < PTX_TEMP_MAX_C)) {
+        return PTX_CONFIG_ERR_TEMPERATURE;
+    }
+    if ((config->max_ignition_attempts == 0U) ||
+        (config->max_ignition_attempts > PTX_CONFIG_MAX_IGNITION_ATTEMPTS)) {
+        return PTX_CONFIG_ERR_IGNITION_ATTEMPTS;
+    }
+    if (config->probe_profile >= PTX_CAL_PROFILE_COUNT) {
+        return PTX_CONFIG_ERR_PROBE_PROFILE;
+    }
+    return PTX_CONFIG_OK;
+}
 
 const ptx_oven_config_t* ptx_oven_get_config(void) {
-    return &pti_oven_config;
+    return pti_active();
+}
+
+uint16_t ptx_oven_config_snapshot(ptx_oven_config_t* out) {
+    uint16_t generation = pti_generation();
+    for (;;) {
+        *out = pti_config_buf[generation & 1U];
+
+        /* Unchanged generation: the writer never staged into this buffer meanwhile */
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        uint16_t again = pti_generation();
+        if (again == generation) {
+            return generation;
+        }
+        generation = again;
+    }
 }
 
-void ptx_oven_set_config(const ptx_oven_config_t* config) {
-    if (config != NULL) {
-        pti_oven_config = *config;
+bool ptx_oven_set_config(const ptx_oven_config_t* config) {
+    if (config == NULL) {
+        return false;
     }
+    *pti_staging() = *config;
+    return pti_publish();
 }
 
 void ptx_oven_reset_config_to_defaults(void) {
-    pti_oven_config.ignition_duration_ms   	= 5000U;
-    pti_oven_config.periodic_log_ms        	= 1000U;
-    pti_oven_config.sensor_fault_window_ms 	= 1000U;
-    pti_oven_config.auto_resume_delay_ms   	= 3000U;
-    pti_oven_config.vref_min_v             	= 4.5f;
-    pti_oven_config.vref_max_v             	= 5.5f;
-    pti_oven_config.temp_target_c          	= 180.0f;
-    pti_oven_config.temp_delta_c           	= 2.0f;
-    pti_oven_config.max_ignition_attempts  	= 3U;
-    pti_oven_config.iteration_period        = 100U;
+    *pti_staging() = pti_config_defaults;
+    (void)pti_publish();
+}
+
+const ptx_oven_config_t* ptx_oven_get_config_defaults(void) {
+    return &pti_config_defaults;
+}
+
+uint16_t ptx_oven_get_config_revision(void) {
+    return pti_generation();
 }
 
 /* Individual parameter setters */
-void ptx_oven_set_ignition_duration_ms(uint32_t duration_ms) {
-    pti_oven_config.ignition_duration_ms = duration_ms;
+bool ptx_oven_set_ignition_duration_ms(uint32_t duration_ms) {
+    ptx_oven_config_t* next = pti_stage();
+    next->ignition_duration_ms = duration_ms;
+    return pti_publish();
 }
 
 uint32_t ptx_oven_get_ignition_duration_ms(void) {
-    return pti_oven_config.ignition_duration_ms;
+    return pti_active()->ignition_duration_ms;
 }
 
-void ptx_oven_set_periodic_log_ms(uint32_t interval_ms) {
-    pti_oven_config.periodic_log_ms = interval_ms;
+bool ptx_oven_set_periodic_log_ms(uint32_t interval_ms) {
+    ptx_oven_config_t* next = pti_stage();
+    next->periodic_log_ms = interval_ms;
+    return pti_publish();
 }
 
 uint32_t ptx_oven_get_periodic_log_ms(void) {
-    return pti_oven_config.periodic_log_ms;
+    return pti_active()->periodic_log_ms;
 }
 
-void ptx_oven_set_sensor_fault_window_ms(uint32_t window_ms) {
-    pti_oven_config.sensor_fault_window_ms = window_ms;
+bool ptx_oven_set_sensor_fault_window_ms(uint32_t window_ms) {
+    ptx_oven_config_t* next = pti_stage();
+    next->sensor_fault_window_ms = window_ms;
+    return pti_publish();
 }
 
 uint32_t ptx_oven_get_sensor_fault_window_ms(void) {
-    return pti_oven_config.sensor_fault_window_ms;
+    return pti_active()->sensor_fault_window_ms;
 }
 
-void ptx_oven_set_auto_resume_delay_ms(uint32_t delay_ms) {
-    pti_oven_config.auto_resume_delay_ms = delay_ms;
+bool ptx_oven_set_auto_resume_delay_ms(uint32_t delay_ms) {
+    ptx_oven_config_t* next = pti_stage();
+    next->auto_resume_delay_ms = delay_ms;
+    return pti_publish();
 }
 
 uint32_t ptx_oven_get_auto_resume_delay_ms(void) {
-    return pti_oven_config.auto_resume_delay_ms;
+    return pti_active()->auto_resume_delay_ms;
 }
 
-void ptx_oven_set_vref_range_v(float min_v, float max_v) {
-    pti_oven_config.vref_min_v = min_v;
-    pti_oven_config.vref_max_v = max_v;
+bool ptx_oven_set_vref_range_v(float min_v, float max_v) {
+    ptx_oven_config_t* next = pti_stage();
+    next->vref_min_v = min_v;
+    next->vref_max_v = max_v;
+    return pti_publish();
 }
 
 float ptx_oven_get_vref_min_v(void) {
-    return pti_oven_config.vref_min_v;
+    return pti_active()->vref_min_v;
 }
 
 float ptx_oven_get_vref_max_v(void) {
-    return pti_oven_config.vref_max_v;
+    return pti_active()->vref_max_v;
 }
 
-void ptx_oven_set_temp_target_c(float target_c) {
-    pti_oven_config.temp_target_c = target_c;
+bool ptx_oven_set_temp_target_c(float target_c) {
+    ptx_oven_config_t* next = pti_stage();
+    next->temp_target_c = target_c;
+    return pti_publish();
 }
 
 float ptx_oven_get_temp_target_c(void) {
-    return pti_oven_config.temp_target_c;
+    return pti_active()->temp_target_c;
 }
 
-void ptx_oven_set_temp_delta_c(float delta_c) {
-    pti_oven_config.temp_delta_c = delta_c;
+bool ptx_oven_set_temp_delta_c(float delta_c) {
+    ptx_oven_config_t* next = pti_stage();
+    next->temp_delta_c = delta_c;
+    return pti_publish();
 }
 
 float ptx_oven_get_temp_delta_c(void) {
-    return pti_oven_config.temp_delta_c;
+    return pti_active()->temp_delta_c;
 }
 
-void ptx_oven_set_max_ignition_attempts(uint8_t attempts) {
-    if (attempts > 0 && attempts <= 5) {
-        pti_oven_config.max_ignition_attempts = attempts;
-    }
+bool ptx_oven_set_max_ignition_attempts(uint8_t attempts) {
+    ptx_oven_config_t* next = pti_stage();
+    next->max_ignition_attempts = attempts;
+    return pti_publish();
 }
 
 uint8_t ptx_oven_get_max_ignition_attempts(void) {
-    return pti_oven_config.max_ignition_attempts;
+    return pti_active()->max_ignition_attempts;
+}
+
+bool ptx_oven_set_probe_profile(uint8_t profile) {
+    ptx_oven_config_t* next = pti_stage();
+    next->probe_profile = profile;
+    return pti_publish();
+}
+
+uint8_t ptx_oven_get_probe_profile(void) {
+    return pti_active()->probe_profile;
 }
 
 uint16_t ptx_oven_get_iteration_period(void) {
-    return pti_oven_config.iteration_period;
+    return pti_active()->iteration_period;
 }
\ No newline at end of file
@@ -3,6 +3,14 @@
  * @brief Configuration parameters for oven controller
  * @details Centralized timing, sensor thresholds, and safety parameters.
  *          All parameters are runtime-configurable via setter functions.
+ *
+ *          The process-wide configuration is double-buffered. A change is
+ *          written and validated in the inactive buffer, then published by
+ *          bumping a generation counter whose low bit selects the active
+ *          buffer: readers never see half of a change (new vref_min_v, old
+ *          vref_max_v), and a rejected change leaves the active configuration
+ *          untouched. One writer at a time (the main loop); readers that may
+ *          run while it writes take a ptx_oven_config_snapshot().
  */
 #ifndef PTX_OVEN_CONFIG_H
 #define PTX_OVEN_CONFIG_H
@@ -29,6 +37,9 @@ typedef struct {
     
     /* Ignition safety parameters */
     uint8_t  	max_ignition_attempts;   // Maximum number of ignition retry attempts (default: 3) 
+
+    /* Sensor calibration */
+    uint8_t     probe_profile;           // Probe calibration profile, ptx_cal_profile_t (default: nominal)
 	
 	/* Others */
 	uint16_t	iteration_period;		// 100ms	
@@ -36,42 +47,121 @@ typedef struct {
     
 } ptx_oven_config_t;
 
+/**
+ * @brief Why ptx_oven_config_validate() rejects a configuration
+ */
+typedef enum {
+    PTX_CONFIG_OK = 0,
+    PTX_CONFIG_ERR_NULL,                 // No configuration given
+    PTX_CONFIG_ERR_TIMING,               // Zero ignition, log or iteration period
+    PTX_CONFIG_ERR_VREF_RANGE,           // Not 0 < vref_min_v < vref_max_v <= PTX_CONFIG_VREF_LIMIT_V
+    PTX_CONFIG_ERR_TEMPERATURE,          // Band not strictly inside the probe range, or delta <= 0
+    PTX_CONFIG_ERR_IGNITION_ATTEMPTS,    // Not 1..PTX_CONFIG_MAX_IGNITION_ATTEMPTS
+    PTX_CONFIG_ERR_PROBE_PROFILE,        // Not a ptx_cal_profile_t
+} ptx_oven_config_error_t;
+
+#define PTX_CONFIG_VREF_LIMIT_V         8.0f    // vref_max_mv << PTX_OVERSAMPLE_MAX_BITS fits 16 bits
+#define PTX_CONFIG_MAX_IGNITION_ATTEMPTS 5U
+
+/**
+ * @brief Integer thresholds derived from a configuration
+ * @note Used by the integer pipelines; computed once per configuration change.
+ */
+typedef struct {
+    uint16_t vref_min_mv;                // vref_min_v, rounded to mV
+    uint16_t vref_max_mv;                // vref_max_v, rounded to mV
+    int32_t  temp_on_mc;                 // target - delta, rounded to m°C
+    int32_t  temp_off_mc;                // target + delta, rounded to m°C
+    uint32_t on_ratio_q32;               // signal/vref (Q0.32) from which temperature > temp_on_mc
+    uint32_t off_ratio_q32;              // signal/vref (Q0.32) from which temperature >= temp_off_mc
+} ptx_oven_thresholds_t;
+
+/**
+ * @brief Round a value in base units (V, °C) to the nearest milli-unit
+ * @note The one rounding of the integer thresholds, the stored configuration
+ *       (ptx_config_store.h) and the controller's threshold fallback, so they
+ *       always agree.
+ */
+int32_t ptx_oven_round_milli(float value);
+
+/**
+ * @brief Derive the integer thresholds of a configuration
+ * @param config Configuration
+ * @param out Thresholds, rounded to the nearest milli-unit; the ratios
+ *        through the calibration table of config->probe_profile
+ */
+void ptx_oven_config_thresholds(const ptx_oven_config_t* config, ptx_oven_thresholds_t* out);
+
+/**
+ * @brief Check a configuration before it is used
+ * @param config Configuration
+ * @return PTX_CONFIG_OK, or the first rule it breaks
+ */
+ptx_oven_config_error_t ptx_oven_config_validate(const ptx_oven_config_t* config);
+
 /**
  * @brief Get pointer to current configuration (read-only access)
- * @return Pointer to const configuration structure
+ * @return Pointer to the active buffer
+ * @note Consistent until the change after the next one starts; use
+ *       ptx_oven_config_snapshot() where a writer may run meanwhile.
  */
 const ptx_oven_config_t* ptx_oven_get_config(void);
 
 /**
- * @brief Update oven configuration with new parameters
+ * @brief Consistent copy of the current configuration
+ * @param out Copy
+ * @return Generation of the copy, as ptx_oven_get_config_revision()
+ * @note Retries if a change was published while copying.
+ */
+uint16_t ptx_oven_config_snapshot(ptx_oven_config_t* out);
+
+/**
+ * @brief Validate, then publish a whole configuration at once
  * @param config Pointer to new configuration structure
- * @note Changes take effect immediately on next control update
+ * @return false if it is NULL or fails ptx_oven_config_validate(); the
+ *         current configuration is kept
+ * @note Changes take effect on the next control update
  */
-void ptx_oven_set_config(const ptx_oven_config_t* config);
+bool ptx_oven_set_config(const ptx_oven_config_t* config);
 
 /**
  * @brief Reset configuration to default values
  */
 void ptx_oven_reset_config_to_defaults(void);
 
+/**
+ * @brief Default configuration, the one the controller boots with
+ */
+const ptx_oven_config_t* ptx_oven_get_config_defaults(void);
+
+/**
+ * @brief Configuration generation
+ * @return Value that changes whenever a change is published
+ * @note Lets consumers cache values derived from the configuration and
+ *       refresh them only when it moves.
+ */
+uint16_t ptx_oven_get_config_revision(void);
 
-void ptx_oven_set_ignition_duration_ms(uint32_t duration_ms);
+/* Setters publish one parameter, validated like ptx_oven_set_config() */
+bool ptx_oven_set_ignition_duration_ms(uint32_t duration_ms);
 uint32_t ptx_oven_get_ignition_duration_ms(void);
-void ptx_oven_set_periodic_log_ms(uint32_t interval_ms);
+bool ptx_oven_set_periodic_log_ms(uint32_t interval_ms);
 uint32_t ptx_oven_get_periodic_log_ms(void);
-void ptx_oven_set_sensor_fault_window_ms(uint32_t window_ms);
+bool ptx_oven_set_sensor_fault_window_ms(uint32_t window_ms);
 uint32_t ptx_oven_get_sensor_fault_window_ms(void);
-void ptx_oven_set_auto_resume_delay_ms(uint32_t delay_ms);
+bool ptx_oven_set_auto_resume_delay_ms(uint32_t delay_ms);
 uint32_t ptx_oven_get_auto_resume_delay_ms(void);
-void ptx_oven_set_vref_range_v(float min_v, float max_v);
+bool ptx_oven_set_vref_range_v(float min_v, float max_v);
 float ptx_oven_get_vref_min_v(void);
 float ptx_oven_get_vref_max_v(void);
-void ptx_oven_set_temp_target_c(float target_c);
+bool ptx_oven_set_temp_target_c(float target_c);
 float ptx_oven_get_temp_target_c(void);
-void ptx_oven_set_temp_delta_c(float delta_c);
+bool ptx_oven_set_temp_delta_c(float delta_c);
 float ptx_oven_get_temp_delta_c(void);
-void ptx_oven_set_max_ignition_attempts(uint8_t attempts);
+bool ptx_oven_set_max_ignition_attempts(uint8_t attempts);
 uint8_t ptx_oven_get_max_ignition_attempts(void);
+bool ptx_oven_set_probe_profile(uint8_t profile);
+uint8_t ptx_oven_get_probe_profile(void);
 uint16_t ptx_oven_get_iteration_period(void);
 
 
@@ -11,207 +11,323 @@
 #include "ptx_oven_config.h"
 #include "ptx_sensor_filter.h"
 #include "ptx_actuator.h"
+#include "ptx_critical.h"
+#include "ptx_temperature.h"
 #include "api.h"
 #include "ptx_logging.h"
+#include "ptx_profile.h"
+#include "ptx_event_queue.h"
+#include "ptx_io.h"
+#include "ptx_adc_sampler.h"
+#include <string.h>
 
-/* Feature flags */
-#ifndef PTX_FLAME_DETECT_ENABLED
-#define PTX_FLAME_DETECT_ENABLED 0  /* Disable flame detection by default (assume ignition success) */
-#endif
+#define PROFILE_SUMMARY_EVERY 10   // Stage timing summary every N periodic logs
 
 #define FAST_BLINK_MS 500    // quick blink when system fault
 #define SLOW_BLINK_MS 3000   // slow blink when system normal
 
-/* Internal state */
-static ptx_oven_status_t pti_status;
-static uint32_t pti_ignition_start_ms = 0;
-static uint32_t pti_last_log_ms = 0;
-static uint32_t pti_last_sys_led_status_ms = 0;
-
-/* Timed sensor fault management */
-static uint32_t pti_out_of_range_since_ms = 0;   /* 0 means not currently out of range */
-static uint32_t pti_valid_since_ms = 0;          /* 0 means not in continuous valid window */
+/* Module-level instance behind the single-oven API */
+static ptx_oven_ctx_t pti_oven;
+static uint16_t pti_oven_global_revision = 0;   /* Process-wide config revision last copied */
+#if PTX_ADC_SAMPLER_ENABLED
+static uint16_t pti_adc_dropped_logged = 0;     /* Sampler drop count already reported */
+#endif
 
-/* Ignition retry management */
-static uint8_t pti_ignition_attempt = 0;         /* Current attempt number (0 = not started) */
-static uint32_t pti_purge_start_ms = 0;          /* Start time of purge phase */
-static float pti_temp_at_ignition_start = 0.0f;  /* Temperature when ignition started (for flame detection) */
+#if PTX_TRACE_ENABLED
+static ptx_trace_sink_fn pti_trace_sink = NULL;
+static void* pti_trace_user = NULL;
+static ptx_trace_record_t pti_trace_rec;        /* UPDATE record being filled */
+
+// Emit one record to the trace sink
+static void ptx_trace_emit(uint8_t kind, uint32_t time, uint8_t flags) {
+    pti_trace_rec.kind = kind;
+    pti_trace_rec.time = time;
+    pti_trace_rec.flags = flags;
+    pti_trace_rec.reserved = 0;
+    if (kind != PTX_TRACE_UPDATE) {
+        pti_trace_rec.vref_mv_q = 0;
+        pti_trace_rec.signal_mv_q = 0;
+    }
+    pti_trace_sink(pti_trace_user, &pti_trace_rec);
+}
+#endif
 
 /* Local function */
-static void dummytest_statemachine();                   /* Dummy test for real hardware */
+static void dummytest_statemachine(ptx_oven_ctx_t* ctx);   /* Dummy test for real hardware */
 
 // Set door status
-static bool ptx_read_door_open(void) {
-    return pti_status.door_open;
+static bool ptx_read_door_open(const ptx_oven_ctx_t* ctx) {
+    return ctx->door_open_level;
+}
+
+// Drain interrupt events: logging and statistics happen here, not in the ISR
+static void ptx_process_events(ptx_oven_ctx_t* ctx) {
+    ptx_event_t ev;
+
+    while (ptx_event_pop(&ev)) {
+        if (ev.type != PTX_EVENT_DOOR) continue;
+#if PTX_TRACE_ENABLED
+        if (pti_trace_sink != NULL) {
+            ptx_trace_emit(PTX_TRACE_DOOR, ev.time_us, (ev.value != 0U) ? PTX_TRACE_DOOR_OPEN : 0U);
+        }
+#endif
+
+        if (ev.value != 0U) {
+            uint32_t latency_us = ev.ack_us - ev.time_us;
+            ptx_hist_add(&ctx->door_latency, latency_us);
+            PTX_LOG_WARN("[WARNING] Door is opened, gas off after %luus", (unsigned long)latency_us);
+        } else {
+            PTX_LOG_INFO("Door is closed");
+        }
+    }
+}
+
+#if PTX_FIXED_POINT
+// Refresh integer thresholds; float math only runs after a configuration change
+static void ptx_refresh_fx_thresholds(ptx_oven_ctx_t* ctx) {
+    uint16_t revision = ctx->config_revision;
+    if (ctx->fx.loaded && (ctx->fx.revision == revision)) return;
+
+    ptx_oven_config_thresholds(&ctx->config, &ctx->fx.th);
+    ctx->fx.cal = ptx_cal_get_table(ctx->config.probe_profile);
+    ctx->fx.revision = revision;
+    ctx->fx.loaded = true;
+}
+#endif
+
+// Whole degrees of the current temperature, for logging
+static int ptx_temperature_whole_c(const ptx_oven_ctx_t* ctx) {
+#if PTX_FIXED_POINT
+    return (int)(ctx->status.temperature_mc / 1000);
+#else
+    return (int)ctx->status.temperature_c;
+#endif
 }
 
 // Check sensor out of range
-static void ptx_eval_sensor_faults_with_timing(uint32_t now_ms, float vref_mv, float signal_mv) {
-	const ptx_oven_config_t* cfg = ptx_oven_get_config();
-		
+static void ptx_eval_sensor_faults_with_timing(ptx_oven_ctx_t* ctx, uint32_t now_ms, const ptx_sensor_reading_t* in) {
+    uint16_t vref_mv = in->vref_mv;
+
 	/* Update instantaneous readings */
-    pti_status.vref_volts   = vref_mv / 1000.0f;
-    pti_status.signal_volts = signal_mv / 1000.0f;
+    ctx->status.vref_mv   = vref_mv;
+    ctx->status.signal_mv = in->signal_mv;
+
+    /* Instantaneous violations (not latched); the signal window is a ratio, checked at full resolution */
+#if PTX_FIXED_POINT
+    bool vref_bad = (vref_mv < ctx->fx.th.vref_min_mv) || (vref_mv > ctx->fx.th.vref_max_mv);
+    bool signal_bad = !ptx_temp_signal_in_range(in->vref_mv_q, in->signal_mv_q);
+#else
+	const ptx_oven_config_t* cfg = &ctx->config;
 
-    /* Instantaneous violations (not latched) */
-    bool vref_bad = (pti_status.vref_volts < cfg->vref_min_v) || (pti_status.vref_volts > cfg->vref_max_v);
+    ctx->status.vref_volts   = vref_mv / 1000.0f;
+    ctx->status.signal_volts = in->signal_mv / 1000.0f;
 
-    float lo = 0.10f * vref_mv;
-    float hi = 0.90f * vref_mv;
-    bool signal_bad = (signal_mv < lo) || (signal_mv > hi);
+    bool vref_bad = (ctx->status.vref_volts < cfg->vref_min_v) || (ctx->status.vref_volts > cfg->vref_max_v);
+
+    float lo = 0.10f * in->vref_mv_q;
+    float hi = 0.90f * in->vref_mv_q;
+    bool signal_bad = (in->signal_mv_q < lo) || (in->signal_mv_q > hi);
+#endif
 
-    pti_status.vref_fault = vref_bad;        /* expose instantaneous state */
-    pti_status.signal_fault = signal_bad;
+    ctx->status.vref_fault = vref_bad;        /* expose instantaneous state */
+    ctx->status.signal_fault = signal_bad;
 
     bool out_of_range = vref_bad || signal_bad;
 
     /* Handle an exception */
     if (out_of_range) {
-		pti_status.sensor_fault = true;
-        PTX_LOGF("[ERROR] Sensor fault error");
+		ctx->status.sensor_fault = true;
+        PTX_LOG_ERROR("[ERROR] Sensor fault error");
 
     } else {
         /* Readings are valid; clear out-of-range window */
-		pti_status.sensor_fault = false; /* clear latched fault */
-		pti_valid_since_ms = 0;
+		ctx->status.sensor_fault = false; /* clear latched fault */
+		ctx->valid_since_ms = 0;
 		//PTX_LOGF("sensor fault cleared");
     }
 	
 }
 
 // Calculate a temperature from vref and signal
-static float ptx_compute_temperature(float vref_mv, float signal_mv) {
+// Inputs in mV << PTX_OVERSAMPLE_BITS: only their ratio matters
+static void ptx_compute_temperature(ptx_oven_ctx_t* ctx, uint16_t vref_mv_q, uint16_t signal_mv_q) {
 
     // @Debug purpose
-    PTX_DBG_LOGF("ptx_compute_temperature[begin]: vref=%dmV signal=%dmV", (int)vref_mv, (int)signal_mv);
+    PTX_LOG_DEBUG("ptx_compute_temperature[begin]: vref=%d signal=%d (mV<<%d)", (int)vref_mv_q, (int)signal_mv_q,
+                  (int)PTX_OVERSAMPLE_BITS);
 
-	/* Linear map -10C at 10% vref to 300C at 90% vref (span 310C over 0.8*vref). */
-    float low = 0.10f * vref_mv;
-    float high = 0.90f * vref_mv;
-    float temperature;
-
-    /* Handle exception */
-    if (signal_mv <= low) return -10.0f;
-    if (signal_mv >= high) 
-    {
-        PTX_DBG_LOGF("[ERROR]Over temperature !!!");
-        return 300.0f;
-    }
-#if 0
-    temperature = -10.0f + ((signal_mv - low) / (0.80f * vref_mv)) * 310.0f;
+#if PTX_FIXED_POINT
+    const ptx_cal_table_t* cal = ctx->fx.cal;
+    ctx->ratio_q32 = ptx_temp_ratio_q32(&ctx->recip, vref_mv_q, signal_mv_q);
+    ctx->status.temperature_mc = ptx_temp_compute_mc(cal, &ctx->recip, vref_mv_q, signal_mv_q);
 #else
-    // Normalize voltage
-    float x = signal_mv / vref_mv; // fraction of Vref
-
-    // Calculate temperature
-    temperature = 387.5 * x - 48.75;
-
+    const ptx_cal_table_t* cal = ptx_cal_get_table(ctx->config.probe_profile);
+    ctx->status.temperature_c = ptx_temp_compute_c(cal, (float)vref_mv_q, (float)signal_mv_q);
+    ctx->status.temperature_mc = (int32_t)(ctx->status.temperature_c * 1000.0f);
 #endif
+    if (ctx->status.temperature_mc >= ptx_cal_temp_max_mc(cal))
+    {
+        PTX_LOG_DEBUG("[ERROR]Over temperature !!!");
+    }
 
     // @Debug purpose
-    PTX_DBG_LOGF("ptx_compute_temperature[end]: temperature=%i ", (int)temperature);
-    return temperature;
+    PTX_LOG_DEBUG("ptx_compute_temperature[end]: temperature=%i ", ptx_temperature_whole_c(ctx));
+}
 
+// Select an LED blink interval
+static uint32_t ptx_blink_interval(const ptx_oven_ctx_t* ctx) {
+    if (ctx->status.door_open || ctx->status.vref_fault ||
+            ctx->status.signal_fault || ctx->status.sensor_fault)
+    {
+        return FAST_BLINK_MS;
+    }
+    return SLOW_BLINK_MS;
 }
 
 // Control output: igniter and gas
-static void ptx_apply_outputs(uint32_t now_ms) {
-
-    static bool sys_led_status = false;
-    static uint32_t sys_led_last_toggle_ms = 0;
+static void ptx_apply_outputs(ptx_oven_ctx_t* ctx, const ptx_io_table_t* io, uint32_t now_ms) {
 
     // Control gas and igniter
-    ptx_actuator_set_gas(pti_status.gas_on);
-    ptx_actuator_set_igniter(pti_status.igniter_on);
+    ptx_actuator_set_gas_ctx(&ctx->actuator, io, ctx->status.gas_on);
+    ptx_actuator_set_igniter_ctx(&ctx->actuator, io, ctx->status.igniter_on);
 	
-    // Select an interval
-    uint32_t blink_interval = SLOW_BLINK_MS;
-    if(pti_status.door_open || pti_status.vref_fault||
-            pti_status.signal_fault|| pti_status.sensor_fault)
-    {
-        blink_interval = FAST_BLINK_MS;
-    }
-
     // Toggle LED if time is reached
-    if ((uint32_t)(now_ms - sys_led_last_toggle_ms) >= blink_interval) {
-            sys_led_status = !sys_led_status;
-        set_output(SYS_LED_STATUS, sys_led_status);
-        sys_led_last_toggle_ms = now_ms;
+    if ((uint32_t)(now_ms - ctx->sys_led_last_toggle_ms) >= ptx_blink_interval(ctx)) {
+        ctx->sys_led_on = !ctx->sys_led_on;
+        ptx_actuator_set_system_led_status_ctx(&ctx->actuator, io, ctx->sys_led_on);
+        ctx->sys_led_last_toggle_ms = now_ms;
     }
 }
 
 // Main state machine
-static void ptx_update_heating(uint32_t now_ms) {
-    const ptx_oven_config_t* cfg = ptx_oven_get_config();
+static void ptx_update_heating(ptx_oven_ctx_t* ctx, uint32_t now_ms) {
+    const ptx_oven_config_t* cfg = &ctx->config;
     
     /* Door and sensor faults override everything - force shutdown regardless of state */
-	if (pti_status.door_open || pti_status.sensor_fault) 
+	if (ctx->status.door_open || ctx->status.sensor_fault) 
 	{
-		if (pti_status.gas_on || pti_status.igniter_on) 
+		if (ctx->status.gas_on || ctx->status.igniter_on) 
 		{
-			PTX_LOGF("[ERROR]shutdown: door open or sensor fault");
+			PTX_LOG_ERROR("[ERROR]shutdown: door open or sensor fault");
 		}
 		
-		pti_status.gas_on = false;
-		pti_status.igniter_on = false;
-		pti_status.state = PTX_HEATING_STATE_IDLE;
-		pti_ignition_attempt = 0; /* Reset attempt counter on fault */
+		ctx->status.gas_on = false;
+		ctx->status.igniter_on = false;
+#if (PTX_FLAME_DETECT_ENABLED)
+		/* An interrupted attempt failed: gas flowed unburnt, purge, and it counts */
+		if (ctx->status.state == PTX_HEATING_STATE_IGNITING) {
+			ctx->purge_start_ms = now_ms;
+			if (ctx->ignition_attempt >= cfg->max_ignition_attempts) {
+				ctx->status.state = PTX_HEATING_STATE_LOCKOUT;
+				ctx->status.ignition_lockout = true;
+				PTX_LOG_ERROR("[ERROR] ignition failed %d times, lockout", ctx->ignition_attempt);
+			}
+		}
+#endif
+		/* Attempts and purge outlive the fault: only a flame or a manual reset clears them */
+		if (ctx->status.state != PTX_HEATING_STATE_LOCKOUT) {   /* Lockout outlives the door */
+			ctx->status.state = PTX_HEATING_STATE_IDLE;
+		}
 		return;
     }
 	
 	/* Hysteresis thresholds */
+#if PTX_FIXED_POINT
+    /* Same decisions as comparing temperature_mc with temp_on_mc / temp_off_mc */
+    bool below_temp_on = (ctx->ratio_q32 < ctx->fx.th.on_ratio_q32);
+    bool above_temp_off = (ctx->ratio_q32 >= ctx->fx.th.off_ratio_q32);
+#else
     float temp_on = cfg->temp_target_c - cfg->temp_delta_c;
     float temp_off = cfg->temp_target_c + cfg->temp_delta_c;
+    bool below_temp_on = (ctx->status.temperature_c <= temp_on);
+    bool above_temp_off = (ctx->status.temperature_c >= temp_off);
+#endif
 	
     /* State machine logic */
-    switch (pti_status.state) {
+    switch (ctx->status.state) {
         case PTX_HEATING_STATE_IDLE:
 
+#if (PTX_FLAME_DETECT_ENABLED)
+            /* After a failed attempt, let the unburnt gas clear first */
+            if ((ctx->ignition_attempt > 0U) &&
+                    ((uint32_t)(now_ms - ctx->purge_start_ms) < PTX_IGNITION_PURGE_MS)) {
+                break;
+            }
+#endif
 		    /* Check if heating is needed */
-            if (pti_status.temperature_c <= temp_on) {
+            if (below_temp_on) {
                 /* Start ignition sequence */
-                pti_ignition_attempt++;
-                pti_status.gas_on = true;
-                pti_status.igniter_on = true;
-                pti_status.state = PTX_HEATING_STATE_IGNITING;
-                pti_ignition_start_ms = now_ms;
-                pti_temp_at_ignition_start = pti_status.temperature_c;
+                ctx->ignition_attempt++;
+                ctx->status.gas_on = true;
+                ctx->status.igniter_on = true;
+                ctx->status.state = PTX_HEATING_STATE_IGNITING;
+                ctx->ignition_start_ms = now_ms;
+                ctx->temp_at_ignition_start_mc = ctx->status.temperature_mc;
+#if (PTX_FLAME_DETECT_ENABLED)
+                ptx_slope_reset(&ctx->flame_fit);
+                ptx_slope_add(&ctx->flame_fit, 0U, 0);
+#endif
                 
-				//int temp_c_i = (int)(pti_status.temperature_c + 0.5f);
-                PTX_LOGF("ignite start attempt=%d temp=%d°C", pti_ignition_attempt, (int)pti_status.temperature_c);
+				//int temp_c_i = (int)(ctx->status.temperature_c + 0.5f);
+                PTX_LOGF("ignite start attempt=%d temp=%d°C", ctx->ignition_attempt, ptx_temperature_whole_c(ctx));
             }
             break;
 
         case PTX_HEATING_STATE_IGNITING:
-            /* Wait for ignition period to complete */
-            if ((now_ms - pti_ignition_start_ms) >= cfg->ignition_duration_ms) {
-                /* Ignition period ended, check for flame */
-                float temp_rise = pti_status.temperature_c - pti_temp_at_ignition_start;
-
 #if (PTX_FLAME_DETECT_ENABLED)
-                /* Flame detected - successful ignition */
-				// @todo
-				PTX_LOGF("Flame detected successful ignition");
+        {
+            /* Fit the rise since gas on, one sample at a time */
+            uint32_t elapsed_ms = now_ms - ctx->ignition_start_ms;
+            int32_t temp_rise_mc = ctx->status.temperature_mc - ctx->temp_at_ignition_start_mc;
+            ptx_slope_add(&ctx->flame_fit, elapsed_ms, temp_rise_mc);
+
+            if ((ctx->flame_fit.n >= PTX_FLAME_MIN_SAMPLES) &&
+                    ptx_slope_at_least(&ctx->flame_fit, PTX_FLAME_MIN_RISE_MC_PER_S)) {
+                /* Flame detected - successful ignition, igniter off early */
+                ctx->status.igniter_on = false;
+                ctx->status.state = PTX_HEATING_STATE_HEATING;
+                ctx->ignition_attempt = 0;
+                PTX_LOGF("flame detected after %lums rise=%ldmC/s", (unsigned long)elapsed_ms,
+                         (long)ptx_slope_per_s(&ctx->flame_fit));
+            } else if (elapsed_ms >= cfg->ignition_duration_ms) {
+                /* No flame within the window: close the gas */
+                ctx->status.gas_on = false;
+                ctx->status.igniter_on = false;
+                if (ctx->ignition_attempt >= cfg->max_ignition_attempts) {
+                    ctx->status.state = PTX_HEATING_STATE_LOCKOUT;
+                    ctx->status.ignition_lockout = true;
+                    PTX_LOG_ERROR("[ERROR] ignition failed %d times, lockout", ctx->ignition_attempt);
+                } else {
+                    ctx->status.state = PTX_HEATING_STATE_IDLE;
+                    ctx->purge_start_ms = now_ms;
+                    PTX_LOG_WARN("[WARNING] no flame, attempt=%d rise=%ldmC/s, purging", ctx->ignition_attempt,
+                                 (long)ptx_slope_per_s(&ctx->flame_fit));
+                }
+            }
+            break;
+        }
 #else
+            /* Wait for ignition period to complete */
+            if ((now_ms - ctx->ignition_start_ms) >= cfg->ignition_duration_ms) {
                 /* Flame detection disabled - assume success */
-                pti_status.igniter_on = false;
-                pti_status.state = PTX_HEATING_STATE_HEATING;
-                pti_ignition_attempt = 0;
+                ctx->status.igniter_on = false;
+                ctx->status.state = PTX_HEATING_STATE_HEATING;
+                ctx->ignition_attempt = 0;
                 PTX_LOGF("ignition assumed success (flame detect disabled)");
-#endif
 			}
             /* Else keep igniter on and wait */
             break;
+#endif
 
         case PTX_HEATING_STATE_HEATING:
             /* Check if reached upper temperature threshold */
-            if (pti_status.temperature_c >= temp_off) {
-                pti_status.gas_on = false;
-                pti_status.igniter_on = false;
-                pti_status.state = PTX_HEATING_STATE_IDLE;
-                pti_ignition_attempt = 0; /* Successful heating cycle */
-                //int temp_c_i = (int)(pti_status.temperature_c + 0.5f);
-                PTX_LOGF("heat off temp=%dC", pti_status.temperature_c);
+            if (above_temp_off) {
+                ctx->status.gas_on = false;
+                ctx->status.igniter_on = false;
+                ctx->status.state = PTX_HEATING_STATE_IDLE;
+                ctx->ignition_attempt = 0; /* Successful heating cycle */
+                //int temp_c_i = (int)(ctx->status.temperature_c + 0.5f);
+                PTX_LOGF("heat off temp=%dC", ptx_temperature_whole_c(ctx));
             }
             /* Else keep heating */
             break;
@@ -223,117 +339,444 @@ static void ptx_update_heating(uint32_t now_ms) {
 
         default:
             /* Invalid state - reset to IDLE */
-            PTX_LOGF("invalid state %d, reset to IDLE", (int)pti_status.state);
+            PTX_LOGF("invalid state %d, reset to IDLE", (int)ctx->status.state);
             break;
     }
 }
 
 // Capture and show system log
-static void ptx_oven_run_log(uint32_t now_ms) {
-	const ptx_oven_config_t* cfg = ptx_oven_get_config();
+static void ptx_oven_run_log(ptx_oven_ctx_t* ctx, uint32_t now_ms) {
+	const ptx_oven_config_t* cfg = &ctx->config;
     
-    if ((now_ms - pti_last_log_ms) < cfg->periodic_log_ms) return;
-    pti_last_log_ms = now_ms;
+    if ((now_ms - ctx->last_log_ms) < cfg->periodic_log_ms) return;
+    ctx->last_log_ms = now_ms;
 
-    int vref_mV = (int)(pti_status.vref_volts * 1000.0f + 0.5f);
-    int signal_mV = (int)(pti_status.signal_volts * 1000.0f + 0.5f);
-    //int temp_c_i = (int)(pti_status.temperature_c + 0.5f);
+    int vref_mV = (int)ctx->status.vref_mv;
+    int signal_mV = (int)ctx->status.signal_mv;
+    //int temp_c_i = (int)(ctx->status.temperature_c + 0.5f);
     
     /* Main status log */
-    PTX_LOGF("temp=%d°C door=%s state=%d gas=%d ign=%d attempt=%d lockout=%d",
-             (int)pti_status.temperature_c,
-             pti_status.door_open ? "OPEN" : "CLOSED",
-             (int)pti_status.state,
-             pti_status.gas_on ? 1 : 0,
-             pti_status.igniter_on ? 1 : 0,
-             pti_status.ignition_attempt,
-             pti_status.ignition_lockout ? 1 : 0);
+    PTX_LOGF_PERIODIC("temp=%d°C door=%s state=%d gas=%d ign=%d attempt=%d lockout=%d",
+             ptx_temperature_whole_c(ctx),
+             ctx->status.door_open ? "OPEN" : "CLOSED",
+             (int)ctx->status.state,
+             ctx->status.gas_on ? 1 : 0,
+             ctx->status.igniter_on ? 1 : 0,
+             ctx->status.ignition_attempt,
+             ctx->status.ignition_lockout ? 1 : 0);
     
     /* Sensor and fault log */
-    PTX_LOGF("vref=%dmV signal=%dmV vref_fault=%d signal_fault=%d sensor_fault=%d",
+    PTX_LOGF_PERIODIC("vref=%dmV signal=%dmV vref_fault=%d signal_fault=%d sensor_fault=%d",
              vref_mV,
              signal_mV,
-             pti_status.vref_fault ? 1 : 0,
-             pti_status.signal_fault ? 1 : 0,
-             pti_status.sensor_fault ? 1 : 0);
+             ctx->status.vref_fault ? 1 : 0,
+             ctx->status.signal_fault ? 1 : 0,
+             ctx->status.sensor_fault ? 1 : 0);
+
+#if PTX_ADC_SAMPLER_ENABLED
+    /* Pairs lost since the last log: the main loop fell behind the conversions */
+    uint16_t dropped = ptx_adc_sampler_dropped();
+    if (dropped != pti_adc_dropped_logged) {
+        PTX_LOG_WARN("[WARNING] adc sampler dropped %u pairs", (unsigned)(uint16_t)(dropped - pti_adc_dropped_logged));
+        pti_adc_dropped_logged = dropped;
+    }
+#endif
+
+#if PTX_PROFILE_ENABLED
+    /* Worst-case stage times (us), for certifying the loop period */
+    if (++ctx->logs_since_profile >= PROFILE_SUMMARY_EVERY) {
+        ptx_profile_stats_t st[PTX_STAGE_COUNT];
+        for (uint8_t i = 0; i < PTX_STAGE_COUNT; ++i) {
+            ptx_profile_get((ptx_stage_t)i, &st[i]);
+        }
+        ctx->logs_since_profile = 0;
+
+        PTX_LOGF_PERIODIC("wcet_us read=%lu filt=%lu fault=%lu temp=%lu heat=%lu out=%lu log=%lu total=%lu mean=%lu",
+                 (unsigned long)st[PTX_STAGE_SENSOR_READ].max_us,
+                 (unsigned long)st[PTX_STAGE_FILTER].max_us,
+                 (unsigned long)st[PTX_STAGE_FAULT_EVAL].max_us,
+                 (unsigned long)st[PTX_STAGE_TEMPERATURE].max_us,
+                 (unsigned long)st[PTX_STAGE_HEATING].max_us,
+                 (unsigned long)st[PTX_STAGE_OUTPUTS].max_us,
+                 (unsigned long)st[PTX_STAGE_LOG].max_us,
+                 (unsigned long)st[PTX_STAGE_TOTAL].max_us,
+                 (unsigned long)st[PTX_STAGE_TOTAL].mean_us);
+    }
+#endif
 }
 
-/* Public API */
-const ptx_oven_status_t* ptx_oven_get_status(void) {
-    return &pti_status;
+/* Per-instance API */
+const ptx_oven_status_t* ptx_oven_get_status_ctx(ptx_oven_ctx_t* ctx) {
+#if PTX_FIXED_POINT
+    /* Float views are derived on request, keeping float math out of the loop */
+    ctx->status.vref_volts    = ctx->status.vref_mv / 1000.0f;
+    ctx->status.signal_volts  = ctx->status.signal_mv / 1000.0f;
+    ctx->status.temperature_c = ctx->status.temperature_mc / 1000.0f;
+#endif
+    return &ctx->status;
 }
 
-// Initialize oven controller
-void ptx_oven_control_init(void) {
+void ptx_oven_set_config_ctx(ptx_oven_ctx_t* ctx, const ptx_oven_config_t* config) {
+    if (config != NULL) {
+        ctx->config = *config;
+        ctx->config_revision++;
+    }
+}
+
+void ptx_oven_reset_ignition_lockout_ctx(ptx_oven_ctx_t* ctx) {
+    if (ctx->status.state != PTX_HEATING_STATE_LOCKOUT) return;
+
+    ctx->status.state = PTX_HEATING_STATE_IDLE;
+    ctx->status.ignition_lockout = false;
+    ctx->ignition_attempt = 0;
+    PTX_LOG_WARN("[WARNING] ignition lockout reset");
+}
+
+void ptx_oven_set_door_state_ctx(ptx_oven_ctx_t* ctx, bool open) {
+    ctx->door_open_level = open;
+}
+
+// Initialize one oven controller
+void ptx_oven_control_init_ctx(ptx_oven_ctx_t* ctx, const ptx_oven_config_t* config,
+                               const ptx_io_table_t* io) {
 	
-    /* Initialize actuators and sensor filter */
-    pti_status.vref_volts = 0.0f;
-    pti_status.signal_volts = 0.0f;
-    pti_status.temperature_c = -10.0f;
-    pti_status.door_open = false;
-    pti_status.gas_on = false;
-    pti_status.igniter_on = false;
-    pti_status.state = PTX_HEATING_STATE_IDLE;
-    pti_status.vref_fault = false;
-    pti_status.signal_fault = false;
-    pti_status.sensor_fault = false;
-    pti_status.ignition_attempt = 0;
-    pti_status.ignition_lockout = false;
-
-    pti_ignition_start_ms = 0;
-    pti_last_log_ms = 0;
-    pti_ignition_attempt = 0;
-    pti_temp_at_ignition_start = 0.0f;
+    ctx->status.vref_volts = 0.0f;
+    ctx->status.signal_volts = 0.0f;
+    ctx->status.temperature_c = -10.0f;
+    ctx->status.vref_mv = 0;
+    ctx->status.signal_mv = 0;
+    ctx->status.temperature_mc = PTX_TEMP_MIN_MC;
+    ctx->status.door_open = false;
+    ctx->status.gas_on = false;
+    ctx->status.igniter_on = false;
+    ctx->status.state = PTX_HEATING_STATE_IDLE;
+    ctx->status.vref_fault = false;
+    ctx->status.signal_fault = false;
+    ctx->status.sensor_fault = false;
+    ctx->status.ignition_attempt = 0;
+    ctx->status.ignition_lockout = false;
+
+    ctx->config = (config != NULL) ? *config : *ptx_oven_get_config();
+    ctx->config_revision = 0;
+
+    ctx->ignition_start_ms = 0;
+    ctx->last_log_ms = 0;
+    ctx->logs_since_profile = 0;
+    ctx->ignition_attempt = 0;
+    ctx->door_open_level = false;
+    ptx_hist_reset(&ctx->door_latency);
+    ctx->sys_led_on = false;
+    ctx->sys_led_last_toggle_ms = 0;
+    ctx->out_of_range_since_ms = 0;
+    ctx->valid_since_ms = 0;
+    ctx->purge_start_ms = 0;
+    ctx->temp_at_ignition_start_mc = 0;
+#if PTX_FLAME_DETECT_ENABLED
+    ptx_slope_reset(&ctx->flame_fit);
+#endif
+#if PTX_FIXED_POINT
+    ctx->fx.loaded = false;
+    ptx_temp_recip_reset(&ctx->recip);
+    ctx->ratio_q32 = 0;
+#endif
     
     /* Initialize actuators and sensor filter */
-    ptx_actuator_init();
-    ptx_sensor_filter_init(5);
+    ptx_actuator_init_ctx(&ctx->actuator, io);
+    ptx_sensor_filter_init_ctx(&ctx->filter, 5);
+}
 
-    PTX_LOGF("oven control init");
+// Sample both inputs through the injected table or the board binding (mV << PTX_OVERSAMPLE_BITS)
+static void ptx_read_inputs(const ptx_io_table_t* io, uint16_t* vref_mv_q, uint16_t* signal_mv_q) {
+    if (io != NULL) {
+        *vref_mv_q   = (uint16_t)(io->read_mv(io->user, TEMPERATURE_SENSOR_REFERENCE) << PTX_OVERSAMPLE_BITS);
+        *signal_mv_q = (uint16_t)(io->read_mv(io->user, TEMPERATURE_SENSOR) << PTX_OVERSAMPLE_BITS);
+    } else {
+#if PTX_ADC_SAMPLER_ENABLED
+        /* Decimated pairs converted since the last update: no waiting */
+        ptx_adc_sampler_read_mv_q(vref_mv_q, signal_mv_q);
+#else
+        *vref_mv_q   = (uint16_t)(ptx_io_read_mv<TEMPERATURE_SENSOR_REFERENCE>() << PTX_OVERSAMPLE_BITS);
+        *signal_mv_q = (uint16_t)(ptx_io_read_mv<TEMPERATURE_SENSOR>() << PTX_OVERSAMPLE_BITS);
+#endif
+    }
 }
 
 // The heart of an oven controller program
-void ptx_oven_control_update(void) {
-    uint32_t now = millis();
+// sample: read the inputs into *raw_vref_mv_q/*raw_signal_mv_q, else use them as given
+static void ptx_update(ptx_oven_ctx_t* ctx, const ptx_io_table_t* io, uint32_t now, bool sample,
+                       uint16_t* raw_vref_mv_q, uint16_t* raw_signal_mv_q) {
+    PTX_PROFILE_BEGIN(PTX_STAGE_TOTAL);
 
     /* Read and filter sensor data */
-    ptx_sensor_reading_t filtered = ptx_sensor_filter_read_and_update();
+    if (sample) {
+        PTX_PROFILE_BEGIN(PTX_STAGE_SENSOR_READ);
+        ptx_read_inputs(io, raw_vref_mv_q, raw_signal_mv_q);
+        PTX_PROFILE_END(PTX_STAGE_SENSOR_READ);
+    }
+
+    PTX_PROFILE_BEGIN(PTX_STAGE_FILTER);
+    ptx_sensor_reading_t filtered = ptx_sensor_filter_update_q_ctx(&ctx->filter, *raw_vref_mv_q, *raw_signal_mv_q);
+    PTX_PROFILE_END(PTX_STAGE_FILTER);
     
-    float vref_mv   = (float)filtered.vref_mv;
-    float signal_mv = (float)filtered.signal_mv;
+    PTX_LOG_DEBUG("ptx_oven_control_update[begin]: vref=%dmV signal=%dmV",
+                  (int)filtered.vref_mv, (int)filtered.signal_mv);
 
-    PTX_DBG_LOGF("ptx_oven_control_update[begin]: vref=%dmV signal=%dmV", (int)vref_mv, (int)signal_mv);
+#if PTX_FIXED_POINT
+    ptx_refresh_fx_thresholds(ctx);
+#endif
 
 #if 1
     /* Evaluate faults with timing first. */
-    ptx_eval_sensor_faults_with_timing(now, vref_mv, signal_mv);
-    pti_status.door_open = ptx_read_door_open();
-
-    /* Compute temperature (for display/log); control will still be overridden on faults. */
-    pti_status.temperature_c = ptx_compute_temperature(vref_mv, signal_mv);
+    PTX_PROFILE_BEGIN(PTX_STAGE_FAULT_EVAL);
+    ptx_eval_sensor_faults_with_timing(ctx, now, &filtered);
+    ctx->status.door_open = ptx_read_door_open(ctx);
+    PTX_PROFILE_END(PTX_STAGE_FAULT_EVAL);
+
+    /* Compute temperature (for display/log) from the ratio at full resolution;
+       control will still be overridden on faults. */
+    PTX_PROFILE_BEGIN(PTX_STAGE_TEMPERATURE);
+    ptx_compute_temperature(ctx, filtered.vref_mv_q, filtered.signal_mv_q);
+    PTX_PROFILE_END(PTX_STAGE_TEMPERATURE);
 #else
     /* @ for debug only */
-    dummytest_statemachine();
+    dummytest_statemachine(ctx);
 #endif
 
     /* Control decision. */
-    ptx_update_heating(now);
+    PTX_PROFILE_BEGIN(PTX_STAGE_HEATING);
+    ptx_update_heating(ctx, now);
+    PTX_PROFILE_END(PTX_STAGE_HEATING);
 
     /* Apply outputs and log. */
-    ptx_apply_outputs(now);
-    ptx_oven_run_log(now);
+    PTX_PROFILE_BEGIN(PTX_STAGE_OUTPUTS);
+    ptx_apply_outputs(ctx, io, now);
+    PTX_PROFILE_END(PTX_STAGE_OUTPUTS);
+
+    PTX_PROFILE_BEGIN(PTX_STAGE_LOG);
+    ptx_oven_run_log(ctx, now);
+    PTX_PROFILE_END(PTX_STAGE_LOG);
     
     /* Update public status */
-    pti_status.ignition_attempt = pti_ignition_attempt;
+    ctx->status.ignition_attempt = ctx->ignition_attempt;
+    PTX_PROFILE_END(PTX_STAGE_TOTAL);
+}
+
+void ptx_oven_control_update_ctx(ptx_oven_ctx_t* ctx, const ptx_io_table_t* io, uint32_t now) {
+    uint16_t raw_vref_mv_q;
+    uint16_t raw_signal_mv_q;
+    ptx_update(ctx, io, now, true, &raw_vref_mv_q, &raw_signal_mv_q);
+}
+
+// Time left until a timer started at since_ms expires
+static uint32_t ptx_time_left(uint32_t now_ms, uint32_t since_ms, uint32_t interval_ms) {
+    uint32_t elapsed = now_ms - since_ms;
+    return (elapsed >= interval_ms) ? 0U : (interval_ms - elapsed);
+}
+
+// Heating on (target - delta) or off (target + delta) threshold in m°C,
+// without the ratio bisections of ptx_oven_config_thresholds()
+static int32_t ptx_band_edge_mc(const ptx_oven_ctx_t* ctx, bool off) {
+#if PTX_FIXED_POINT
+    if (ctx->fx.loaded && (ctx->fx.revision == ctx->config_revision)) {
+        return off ? ctx->fx.th.temp_off_mc : ctx->fx.th.temp_on_mc;
+    }
+#endif
+    const ptx_oven_config_t* cfg = &ctx->config;
+    return ptx_oven_round_milli(off ? (cfg->temp_target_c + cfg->temp_delta_c)
+                                    : (cfg->temp_target_c - cfg->temp_delta_c));
+}
+
+uint32_t ptx_oven_next_event_ctx(const ptx_oven_ctx_t* ctx, uint32_t now_ms, uint8_t events,
+                                 ptx_oven_predict_fn predict, void* user) {
+    const ptx_oven_status_t* st = &ctx->status;
+    const ptx_oven_config_t* cfg = &ctx->config;
+    bool blocked = st->door_open || st->sensor_fault;   /* Heating is forced off */
+    uint32_t next = PTX_NEXT_NONE;
+
+    if ((events & PTX_NEXT_IGNITION) && !blocked && (st->state == PTX_HEATING_STATE_IGNITING)) {
+        uint32_t t = ptx_time_left(now_ms, ctx->ignition_start_ms, cfg->ignition_duration_ms);
+        if (t < next) next = t;
+    }
+#if (PTX_FLAME_DETECT_ENABLED)
+    if ((events & PTX_NEXT_IGNITION) && !blocked && (st->state == PTX_HEATING_STATE_IDLE) &&
+            (ctx->ignition_attempt > 0U)) {
+        uint32_t t = ptx_time_left(now_ms, ctx->purge_start_ms, PTX_IGNITION_PURGE_MS);
+        if (t < next) next = t;
+    }
+    if ((events & PTX_NEXT_TEMP) && !blocked && (st->state == PTX_HEATING_STATE_IGNITING)) {
+        return 0U;      /* Flame confirmation depends on the next readings */
+    }
+#endif
+    if (events & PTX_NEXT_LOG) {
+        uint32_t t = ptx_time_left(now_ms, ctx->last_log_ms, cfg->periodic_log_ms);
+        if (t < next) next = t;
+    }
+    if (events & PTX_NEXT_LED) {
+        uint32_t t = ptx_time_left(now_ms, ctx->sys_led_last_toggle_ms, ptx_blink_interval(ctx));
+        if (t < next) next = t;
+    }
+    if ((events & PTX_NEXT_TEMP) && st->sensor_fault) {
+        return 0U;      /* Recovery depends on the next readings: cannot look ahead */
+    }
+    if ((events & PTX_NEXT_TEMP) && (predict != NULL) && !blocked) {
+        uint32_t t = PTX_NEXT_NONE;
+        if (st->state == PTX_HEATING_STATE_IDLE) {
+            t = predict(user, ptx_band_edge_mc(ctx, false), false);
+        } else if (st->state == PTX_HEATING_STATE_HEATING) {
+            t = predict(user, ptx_band_edge_mc(ctx, true), true);
+        }
+        if (t < next) next = t;
+    }
+    return next;
+}
+
+/* Single-oven API */
+
+// Follow the process-wide configuration
+static void ptx_sync_global_config(void) {
+    if (ptx_oven_get_config_revision() != pti_oven_global_revision) {
+        ptx_oven_config_t config;
+        pti_oven_global_revision = ptx_oven_config_snapshot(&config);
+        ptx_oven_set_config_ctx(&pti_oven, &config);
+    }
+}
+
+const ptx_oven_status_t* ptx_oven_get_status(void) {
+    return ptx_oven_get_status_ctx(&pti_oven);
+}
+
+ptx_actuator_t* ptx_oven_get_actuator(void) {
+    return &pti_oven.actuator;
+}
+
+uint32_t ptx_oven_next_event(uint8_t events, ptx_oven_predict_fn predict, void* user) {
+    return ptx_oven_next_event_ctx(&pti_oven, millis(), events, predict, user);
+}
+
+// Initialize oven controller
+void ptx_oven_control_init(void) {
+    ptx_oven_config_t config;
+
+    pti_oven_global_revision = ptx_oven_config_snapshot(&config);
+
+    /* The door level outlives init; no door edge may land between its save and restore */
+    ptx_irq_state_t irq = ptx_irq_save();
+    bool door_open = pti_oven.door_open_level;
+    ptx_oven_control_init_ctx(&pti_oven, &config, NULL);
+    pti_oven.door_open_level = door_open;
+    ptx_irq_restore(irq);
+#if PTX_ADC_SAMPLER_ENABLED
+    ptx_adc_sampler_start(PTX_ADC_SAMPLE_HZ);
+    pti_adc_dropped_logged = 0;
+#endif
+    ptx_profile_reset();
+
+    PTX_LOGF("oven control init");
+}
+
+#if PTX_TRACE_ENABLED
+// One update of the single-oven instance, recorded with the inputs it filtered
+static void ptx_trace_update(bool sample, uint16_t vref_mv_q, uint16_t signal_mv_q) {
+    uint32_t now = millis();
+
+    pti_trace_rec.vref_mv_q = vref_mv_q;
+    pti_trace_rec.signal_mv_q = signal_mv_q;
+    ptx_update(&pti_oven, NULL, now, sample, &pti_trace_rec.vref_mv_q, &pti_trace_rec.signal_mv_q);
+
+    uint8_t flags = 0;
+    if (pti_oven.status.door_open)  flags |= PTX_TRACE_DOOR_OPEN;
+    if (pti_oven.status.gas_on)     flags |= PTX_TRACE_GAS;
+    if (pti_oven.status.igniter_on) flags |= PTX_TRACE_IGNITER;
+    if (pti_oven.sys_led_on)        flags |= PTX_TRACE_LED;
+    ptx_trace_emit(PTX_TRACE_UPDATE, now, flags);
+}
+#endif
+
+void ptx_oven_control_update(void) {
+    ptx_sync_global_config();
+    ptx_process_events(&pti_oven);
+#if PTX_TRACE_ENABLED
+    if (pti_trace_sink != NULL) {
+        ptx_trace_update(true, 0, 0);
+        return;
+    }
+#endif
+    ptx_oven_control_update_ctx(&pti_oven, NULL, millis());
+}
+
+void ptx_oven_control_update_q(uint16_t vref_mv_q, uint16_t signal_mv_q) {
+    ptx_sync_global_config();
+    ptx_process_events(&pti_oven);
+#if PTX_TRACE_ENABLED
+    if (pti_trace_sink != NULL) {
+        ptx_trace_update(false, vref_mv_q, signal_mv_q);
+        return;
+    }
+#endif
+    ptx_update(&pti_oven, NULL, millis(), false, &vref_mv_q, &signal_mv_q);
+}
+
+void ptx_oven_reset_ignition_lockout(void) {
+    ptx_oven_reset_ignition_lockout_ctx(&pti_oven);
 }
 
 // Set door state
 void ptx_oven_set_door_state(bool open) {
-    pti_status.door_open = open;
+    ptx_oven_set_door_state_ctx(&pti_oven, open);
+}
+
+// Door interrupt: act and record, nothing slow
+void ptx_oven_door_isr(bool open) {
+    ptx_event_t ev;
+
+    ev.time_us = (uint32_t)micros();
+    if (open) {
+        ptx_actuator_emergency_stop_ctx(&pti_oven.actuator, NULL);
+    }
+    pti_oven.door_open_level = open;
+
+    ev.type = PTX_EVENT_DOOR;
+    ev.value = open ? 1U : 0U;
+    ev.ack_us = (uint32_t)micros();
+    ptx_event_push(&ev);
+}
+
+#if PTX_TRACE_ENABLED
+void ptx_oven_set_trace_sink(ptx_trace_sink_fn sink, void* user) {
+    pti_trace_sink = NULL;      /* Never call a sink with another sink's user */
+    pti_trace_user = user;
+    pti_trace_sink = sink;
+}
+
+void ptx_oven_trace_header(ptx_trace_header_t* header) {
+    const ptx_oven_config_t* cfg = ptx_oven_get_config();
+
+    header->magic = PTX_TRACE_MAGIC;
+    header->version = PTX_TRACE_VERSION;
+    header->record_size = (uint16_t)sizeof(ptx_trace_record_t);
+    header->start_ms = (uint32_t)millis();
+    header->ignition_duration_ms = cfg->ignition_duration_ms;
+    header->periodic_log_ms = cfg->periodic_log_ms;
+    header->sensor_fault_window_ms = cfg->sensor_fault_window_ms;
+    header->auto_resume_delay_ms = cfg->auto_resume_delay_ms;
+    header->vref_min_v = cfg->vref_min_v;
+    header->vref_max_v = cfg->vref_max_v;
+    header->temp_target_c = cfg->temp_target_c;
+    header->temp_delta_c = cfg->temp_delta_c;
+    header->iteration_period = cfg->iteration_period;
+    header->max_ignition_attempts = cfg->max_ignition_attempts;
+    header->probe_profile = cfg->probe_profile;
+    header->oversample_bits = (uint8_t)PTX_OVERSAMPLE_BITS;
+    memset(header->reserved, 0, sizeof(header->reserved));
+}
+#endif
+
+const ptx_hist_t* ptx_oven_get_door_latency(void) {
+    return &pti_oven.door_latency;
 }
 
 // Simple stratgy to test hw without peripheral
-void dummytest_statemachine()
+static void dummytest_statemachine(ptx_oven_ctx_t* ctx)
 {
     static int cnt = 0;
     //NOTE: no real interrupt, then some status could be wrong
@@ -341,64 +784,66 @@ void dummytest_statemachine()
     switch(cnt)
     {
         case 0:
-            // pti_status.vref_volts = 0.0f;
-            // pti_status.signal_volts = 0.0f;
-            // pti_status.temperature_c = -10.0f;
-            pti_status.door_open = true;
+            // ctx->status.vref_volts = 0.0f;
+            // ctx->status.signal_volts = 0.0f;
+            // ctx->status.temperature_c = -10.0f;
+            ctx->status.door_open = true;
 
             break;
         case 1:
             //door close, expect ignitier on, gas on
-            pti_status.door_open = false;
-            pti_status.temperature_c = 150.0f;
+            ctx->status.door_open = false;
+            ctx->status.temperature_c = 150.0f;
             break;
         case 7: //after 5 sec for igniter 
 
             //door close, expect ignitier off, gas on
-            pti_status.door_open = false;
-            pti_status.temperature_c = 150.0f;
+            ctx->status.door_open = false;
+            ctx->status.temperature_c = 150.0f;
 
             break;
         case 8:
-            pti_status.door_open = false;
-            pti_status.temperature_c = 175.0f;
+            ctx->status.door_open = false;
+            ctx->status.temperature_c = 175.0f;
             break;
         case 9:
-            pti_status.door_open = false;
-            pti_status.temperature_c = 180.0f;
+            ctx->status.door_open = false;
+            ctx->status.temperature_c = 180.0f;
             break;
         case 10:
             //door close, expect ignitier off, gas off
-            pti_status.door_open = false;
-            pti_status.temperature_c = 186.0f;
+            ctx->status.door_open = false;
+            ctx->status.temperature_c = 186.0f;
             break;
         
         case 11:
             //door close, expect ignitier on, gas on
-            pti_status.door_open = false;
-            pti_status.temperature_c = 174.0f;
+            ctx->status.door_open = false;
+            ctx->status.temperature_c = 174.0f;
             break;
         case 17:
             //door close, expect ignitier off, gas on
-            pti_status.door_open = false;
-            pti_status.temperature_c = 181.0f;
+            ctx->status.door_open = false;
+            ctx->status.temperature_c = 181.0f;
             break;
         case 18:
             //door open, expect ignitier off, gas off
-            pti_status.door_open = true;
+            ctx->status.door_open = true;
             break;
         case 19:
             //door close, expect ignitier on, gas off
-            pti_status.door_open = false;
-            pti_status.temperature_c = 170.0f;  //182
+            ctx->status.door_open = false;
+            ctx->status.temperature_c = 170.0f;  //182
             break;
         case 20:
             //door close, overheat, expect ignitier on, gas off
-            pti_status.door_open = false;
-            pti_status.temperature_c = 301.0f;
+            ctx->status.door_open = false;
+            ctx->status.temperature_c = 301.0f;
             break;
 
     }
+    ctx->status.temperature_mc = (int32_t)(ctx->status.temperature_c * 1000.0f);
+
     if (cnt++ > 21)
         cnt = 0;
 }
\ No newline at end of file
@@ -9,17 +9,69 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "ptx_profile.h"
+#include "ptx_oven_config.h"
+#include "ptx_sensor_filter.h"
+#include "ptx_actuator.h"
+#include "ptx_temperature.h"
+#include "ptx_io.h"
+#include "ptx_trace.h"
+#include "ptx_slope.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 /**
- * @brief Update door state from external interrupt handler.
+ * @brief Flame confirmation by rate of rise during ignition
+ * @details 0: ignition is assumed to succeed when ignition_duration_ms ends.
+ *          1: a least-squares line is fitted, sample by sample, to the
+ *          temperature since the gas opened; the igniter goes off as soon as
+ *          the fitted rise reaches PTX_FLAME_MIN_RISE_MC_PER_S. If
+ *          ignition_duration_ms ends first, gas closes, the burner purges for
+ *          PTX_IGNITION_PURGE_MS and retries, up to max_ignition_attempts,
+ *          then locks out until ptx_oven_reset_ignition_lockout().
+ */
+#ifndef PTX_FLAME_DETECT_ENABLED
+#define PTX_FLAME_DETECT_ENABLED 0
+#endif
+
+#ifndef PTX_FLAME_MIN_RISE_MC_PER_S
+#define PTX_FLAME_MIN_RISE_MC_PER_S 150     // Fitted rise that proves flame (m°C/s)
+#endif
+
+#ifndef PTX_FLAME_MIN_SAMPLES
+#define PTX_FLAME_MIN_SAMPLES       30U     // No verdict on fewer samples (noise)
+#endif
+
+#ifndef PTX_IGNITION_PURGE_MS
+#define PTX_IGNITION_PURGE_MS       15000U  // Gas off between failed attempts (ms)
+#endif
+
+static_assert(PTX_FLAME_MIN_RISE_MC_PER_S <= PTX_SLOPE_MAX_RATE, "flame rise beyond the slope test range");
+static_assert(PTX_FLAME_MIN_SAMPLES <= PTX_SLOPE_MAX_SAMPLES, "flame verdict needs more samples than are fitted");
+
+/**
+ * @brief Update the door level seen by the control loop.
  * @param open true if door is open, false if closed.
+ * @note Safe from interrupt context; does not log or queue an event.
  */
 void ptx_oven_set_door_state(bool open);
 
+/**
+ * @brief Door interrupt handler body.
+ * @details On opening, closes gas and igniter immediately. Then publishes the
+ *          door level and queues a timestamped event; the control loop logs
+ *          it and records the edge-to-gas-off latency.
+ * @param open true if door is open, false if closed.
+ */
+void ptx_oven_door_isr(bool open);
+
+/**
+ * @brief Door edge to gas-off latency histogram (us).
+ */
+const ptx_hist_t* ptx_oven_get_door_latency(void);
+
 /**
  * @brief Heating state machine for the oven.
  */
@@ -37,6 +89,9 @@ typedef struct {
     float vref_volts;          		// Reference voltage from sensor (V). */
     float signal_volts;        		// Sensor signal (V), referenced to vref. */
     float temperature_c;       		// Computed temperature (°C). */
+    uint16_t vref_mv;          		// Filtered reference voltage (mV). */
+    uint16_t signal_mv;        		// Filtered sensor signal (mV). */
+    int32_t  temperature_mc;   		// Computed temperature (m°C). */
     bool  door_open;           		// Door state: true=open, false=closed. */
     bool  gas_on;              		// Gas valve command output. */
     bool  igniter_on;          		// Igniter command output. */
@@ -50,9 +105,145 @@ typedef struct {
     bool    ignition_lockout;  		// True if in safety lockout after failed ignitions. */
 } ptx_oven_status_t;
 
+/**
+ * @brief Complete state of one oven controller
+ * @details Everything the control loop keeps between iterations: status,
+ *          its own copy of the configuration, the sensor filter and the
+ *          actuator caches. Instances are independent, so one process can run
+ *          any number of them. Treat the fields as private; use the _ctx
+ *          functions below.
+ */
+typedef struct {
+    ptx_oven_status_t   status;
+    ptx_oven_config_t   config;
+    uint16_t            config_revision;            // Bumped by ptx_oven_set_config_ctx()
+    ptx_sensor_filter_t filter;
+    ptx_actuator_t      actuator;
+
+    uint32_t ignition_start_ms;
+    uint32_t last_log_ms;
+    uint8_t  logs_since_profile;
+
+    volatile bool door_open_level;                  // Written by the door interrupt
+    ptx_hist_t door_latency;                        // Door edge to gas off (us)
+
+    bool     sys_led_on;
+    uint32_t sys_led_last_toggle_ms;
+
+    /* Timed sensor fault management */
+    uint32_t out_of_range_since_ms;                 // 0 means not currently out of range
+    uint32_t valid_since_ms;                        // 0 means not in continuous valid window
+
+    /* Ignition retry management */
+    uint8_t  ignition_attempt;                      // Current attempt number (0 = not started)
+    uint32_t purge_start_ms;                        // Start time of purge phase
+    int32_t  temp_at_ignition_start_mc;             // Temperature when ignition started
+#if PTX_FLAME_DETECT_ENABLED
+    ptx_slope_t flame_fit;                          // Temperature rise since gas on
+#endif
+
+#if PTX_FIXED_POINT
+    /* Integer thresholds derived from the configuration, refreshed when it changes */
+    struct {
+        bool     loaded;
+        uint16_t revision;
+        ptx_oven_thresholds_t th;
+        const ptx_cal_table_t* cal;
+    } fx;
+    ptx_temp_recip_t recip;
+    uint32_t ratio_q32;                             // signal/vref of the last reading (Q0.32); drives the hysteresis
+#endif
+} ptx_oven_ctx_t;
+
+/**
+ * @brief Initialize one oven instance.
+ * @param ctx Instance state.
+ * @param config Initial configuration, copied; NULL copies the process-wide one.
+ * @param io I/O table, NULL for this board's pins.
+ * @note Drives the instance's gas and igniter off through io.
+ */
+void ptx_oven_control_init_ctx(ptx_oven_ctx_t* ctx, const ptx_oven_config_t* config,
+                               const ptx_io_table_t* io);
+
+/**
+ * @brief Execute one control loop iteration of one oven instance.
+ * @param ctx Instance state.
+ * @param io I/O table, NULL for this board's pins.
+ * @param now_ms Current time (ms).
+ */
+void ptx_oven_control_update_ctx(ptx_oven_ctx_t* ctx, const ptx_io_table_t* io, uint32_t now_ms);
+
+/**
+ * @brief Replace the configuration of one oven instance.
+ * @note Takes effect on the next update of that instance only.
+ */
+void ptx_oven_set_config_ctx(ptx_oven_ctx_t* ctx, const ptx_oven_config_t* config);
+
+/**
+ * @brief Update the door level of one oven instance.
+ * @note Safe from interrupt context.
+ */
+void ptx_oven_set_door_state_ctx(ptx_oven_ctx_t* ctx, bool open);
+
+/**
+ * @brief Leave the ignition lockout of one oven instance (manual reset).
+ * @note No effect outside lockout.
+ */
+void ptx_oven_reset_ignition_lockout_ctx(ptx_oven_ctx_t* ctx);
+
+/**
+ * @brief Status snapshot of one oven instance.
+ * @note With PTX_FIXED_POINT the float fields are derived here, on request.
+ */
+const ptx_oven_status_t* ptx_oven_get_status_ctx(ptx_oven_ctx_t* ctx);
+
+/* Events reported by ptx_oven_next_event_ctx() */
+#define PTX_NEXT_IGNITION   0x01U       // End of the ignition window
+#define PTX_NEXT_LOG        0x02U       // Next periodic status log
+#define PTX_NEXT_LED        0x04U       // Next status LED toggle
+#define PTX_NEXT_TEMP       0x08U       // Temperature reaching the active hysteresis threshold
+#define PTX_NEXT_ALL        0x0FU
+#define PTX_NEXT_NONE       0xFFFFFFFFUL
+
+/**
+ * @brief Plant prediction callback for ptx_oven_next_event_ctx()
+ * @param user Caller handle
+ * @param threshold_mc Temperature threshold (m°C)
+ * @param rising true: time until temperature >= threshold, false: until <= threshold
+ * @return ms from now, 0 if already there, PTX_NEXT_NONE if never
+ */
+typedef uint32_t (*ptx_oven_predict_fn)(void* user, int32_t threshold_mc, bool rising);
+
+/**
+ * @brief Time until the controller next acts on its own.
+ * @details Earliest of the selected events: end of the ignition window, next
+ *          periodic log, next LED toggle and, through predict, the plant
+ *          reaching the hysteresis threshold the current state waits for.
+ *          Until then an update only refreshes the readings, so a simulation
+ *          can jump ahead. Door edges are external and not covered; with
+ *          PTX_NEXT_TEMP selected a sensor fault reports 0 (recovery depends
+ *          on readings, not on time), and so does flame confirmation while
+ *          igniting with PTX_FLAME_DETECT_ENABLED; the end of a purge counts
+ *          as PTX_NEXT_IGNITION.
+ * @param ctx Instance state.
+ * @param now_ms Current time (ms).
+ * @param events PTX_NEXT_* mask.
+ * @param predict Plant prediction, NULL to leave out PTX_NEXT_TEMP.
+ * @param user Passed to predict.
+ * @return ms from now_ms, 0 if due, PTX_NEXT_NONE if nothing is pending.
+ */
+uint32_t ptx_oven_next_event_ctx(const ptx_oven_ctx_t* ctx, uint32_t now_ms, uint8_t events,
+                                 ptx_oven_predict_fn predict, void* user);
+
+/*
+ * Single-oven API: one module-level instance on this board's pins, following
+ * the process-wide configuration in ptx_oven_config.h.
+ */
+
 /**
  * @brief Initialize oven control module.
- * @note Does not configure hardware I/O; relies on api.h setup.
+ * @note Does not configure hardware I/O; relies on api.h setup. With
+ *       PTX_ADC_SAMPLER_ENABLED it starts the probe sampler (ptx_adc_sampler.h).
  */
 void ptx_oven_control_init(void);
 /**
@@ -60,11 +251,53 @@ void ptx_oven_control_init(void);
  * @details Reads inputs, validates sensors, updates heating state, and drives outputs.
  */
 void ptx_oven_control_update(void);
+/**
+ * @brief ptx_oven_control_update() with inputs sampled elsewhere
+ * @param vref_mv_q Reference, mV << PTX_OVERSAMPLE_BITS
+ * @param signal_mv_q Signal, mV << PTX_OVERSAMPLE_BITS
+ * @details The readings go straight to the sensor filter, as the sampler's
+ *          would; used to replay a trace (ptx_trace.h).
+ */
+void ptx_oven_control_update_q(uint16_t vref_mv_q, uint16_t signal_mv_q);
 /**
  * @brief Get a pointer to the latest status snapshot.
  * @return Pointer to constant ptx_oven_status_t structure.
+ * @note With PTX_FIXED_POINT the control loop only maintains the integer fields;
+ *       the float fields are derived here, on request.
  */
 const ptx_oven_status_t* ptx_oven_get_status(void);
+/**
+ * @brief Actuator state of the single-oven instance
+ * @note The ptx_actuator_*() functions drive this one, so their commands and
+ *       the control loop share one cache.
+ */
+ptx_actuator_t* ptx_oven_get_actuator(void);
+/**
+ * @brief Leave the ignition lockout (manual reset).
+ */
+void ptx_oven_reset_ignition_lockout(void);
+/**
+ * @brief ptx_oven_next_event_ctx() for the single-oven instance, at millis().
+ */
+uint32_t ptx_oven_next_event(uint8_t events, ptx_oven_predict_fn predict, void* user);
+
+#if PTX_TRACE_ENABLED
+/**
+ * @brief Start or stop recording a trace of the single-oven instance.
+ * @param sink Called with every record (see ptx_trace.h); NULL stops recording.
+ * @note Call ptx_oven_control_init(), write ptx_oven_trace_header(), then set
+ *       the sink: the header carries no controller state (filter windows,
+ *       heating state, timers), so a replay always starts from a freshly
+ *       initialized controller. Recording mid-run without the init cannot be
+ *       replayed. Each UPDATE record holds the readings the update filtered,
+ *       from the ADC sampler when it is enabled.
+ */
+void ptx_oven_set_trace_sink(ptx_trace_sink_fn sink, void* user);
+/**
+ * @brief Trace header for the current configuration, started at millis().
+ */
+void ptx_oven_trace_header(ptx_trace_header_t* header);
+#endif
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,85 @@
+/**
+ * @file ptx_profile.cpp
+ * @brief Implementation of the per-stage execution time probes
+ */
+#include "ptx_profile.h"
+#include <Arduino.h>
+#include <string.h>
+
+typedef struct {
+    uint32_t start_us;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint32_t sum_us;        /* Halved with count before it can overflow */
+    uint32_t window;        /* Runs included in sum_us */
+    uint32_t count;
+} pti_stage_t;
+
+static pti_stage_t pti_stages[PTX_STAGE_COUNT];
+
+static uint32_t pti_micros(void) {
+    return (uint32_t)micros();
+}
+
+static ptx_profile_clock_t pti_clock = pti_micros;
+
+void ptx_profile_set_clock(ptx_profile_clock_t clock) {
+    pti_clock = (clock != NULL) ? clock : pti_micros;
+}
+
+void ptx_profile_reset(void) {
+    memset(pti_stages, 0, sizeof(pti_stages));
+}
+
+void ptx_profile_begin(ptx_stage_t stage) {
+    if ((unsigned)stage >= PTX_STAGE_COUNT) return;
+    pti_stages[stage].start_us = pti_clock();
+}
+
+void ptx_profile_end(ptx_stage_t stage) {
+    if ((unsigned)stage >= PTX_STAGE_COUNT) return;
+
+    pti_stage_t* s = &pti_stages[stage];
+    uint32_t dt = pti_clock() - s->start_us;
+
+    if ((s->count == 0U) || (dt < s->min_us)) s->min_us = dt;
+    if (dt > s->max_us) s->max_us = dt;
+
+    /* Keep the mean over a long, bounded window without 64-bit math */
+    if ((s->sum_us > UINT32_MAX - dt) || (s->window == UINT16_MAX)) {
+        s->sum_us >>= 1;
+        s->window >>= 1;
+    }
+    s->sum_us += dt;
+    s->window++;
+    s->count++;
+}
+
+bool ptx_profile_get(ptx_stage_t stage, ptx_profile_stats_t* stats) {
+    if ((unsigned)stage >= PTX_STAGE_COUNT) return false;
+
+    const pti_stage_t* s = &pti_stages[stage];
+    stats->min_us = s->min_us;
+    stats->max_us = s->max_us;
+    stats->mean_us = (s->window > 0U) ? (s->sum_us / s->window) : 0U;
+    stats->count = s->count;
+    return true;
+}
+
+void ptx_hist_reset(ptx_hist_t* hist) {
+    memset(hist, 0, sizeof(*hist));
+}
+
+void ptx_hist_add(ptx_hist_t* hist, uint32_t latency_us) {
+    uint8_t k = 0;
+    uint32_t v = latency_us >> 1;
+
+    while ((v != 0U) && (k < PTX_HIST_BUCKETS - 1U)) {
+        v >>= 1;
+        k++;
+    }
+
+    if (hist->bucket[k] < UINT16_MAX) hist->bucket[k]++;
+    if (hist->count < UINT16_MAX) hist->count++;
+    if (latency_us > hist->max_us) hist->max_us = latency_us;
+}
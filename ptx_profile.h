@@ -0,0 +1,122 @@
+/**
+ * @file ptx_profile.h
+ * @brief Per-stage execution time probes for the control loop
+ * @details PTX_PROFILE_BEGIN()/PTX_PROFILE_END() around a stage record its
+ *          duration in microseconds. Each stage keeps min, max (the observed
+ *          worst-case execution time) and mean. The clock is micros() by
+ *          default; host builds can plug in their own with
+ *          ptx_profile_set_clock().
+ *
+ *          ptx_hist_t records event latencies (e.g. door edge to gas off)
+ *          as a power-of-two histogram.
+ *
+ *          On AVR micros() has a 4 us resolution and a probe pair costs a few
+ *          microseconds. Build with PTX_PROFILE_ENABLED=0 to compile the
+ *          probes out.
+ */
+#ifndef PTX_PROFILE_H
+#define PTX_PROFILE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef PTX_PROFILE_ENABLED
+#define PTX_PROFILE_ENABLED 1
+#endif
+
+/**
+ * @brief Profiled stages of ptx_oven_control_update()
+ */
+typedef enum {
+    PTX_STAGE_SENSOR_READ = 0,  // ptx_io_read_mv() of vref and signal
+    PTX_STAGE_FILTER,           // Median filter update
+    PTX_STAGE_FAULT_EVAL,       // Sensor fault evaluation and door read
+    PTX_STAGE_TEMPERATURE,      // Temperature computation
+    PTX_STAGE_HEATING,          // ptx_update_heating()
+    PTX_STAGE_OUTPUTS,          // ptx_apply_outputs()
+    PTX_STAGE_LOG,              // ptx_oven_run_log()
+    PTX_STAGE_TOTAL,            // Whole ptx_oven_control_update()
+    PTX_STAGE_COUNT
+} ptx_stage_t;
+
+/**
+ * @brief Timing statistics of one stage
+ */
+typedef struct {
+    uint32_t min_us;            // Shortest run
+    uint32_t max_us;            // Longest run: worst-case execution time seen
+    uint32_t mean_us;           // Average run
+    uint32_t count;             // Number of runs
+} ptx_profile_stats_t;
+
+/**
+ * @brief Latency histogram with power-of-two buckets
+ * @details bucket[0] counts latencies below 2 us, bucket[k] those in
+ *          [2^k, 2^(k+1)) us; the last bucket also takes everything longer.
+ */
+#define PTX_HIST_BUCKETS 16U
+
+typedef struct {
+    uint16_t bucket[PTX_HIST_BUCKETS];  // Samples per bucket (saturating)
+    uint16_t count;                     // Samples recorded (saturating)
+    uint32_t max_us;                    // Longest latency seen
+} ptx_hist_t;
+
+/**
+ * @brief Microsecond clock
+ */
+typedef uint32_t (*ptx_profile_clock_t)(void);
+
+/**
+ * @brief Replace the clock (NULL restores micros())
+ */
+void ptx_profile_set_clock(ptx_profile_clock_t clock);
+
+/**
+ * @brief Clear the statistics of all stages
+ */
+void ptx_profile_reset(void);
+
+/**
+ * @brief Mark the start of a stage
+ */
+void ptx_profile_begin(ptx_stage_t stage);
+
+/**
+ * @brief Mark the end of a stage and record its duration
+ */
+void ptx_profile_end(ptx_stage_t stage);
+
+/**
+ * @brief Copy out the statistics of a stage
+ * @return false if stage is out of range
+ */
+bool ptx_profile_get(ptx_stage_t stage, ptx_profile_stats_t* stats);
+
+/**
+ * @brief Clear a histogram
+ */
+void ptx_hist_reset(ptx_hist_t* hist);
+
+/**
+ * @brief Record one latency sample
+ */
+void ptx_hist_add(ptx_hist_t* hist, uint32_t latency_us);
+
+#if PTX_PROFILE_ENABLED
+#define PTX_PROFILE_BEGIN(stage)    ptx_profile_begin(stage)
+#define PTX_PROFILE_END(stage)      ptx_profile_end(stage)
+#else
+#define PTX_PROFILE_BEGIN(stage)    ((void)0)
+#define PTX_PROFILE_END(stage)      ((void)0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_PROFILE_H */
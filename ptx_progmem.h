@@ -0,0 +1,43 @@
+/**
+ * @file ptx_progmem.h
+ * @brief Flash (PROGMEM) storage helpers with a host fallback
+ * @details On AVR, constant tables must be placed in flash explicitly and read
+ *          back with pgm_read_*(). On other targets flash is ordinary memory.
+ *
+ *          String literals are copied to SRAM at startup on AVR unless they are
+ *          wrapped in PTX_PSTR() and read with the *_P functions below.
+ *          PTX_PRI_PSTR is the printf conversion for a PROGMEM string argument
+ *          ("%" PTX_PRI_PSTR).
+ */
+#ifndef PTX_PROGMEM_H
+#define PTX_PROGMEM_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+
+#define PTX_PROGMEM                 PROGMEM
+#define ptx_pgm_read_i32(addr)      ((int32_t)pgm_read_dword(addr))
+
+#define PTX_PSTR(s)                 PSTR(s)
+#define PTX_PRI_PSTR                "S"
+#define ptx_memcpy_P                memcpy_P
+#define ptx_strncmp_P               strncmp_P
+#define ptx_snprintf_P              snprintf_P
+#define ptx_vsnprintf_P             vsnprintf_P
+#else
+#define PTX_PROGMEM
+#define ptx_pgm_read_i32(addr)      (*(const int32_t*)(addr))
+
+#define PTX_PSTR(s)                 (s)
+#define PTX_PRI_PSTR                "s"
+#define ptx_memcpy_P                memcpy
+#define ptx_strncmp_P               strncmp
+#define ptx_snprintf_P              snprintf
+#define ptx_vsnprintf_P             vsnprintf
+#endif
+
+#endif /* PTX_PROGMEM_H */
@@ -0,0 +1,107 @@
+/**
+ * @file ptx_scheduler.cpp
+ * @brief Implementation of the deadline-driven cooperative scheduler
+ */
+#include "ptx_scheduler.h"
+#include <string.h>
+
+typedef struct {
+    ptx_task_fn_t fn;
+    uint32_t period_ms;
+    uint32_t release_ms;        /* Next release (absolute) */
+    uint32_t last_start_ms;     /* now_ms of the last run */
+    bool started;               /* Ran at least once */
+    ptx_sched_stats_t stats;
+} pti_task_t;
+
+static pti_task_t pti_tasks[PTX_SCHED_MAX_TASKS];
+static uint8_t pti_task_count = 0;
+
+// Wraparound-safe "a is at or after b"
+static inline bool pti_reached(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) >= 0;
+}
+
+static inline uint16_t pti_sat16(uint32_t v) {
+    return (v > 0xFFFFUL) ? 0xFFFFU : (uint16_t)v;
+}
+
+void ptx_sched_init(void) {
+    memset(pti_tasks, 0, sizeof(pti_tasks));
+    pti_task_count = 0;
+}
+
+int8_t ptx_sched_add(ptx_task_fn_t fn, uint32_t period_ms, uint32_t first_ms) {
+    if ((fn == NULL) || (period_ms == 0U) || (pti_task_count >= PTX_SCHED_MAX_TASKS)) {
+        return PTX_SCHED_INVALID;
+    }
+
+    pti_task_t* task = &pti_tasks[pti_task_count];
+    memset(task, 0, sizeof(*task));
+    task->fn = fn;
+    task->period_ms = period_ms;
+    task->release_ms = first_ms;
+
+    return (int8_t)pti_task_count++;
+}
+
+void ptx_sched_set_period(int8_t id, uint32_t period_ms) {
+    if ((id < 0) || ((uint8_t)id >= pti_task_count) || (period_ms == 0U)) return;
+
+    pti_task_t* task = &pti_tasks[id];
+    if (task->period_ms == period_ms) return;
+
+    /* Re-base on the last start: a late run must not make the first new-period release look missed */
+    task->period_ms = period_ms;
+    if (task->started) {
+        task->release_ms = task->last_start_ms + period_ms;
+    }
+}
+
+uint32_t ptx_sched_run(uint32_t now_ms) {
+    uint32_t wait_ms = UINT32_MAX;
+
+    for (uint8_t i = 0; i < pti_task_count; ++i) {
+        pti_task_t* task = &pti_tasks[i];
+
+        if (pti_reached(now_ms, task->release_ms)) {
+            uint32_t release = task->release_ms;
+            uint32_t lateness = now_ms - release;
+
+            /* Whole periods missed are skipped, keeping the release grid */
+            uint32_t missed = lateness / task->period_ms;
+            task->release_ms = release + (missed + 1U) * task->period_ms;
+            task->last_start_ms = now_ms;
+            task->started = true;
+
+            task->stats.runs++;
+            if (missed > 0U) {
+                task->stats.overruns = pti_sat16((uint32_t)task->stats.overruns + missed);
+            }
+            task->stats.last_lateness_ms = pti_sat16(lateness);
+            if (task->stats.last_lateness_ms > task->stats.max_lateness_ms) {
+                task->stats.max_lateness_ms = task->stats.last_lateness_ms;
+            }
+
+            task->fn(now_ms);
+        }
+
+        /* The task may have changed its own period */
+        uint32_t until = pti_reached(now_ms, task->release_ms) ? 0U : task->release_ms - now_ms;
+        if (until < wait_ms) wait_ms = until;
+    }
+
+    return (pti_task_count > 0U) ? wait_ms : 0U;
+}
+
+bool ptx_sched_get_stats(int8_t id, ptx_sched_stats_t* stats) {
+    if ((id < 0) || ((uint8_t)id >= pti_task_count)) return false;
+    *stats = pti_tasks[id].stats;
+    return true;
+}
+
+void ptx_sched_reset_stats(void) {
+    for (uint8_t i = 0; i < pti_task_count; ++i) {
+        memset(&pti_tasks[i].stats, 0, sizeof(pti_tasks[i].stats));
+    }
+}
@@ -0,0 +1,90 @@
+/**
+ * @file ptx_scheduler.h
+ * @brief Cooperative scheduler with absolute deadlines
+ * @details Each task has its own period. Its next release time is always the
+ *          previous release plus the period, never "now + period", so the
+ *          rate does not drift with execution time or with how long the
+ *          other tasks (or the serial port) took.
+ *
+ *          A task that is released late runs once and records the lateness
+ *          (jitter). If it is late by one whole period or more, the missed
+ *          releases are counted as overruns and skipped, not run back to back.
+ *
+ *          Times are millis() values; all comparisons are wraparound-safe.
+ */
+#ifndef PTX_SCHEDULER_H
+#define PTX_SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PTX_SCHED_MAX_TASKS     6U      // Size of the static task table
+#define PTX_SCHED_INVALID       (-1)    // Returned by ptx_sched_add() when the table is full
+
+/**
+ * @brief Task body
+ * @param now_ms Time the scheduler saw when it released the task
+ */
+typedef void (*ptx_task_fn_t)(uint32_t now_ms);
+
+/**
+ * @brief Per-task timing statistics
+ */
+typedef struct {
+    uint32_t runs;                  // Number of times the task ran
+    uint16_t overruns;              // Releases skipped because the task was a whole period late
+    uint16_t max_lateness_ms;       // Worst release-to-start delay seen (jitter)
+    uint16_t last_lateness_ms;      // Release-to-start delay of the last run
+} ptx_sched_stats_t;
+
+/**
+ * @brief Remove all tasks
+ */
+void ptx_sched_init(void);
+
+/**
+ * @brief Add a periodic task
+ * @param fn Task body
+ * @param period_ms Release period (> 0)
+ * @param first_ms Time of the first release
+ * @return Task id, or PTX_SCHED_INVALID if the table is full or the period is 0
+ * @note Tasks due at the same time run in the order they were added
+ */
+int8_t ptx_sched_add(ptx_task_fn_t fn, uint32_t period_ms, uint32_t first_ms);
+
+/**
+ * @brief Change a task period
+ * @details The next release becomes the start of the last run plus the new
+ *          period, so a run that was late does not count as an overrun of the
+ *          new period. A task that has not run yet keeps its first release.
+ *          A period of 0 is ignored.
+ */
+void ptx_sched_set_period(int8_t id, uint32_t period_ms);
+
+/**
+ * @brief Run every task whose release time has come
+ * @param now_ms Current millis()
+ * @return Milliseconds until the next release (0 if a task is already due)
+ */
+uint32_t ptx_sched_run(uint32_t now_ms);
+
+/**
+ * @brief Copy out a task's timing statistics
+ * @return false if id is not a valid task
+ */
+bool ptx_sched_get_stats(int8_t id, ptx_sched_stats_t* stats);
+
+/**
+ * @brief Clear all tasks' timing statistics
+ */
+void ptx_sched_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_SCHEDULER_H */
@@ -4,29 +4,260 @@
  */
 #include "ptx_sensor_filter.h"
 #include "api.h"
+#include "ptx_io.h"
+#include "ptx_adc_sampler.h"
 #include <string.h>
 
-void ptx_sensor_filter_init(uint8_t window_size) {
-	//@todo
+#if PTX_OVERSAMPLE_BITS > PTX_OVERSAMPLE_MAX_BITS
+#error "PTX_OVERSAMPLE_BITS must not exceed PTX_OVERSAMPLE_MAX_BITS"
+#endif
+
+/* Internal filter state */
+static ptx_sensor_filter_t pti_filter;
+
+/*
+ * Running median helpers.
+ * Heap positions are signed: 0 is the median, 1..min_count the min-heap of the
+ * upper half, -1..-max_count the max-heap of the lower half. Children of p are
+ * 2p and 2p+1 (2p-1 on the negative side), the parent of p is p/2.
+ */
+
+// Slot stored at heap position p
+#define PTI_HEAP(m, p) ((m)->heap[(m)->size / 2 + (p)])
+
+static inline int pti_min_count(const ptx_median_t* m) { return (m->count - 1) / 2; }
+static inline int pti_max_count(const ptx_median_t* m) { return m->count / 2; }
+
+// True if the sample at heap position i is smaller than the one at j
+static inline bool pti_less(const ptx_median_t* m, int i, int j) {
+    return m->data[PTI_HEAP(m, i)] < m->data[PTI_HEAP(m, j)];
 }
 
-ptx_sensor_reading_t ptx_sensor_filter_update(uint16_t raw_vref_mv, 
-                                                uint16_t raw_signal_mv) {
+// Swap heap positions i and j, keeping the slot->position index in sync
+static inline bool pti_exchange(ptx_median_t* m, int i, int j) {
+    uint8_t t = PTI_HEAP(m, i);
+    PTI_HEAP(m, i) = PTI_HEAP(m, j);
+    PTI_HEAP(m, j) = t;
+    m->pos[PTI_HEAP(m, i)] = (int8_t)i;
+    m->pos[PTI_HEAP(m, j)] = (int8_t)j;
+    return true;
+}
+
+// Swap i and j if sample i < sample j
+static inline bool pti_cmp_exchange(ptx_median_t* m, int i, int j) {
+    return pti_less(m, i, j) && pti_exchange(m, i, j);
+}
+
+// Restore the min-heap property from position i downwards
+static void pti_min_sort_down(ptx_median_t* m, int i) {
+    for (; i <= pti_min_count(m); i *= 2) {
+        if (i > 1 && i < pti_min_count(m) && pti_less(m, i + 1, i)) {
+            ++i;
+        }
+        if (!pti_cmp_exchange(m, i, i / 2)) {
+            break;
+        }
+    }
+}
+
+// Restore the max-heap property from position i downwards
+static void pti_max_sort_down(ptx_median_t* m, int i) {
+    for (; i >= -pti_max_count(m); i *= 2) {
+        if (i < -1 && i > -pti_max_count(m) && pti_less(m, i, i - 1)) {
+            --i;
+        }
+        if (!pti_cmp_exchange(m, i / 2, i)) {
+            break;
+        }
+    }
+}
+
+// Move position i up the min-heap; true if it became the median
+static bool pti_min_sort_up(ptx_median_t* m, int i) {
+    while (i > 0 && pti_cmp_exchange(m, i, i / 2)) {
+        i /= 2;
+    }
+    return i == 0;
+}
+
+// Move position i up the max-heap; true if it became the median
+static bool pti_max_sort_up(ptx_median_t* m, int i) {
+    while (i < 0 && pti_cmp_exchange(m, i / 2, i)) {
+        i /= 2;
+    }
+    return i == 0;
+}
+
+void ptx_median_init(ptx_median_t* m, uint8_t window_size) {
+    if (window_size == 0U) {
+        window_size = 1U;
+    } else if (window_size > PTX_SENSOR_FILTER_MAX_WINDOW) {
+        window_size = PTX_SENSOR_FILTER_MAX_WINDOW;
+    }
+
+    m->size = window_size;
+    ptx_median_reset(m);
+}
+
+void ptx_median_reset(ptx_median_t* m) {
+    memset(m->data, 0, sizeof(m->data));
+    m->idx = 0;
+    m->count = 0;
+
+    /* Initial fill pattern: median, max, min, max, min... keeps both heaps balanced while filling */
+    for (int k = 0; k < m->size; ++k) {
+        int p = ((k + 1) / 2) * ((k & 1) ? -1 : 1);
+        m->pos[k] = (int8_t)p;
+        PTI_HEAP(m, p) = (uint8_t)k;
+    }
+}
+
+void ptx_median_push(ptx_median_t* m, uint16_t sample) {
+    bool is_new = (m->count < m->size);
+    int p = m->pos[m->idx];
+    uint16_t old = m->data[m->idx];
+
+    m->data[m->idx] = sample;
+    m->idx = (uint8_t)((m->idx + 1U) % m->size);
+    if (is_new) {
+        m->count++;
+    }
+
+    if (p > 0) {
+        /* Slot is in the min-heap */
+        if (!is_new && old < sample) {
+            pti_min_sort_down(m, p * 2);
+        } else if (pti_min_sort_up(m, p)) {
+            pti_max_sort_down(m, -1);
+        }
+    } else if (p < 0) {
+        /* Slot is in the max-heap */
+        if (!is_new && sample < old) {
+            pti_max_sort_down(m, p * 2);
+        } else if (pti_max_sort_up(m, p)) {
+            pti_min_sort_down(m, 1);
+        }
+    } else {
+        /* Slot is the median */
+        if (pti_max_count(m) > 0) {
+            pti_max_sort_down(m, -1);
+        }
+        if (pti_min_count(m) > 0) {
+            pti_min_sort_down(m, 1);
+        }
+    }
+}
+
+uint16_t ptx_median_value(const ptx_median_t* m) {
+    if (m->count == 0U) {
+        return 0U;
+    }
+
+    uint16_t v = m->data[PTI_HEAP(m, 0)];
+    if ((m->count & 1U) == 0U) {
+        /* Even count: average the two middle samples */
+        v = (uint16_t)(((uint32_t)v + m->data[PTI_HEAP(m, -1)]) / 2U);
+    }
+    return v;
+}
+
+void ptx_sensor_filter_init_ctx(ptx_sensor_filter_t* filter, uint8_t window_size) {
+    ptx_median_init(&filter->vref, window_size);
+    ptx_median_init(&filter->signal, window_size);
+}
+
+void ptx_sensor_filter_reset_ctx(ptx_sensor_filter_t* filter) {
+    ptx_median_reset(&filter->vref);
+    ptx_median_reset(&filter->signal);
+}
+
+void ptx_decimator_init(ptx_decimator_t* d, uint8_t extra_bits) {
+    if (extra_bits > PTX_OVERSAMPLE_MAX_BITS) {
+        extra_bits = PTX_OVERSAMPLE_MAX_BITS;
+    }
+    d->vref_acc = 0;
+    d->signal_acc = 0;
+    d->count = 0;
+    d->bits = extra_bits;
+}
+
+bool ptx_decimator_push(ptx_decimator_t* d, uint16_t vref, uint16_t signal,
+                        uint16_t* vref_q, uint16_t* signal_q) {
+    d->vref_acc += vref;
+    d->signal_acc += signal;
+
+    /* 4^n = 1 << 2n pairs per output */
+    if (++d->count < (uint16_t)(1U << (2U * d->bits))) return false;
+
+    *vref_q = (uint16_t)(d->vref_acc >> d->bits);
+    *signal_q = (uint16_t)(d->signal_acc >> d->bits);
+    d->vref_acc = 0;
+    d->signal_acc = 0;
+    d->count = 0;
+    return true;
+}
+
+// Whole millivolts of a value with PTX_OVERSAMPLE_BITS fractional bits, rounded
+static inline uint16_t pti_round_q(uint16_t q) {
+#if PTX_OVERSAMPLE_BITS > 0
+    return (uint16_t)(((uint32_t)q + (1U << (PTX_OVERSAMPLE_BITS - 1U))) >> PTX_OVERSAMPLE_BITS);
+#else
+    return q;
+#endif
+}
+
+ptx_sensor_reading_t ptx_sensor_filter_update_q_ctx(ptx_sensor_filter_t* filter,
+                                                    uint16_t vref_mv_q,
+                                                    uint16_t signal_mv_q) {
     ptx_sensor_reading_t result = {0};
 
-	//@todo filter algorithm depend of configuration
-	result.vref_mv = raw_vref_mv;
-	result.signal_mv = raw_signal_mv;
-	result.valid = true;
-    
+    ptx_median_push(&filter->vref, vref_mv_q);
+    ptx_median_push(&filter->signal, signal_mv_q);
+
+	result.vref_mv_q = ptx_median_value(&filter->vref);
+	result.signal_mv_q = ptx_median_value(&filter->signal);
+	result.vref_mv = pti_round_q(result.vref_mv_q);
+	result.signal_mv = pti_round_q(result.signal_mv_q);
+	result.valid = (filter->signal.count >= filter->signal.size);
+
     return result;
 }
 
+ptx_sensor_reading_t ptx_sensor_filter_update_ctx(ptx_sensor_filter_t* filter,
+                                                  uint16_t raw_vref_mv,
+                                                  uint16_t raw_signal_mv) {
+    return ptx_sensor_filter_update_q_ctx(filter,
+                                          (uint16_t)(raw_vref_mv << PTX_OVERSAMPLE_BITS),
+                                          (uint16_t)(raw_signal_mv << PTX_OVERSAMPLE_BITS));
+}
+
+void ptx_sensor_filter_init(uint8_t window_size) {
+    ptx_sensor_filter_init_ctx(&pti_filter, window_size);
+}
+
+void ptx_sensor_filter_reset(void) {
+    ptx_sensor_filter_reset_ctx(&pti_filter);
+}
+
+ptx_sensor_reading_t ptx_sensor_filter_update(uint16_t raw_vref_mv,
+                                                uint16_t raw_signal_mv) {
+    return ptx_sensor_filter_update_ctx(&pti_filter, raw_vref_mv, raw_signal_mv);
+}
+
 ptx_sensor_reading_t ptx_sensor_filter_read_and_update(void) {
     /* Read raw sensor values from hardware */
-    uint16_t raw_vref_mv   = read_voltage(TEMPERATURE_SENSOR_REFERENCE);
-    uint16_t raw_signal_mv = read_voltage(TEMPERATURE_SENSOR);
-    
+#if PTX_ADC_SAMPLER_ENABLED
+    uint16_t vref_mv_q;
+    uint16_t signal_mv_q;
+    ptx_adc_sampler_read_mv_q(&vref_mv_q, &signal_mv_q);
+
+    /* Apply median filter */
+    return ptx_sensor_filter_update_q_ctx(&pti_filter, vref_mv_q, signal_mv_q);
+#else
+    uint16_t raw_vref_mv   = ptx_io_read_mv<TEMPERATURE_SENSOR_REFERENCE>();
+    uint16_t raw_signal_mv = ptx_io_read_mv<TEMPERATURE_SENSOR>();
+
     /* Apply median filter */
     return ptx_sensor_filter_update(raw_vref_mv, raw_signal_mv);
+#endif
 }
@@ -8,30 +8,180 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "ptx_adc_sampler.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#define PTX_OVERSAMPLE_MAX_BITS 3U      // 5.5 V in 1/8 mV still fits 16 bits
+
+/**
+ * @brief Extra resolution bits from oversampling and decimation
+ * @details n extra bits take 4^n samples per filtered sample: they are summed
+ *          and the sum shifted right by n. Filtered readings then carry n
+ *          fractional bits (vref_mv_q, signal_mv_q). The bits are only real if
+ *          the input noise spans at least one ADC count.
+ * @note Defaults to 2 with the ADC sampler (16 pairs per output, about 31
+ *       outputs a second at 1 kHz), 0 otherwise: one read per update gives
+ *       nothing to decimate.
+ */
+#ifndef PTX_OVERSAMPLE_BITS
+#if PTX_ADC_SAMPLER_ENABLED
+#define PTX_OVERSAMPLE_BITS 2U
+#else
+#define PTX_OVERSAMPLE_BITS 0U
+#endif
+#endif
+
+/**
+ * @brief Largest supported median window (samples per channel)
+ * @note Storage for this many samples is reserved statically, whatever window is configured.
+ */
+#ifndef PTX_SENSOR_FILTER_MAX_WINDOW
+#define PTX_SENSOR_FILTER_MAX_WINDOW 31U
+#endif
+
+/**
+ * @brief Sliding-window running median over uint16_t samples
+ * @details Samples live in a circular buffer. The buffer slots are kept in an
+ *          indexed double heap centred on the median: a max-heap of the lower
+ *          half at negative positions, a min-heap of the upper half at positive
+ *          positions and the median itself at position 0. Replacing the oldest
+ *          sample only sifts that one slot, so each push is O(log n).
+ */
+typedef struct {
+    uint16_t data[PTX_SENSOR_FILTER_MAX_WINDOW];    /**< Circular buffer of samples */
+    int8_t   pos[PTX_SENSOR_FILTER_MAX_WINDOW];     /**< Heap position of each buffer slot */
+    uint8_t  heap[PTX_SENSOR_FILTER_MAX_WINDOW];    /**< Buffer slot at each heap position, offset by size/2 */
+    uint8_t  size;                                  /**< Configured window length */
+    uint8_t  idx;                                   /**< Next buffer slot to overwrite (oldest sample) */
+    uint8_t  count;                                 /**< Number of samples currently held */
+} ptx_median_t;
+
+/**
+ * @brief Median filter state for both sensor channels
+ */
+typedef struct {
+    ptx_median_t vref;          /**< Reference voltage channel */
+    ptx_median_t signal;        /**< Signal voltage channel */
+} ptx_sensor_filter_t;
+
 /**
  * @brief Filtered sensor readings
  */
 typedef struct {
-    uint16_t vref_mv;           /**< Filtered reference voltage (mV) */
-    uint16_t signal_mv;         /**< Filtered signal voltage (mV) */
+    uint16_t vref_mv;           /**< Filtered reference voltage (mV, rounded) */
+    uint16_t signal_mv;         /**< Filtered signal voltage (mV, rounded) */
     bool     valid;             /**< True if filter has enough samples */
+    uint16_t vref_mv_q;         /**< Filtered reference voltage (mV << PTX_OVERSAMPLE_BITS) */
+    uint16_t signal_mv_q;       /**< Filtered signal voltage (mV << PTX_OVERSAMPLE_BITS) */
 } ptx_sensor_reading_t;
 
+/**
+ * @brief 4^n oversampling and decimation of both sensor channels
+ * @details Integer only: each output is the sum of 4^n input pairs shifted
+ *          right by n, i.e. the input scaled by 2^n with n fractional bits.
+ */
+typedef struct {
+    uint32_t vref_acc;          /**< Reference samples summed since the last output */
+    uint32_t signal_acc;        /**< Signal samples summed since the last output */
+    uint16_t count;             /**< Pairs in the sums */
+    uint8_t  bits;              /**< Extra bits n */
+} ptx_decimator_t;
+
+/**
+ * @brief Initialize a decimator
+ * @param d Decimator state
+ * @param extra_bits Extra bits n, clamped to PTX_OVERSAMPLE_MAX_BITS; 0 passes samples through
+ */
+void ptx_decimator_init(ptx_decimator_t* d, uint8_t extra_bits);
+
+/**
+ * @brief Add one sample pair
+ * @param d Decimator state
+ * @param vref Reference sample
+ * @param signal Signal sample
+ * @param vref_q Output: decimated reference, set when the function returns true
+ * @param signal_q Output: decimated signal, set when the function returns true
+ * @return true every 4^n pairs, when an output is ready
+ */
+bool ptx_decimator_push(ptx_decimator_t* d, uint16_t vref, uint16_t signal,
+                        uint16_t* vref_q, uint16_t* signal_q);
+
+/**
+ * @brief Initialize a running median
+ * @param m Median state
+ * @param window_size Window length, clamped to [1, PTX_SENSOR_FILTER_MAX_WINDOW]
+ */
+void ptx_median_init(ptx_median_t* m, uint8_t window_size);
+
+/**
+ * @brief Drop all samples while keeping the window length
+ * @param m Median state
+ */
+void ptx_median_reset(ptx_median_t* m);
+
+/**
+ * @brief Push a sample, replacing the oldest one once the window is full
+ * @param m Median state
+ * @param sample New sample
+ * @note O(log window_size)
+ */
+void ptx_median_push(ptx_median_t* m, uint16_t sample);
+
+/**
+ * @brief Current median of the samples held
+ * @param m Median state
+ * @return Median, mean of the two middle samples for an even count, 0 when empty
+ */
+uint16_t ptx_median_value(const ptx_median_t* m);
+
+/**
+ * @brief Initialize the sensor filter
+ * @param window_size Median window length per channel (1..PTX_SENSOR_FILTER_MAX_WINDOW)
+ */
 void ptx_sensor_filter_init(uint8_t window_size);
+
+/**
+ * @brief Drop all buffered samples, keeping the configured window
+ */
 void ptx_sensor_filter_reset(void);
 
+/**
+ * @brief Push one raw sample per channel through the median filter
+ * @param raw_vref_mv Raw reference voltage (mV)
+ * @param raw_signal_mv Raw signal voltage (mV)
+ * @return Filtered sensor reading
+ * @note The median is taken over the samples received so far until the window
+ *       fills up; valid turns true once it is full.
+ */
+ptx_sensor_reading_t ptx_sensor_filter_update(uint16_t raw_vref_mv, uint16_t raw_signal_mv);
+
 /**
  * @brief Read sensors from hardware and apply median filtering
  * @return Filtered sensor reading
- * @note Call this once per control update cycle
+ * @note Call this once per control update cycle. With PTX_ADC_SAMPLER_ENABLED
+ *       the raw sample is the mean of the sampler's decimated outputs since
+ *       the last call.
  */
 ptx_sensor_reading_t ptx_sensor_filter_read_and_update(void);
 
+/*
+ * Per-instance variants; the functions above operate on one module-level filter.
+ */
+void ptx_sensor_filter_init_ctx(ptx_sensor_filter_t* filter, uint8_t window_size);
+void ptx_sensor_filter_reset_ctx(ptx_sensor_filter_t* filter);
+ptx_sensor_reading_t ptx_sensor_filter_update_ctx(ptx_sensor_filter_t* filter,
+                                                  uint16_t raw_vref_mv, uint16_t raw_signal_mv);
+
+/**
+ * @brief Push one sample per channel that already carries PTX_OVERSAMPLE_BITS fractional bits
+ * @note ptx_sensor_filter_update_ctx() is this with whole millivolts shifted up.
+ */
+ptx_sensor_reading_t ptx_sensor_filter_update_q_ctx(ptx_sensor_filter_t* filter,
+                                                    uint16_t vref_mv_q, uint16_t signal_mv_q);
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,172 @@
+/**
+ * @file ptx_serial_tx.cpp
+ * @brief Implementation of the non-blocking serial transmit queue
+ */
+#include "ptx_serial_tx.h"
+#include "ptx_critical.h"
+#include "ptx_progmem.h"
+#include <string.h>
+
+#if (PTX_SERIAL_TX_SIZE & (PTX_SERIAL_TX_SIZE - 1U)) != 0U || PTX_SERIAL_TX_SIZE > 32768U
+#error "PTX_SERIAL_TX_SIZE must be a power of two no larger than 32768"
+#endif
+
+#define PTI_TX_MASK         (PTX_SERIAL_TX_SIZE - 1U)
+#define PTI_DROP_NOTICE_MAX 24U
+
+/* Fill limit per priority: space above it is reserved for higher priorities */
+static const uint16_t pti_fill_limit[PTX_TX_PRIO_COUNT] = {
+    PTX_SERIAL_TX_SIZE / 2U,            /* PTX_TX_PRIO_LOW */
+    (PTX_SERIAL_TX_SIZE / 4U) * 3U,     /* PTX_TX_PRIO_NORMAL */
+    PTX_SERIAL_TX_SIZE,                 /* PTX_TX_PRIO_HIGH */
+};
+
+/* Free-running indices; used bytes = head - tail */
+static uint8_t pti_tx_buf[PTX_SERIAL_TX_SIZE];
+static volatile uint16_t pti_head = 0;
+static volatile uint16_t pti_tail = 0;
+
+static ptx_serial_tx_stats_t pti_stats;
+static uint16_t pti_pending_drops = 0;     /* Drops not yet reported in the stream */
+
+// Copy bytes in at the head; caller checked the space
+static void pti_push(const uint8_t* data, uint16_t len) {
+    uint16_t head = pti_head;
+    uint16_t start = head & PTI_TX_MASK;
+    uint16_t first = (uint16_t)(PTX_SERIAL_TX_SIZE - start);
+    if (first > len) first = len;
+
+    memcpy(&pti_tx_buf[start], data, first);
+    memcpy(&pti_tx_buf[0], data + first, (size_t)(len - first));
+    pti_head = (uint16_t)(head + len);
+}
+
+// Build "[tx] dropped N\r\n"; returns its length
+static uint16_t pti_format_drop_notice(char* out, uint16_t drops) {
+    static const char prefix[] PTX_PROGMEM = "[tx] dropped ";
+    char digits[5];
+    uint8_t n = 0;
+    uint16_t len = sizeof(prefix) - 1U;
+
+    ptx_memcpy_P(out, prefix, len);
+    do {
+        digits[n++] = (char)('0' + (drops % 10U));
+        drops /= 10U;
+    } while (drops > 0U);
+    while (n > 0U) {
+        out[len++] = digits[--n];
+    }
+    out[len++] = '\r';
+    out[len++] = '\n';
+    return len;
+}
+
+void ptx_serial_tx_reset(void) {
+    ptx_irq_state_t irq = ptx_irq_save();
+    pti_head = 0;
+    pti_tail = 0;
+    pti_pending_drops = 0;
+    memset(&pti_stats, 0, sizeof(pti_stats));
+    ptx_irq_restore(irq);
+}
+
+bool ptx_serial_tx_write(const char* data, uint16_t len, ptx_tx_prio_t prio) {
+    char notice[PTI_DROP_NOTICE_MAX];
+    uint16_t notice_len = 0;
+    bool queued = false;
+
+    if ((unsigned)prio >= PTX_TX_PRIO_COUNT) {
+        prio = PTX_TX_PRIO_NORMAL;
+    }
+
+    ptx_irq_state_t irq = ptx_irq_save();
+    uint16_t used = (uint16_t)(pti_head - pti_tail);
+    uint16_t limit = pti_fill_limit[prio];
+
+    if (pti_pending_drops > 0U) {
+        notice_len = pti_format_drop_notice(notice, pti_pending_drops);
+    }
+
+    if ((uint32_t)used + notice_len + len <= limit) {
+        /* Report earlier drops first, so the gap is visible where it happened */
+        if (notice_len > 0U) {
+            pti_push((const uint8_t*)notice, notice_len);
+            pti_stats.queued_bytes += notice_len;
+            pti_pending_drops = 0;
+        }
+        queued = true;
+    } else if ((uint32_t)used + len <= limit) {
+        /* No room for the notice yet; keep it pending */
+        queued = true;
+    }
+
+    if (queued) {
+        pti_push((const uint8_t*)data, len);
+        pti_stats.queued_bytes += len;
+        used = (uint16_t)(pti_head - pti_tail);
+        if (used > pti_stats.high_water) {
+            pti_stats.high_water = used;
+        }
+    } else {
+        pti_stats.dropped_bytes += len;
+        pti_stats.dropped_msgs[prio]++;
+        if (pti_pending_drops < 0xFFFFU) {
+            pti_pending_drops++;
+        }
+    }
+    ptx_irq_restore(irq);
+
+    return queued;
+}
+
+uint16_t ptx_serial_tx_room(ptx_tx_prio_t prio) {
+    if ((unsigned)prio >= PTX_TX_PRIO_COUNT) {
+        prio = PTX_TX_PRIO_NORMAL;
+    }
+
+    ptx_irq_state_t irq = ptx_irq_save();
+    uint16_t used = (uint16_t)(pti_head - pti_tail);
+    ptx_irq_restore(irq);
+
+    uint16_t limit = pti_fill_limit[prio];
+    return (used < limit) ? (uint16_t)(limit - used) : 0U;
+}
+
+uint16_t ptx_serial_tx_peek(const uint8_t** data) {
+    ptx_irq_state_t irq = ptx_irq_save();
+    uint16_t head = pti_head;
+    ptx_irq_restore(irq);
+
+    uint16_t tail = pti_tail;
+    uint16_t used = (uint16_t)(head - tail);
+    uint16_t start = tail & PTI_TX_MASK;
+    uint16_t contiguous = (uint16_t)(PTX_SERIAL_TX_SIZE - start);
+
+    *data = &pti_tx_buf[start];
+    return (used < contiguous) ? used : contiguous;
+}
+
+void ptx_serial_tx_consume(uint16_t count) {
+    ptx_irq_state_t irq = ptx_irq_save();
+    pti_tail = (uint16_t)(pti_tail + count);
+    ptx_irq_restore(irq);
+}
+
+uint16_t ptx_serial_tx_used(void) {
+    ptx_irq_state_t irq = ptx_irq_save();
+    uint16_t used = (uint16_t)(pti_head - pti_tail);
+    ptx_irq_restore(irq);
+    return used;
+}
+
+void ptx_serial_tx_get_stats(ptx_serial_tx_stats_t* stats) {
+    ptx_irq_state_t irq = ptx_irq_save();
+    *stats = pti_stats;
+    ptx_irq_restore(irq);
+}
+
+void ptx_serial_tx_reset_stats(void) {
+    ptx_irq_state_t irq = ptx_irq_save();
+    memset(&pti_stats, 0, sizeof(pti_stats));
+    ptx_irq_restore(irq);
+}
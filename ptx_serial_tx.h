@@ -0,0 +1,112 @@
+/**
+ * @file ptx_serial_tx.h
+ * @brief Non-blocking serial transmit queue with priority-based backpressure
+ * @details Every byte sent to the serial port (log lines, serial_printf(),
+ *          deferred log records) goes through this queue. Writers never wait:
+ *          a message is queued whole or dropped whole. serial_service() moves
+ *          bytes to the UART only as fast as its hardware buffer accepts them.
+ *
+ *          Backpressure policy: each priority may only fill the queue up to a
+ *          limit, so the space above it stays reserved for more important
+ *          messages.
+ *            PTX_TX_PRIO_LOW     periodic status, up to 1/2 of the queue
+ *            PTX_TX_PRIO_NORMAL  events, up to 3/4 of the queue
+ *            PTX_TX_PRIO_HIGH    [ERROR]/[WARNING], the whole queue
+ *          Dropped messages are counted and coalesced into a single
+ *          "[tx] dropped N" line that is queued ahead of the next accepted message.
+ */
+#ifndef PTX_SERIAL_TX_H
+#define PTX_SERIAL_TX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Queue capacity in bytes (power of two)
+ */
+#ifndef PTX_SERIAL_TX_SIZE
+#if defined(__AVR__)
+#define PTX_SERIAL_TX_SIZE 256U
+#else
+#define PTX_SERIAL_TX_SIZE 2048U
+#endif
+#endif
+
+/**
+ * @brief Message priority, lowest first
+ */
+typedef enum {
+    PTX_TX_PRIO_LOW = 0,        // Periodic status: first to be dropped
+    PTX_TX_PRIO_NORMAL,         // Regular events
+    PTX_TX_PRIO_HIGH,           // Errors and warnings
+    PTX_TX_PRIO_COUNT
+} ptx_tx_prio_t;
+
+/**
+ * @brief Transmit statistics
+ */
+typedef struct {
+    uint32_t queued_bytes;                      // Bytes accepted into the queue
+    uint32_t dropped_bytes;                     // Bytes of dropped messages
+    uint16_t dropped_msgs[PTX_TX_PRIO_COUNT];   // Dropped messages per priority
+    uint16_t high_water;                        // Most bytes ever waiting in the queue
+} ptx_serial_tx_stats_t;
+
+/**
+ * @brief Empty the queue and clear statistics
+ */
+void ptx_serial_tx_reset(void);
+
+/**
+ * @brief Queue a complete message
+ * @param data Message bytes
+ * @param len Message length
+ * @param prio Message priority
+ * @return true if queued, false if dropped by the backpressure policy
+ * @note Never blocks; safe to call from interrupt context
+ */
+bool ptx_serial_tx_write(const char* data, uint16_t len, ptx_tx_prio_t prio);
+
+/**
+ * @brief Bytes a message of the given priority may still queue
+ * @note Lets a producer that can hold on to its data wait instead of dropping
+ */
+uint16_t ptx_serial_tx_room(ptx_tx_prio_t prio);
+
+/**
+ * @brief Get the queued bytes that are contiguous in memory
+ * @param data Set to the first queued byte
+ * @return Number of contiguous queued bytes (0 if empty)
+ * @note Single consumer only (serial_service())
+ */
+uint16_t ptx_serial_tx_peek(const uint8_t** data);
+
+/**
+ * @brief Release bytes returned by ptx_serial_tx_peek() once sent
+ */
+void ptx_serial_tx_consume(uint16_t count);
+
+/**
+ * @brief Number of bytes waiting to be sent
+ */
+uint16_t ptx_serial_tx_used(void);
+
+/**
+ * @brief Copy out the transmit statistics
+ */
+void ptx_serial_tx_get_stats(ptx_serial_tx_stats_t* stats);
+
+/**
+ * @brief Clear the transmit statistics
+ */
+void ptx_serial_tx_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_SERIAL_TX_H */
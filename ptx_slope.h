@@ -0,0 +1,91 @@
+/**
+ * @file ptx_slope.h
+ * @brief Incremental least-squares slope of a sampled signal
+ * @details Keeps the five running sums of an ordinary least-squares line fit,
+ *          so adding a sample and testing the slope are O(1) and need no
+ *          sample history. The slope test is a cross-multiplication, with no
+ *          division.
+ *
+ *          Times are ms since the first sample and values are relative to it
+ *          (e.g. m°C above the starting temperature). Samples past
+ *          PTX_SLOPE_MAX_SAMPLES or PTX_SLOPE_MAX_T_MS are not fitted, and
+ *          values are clamped to ±PTX_SLOPE_MAX_ABS_Y, so the 64-bit products
+ *          of the slope test cannot overflow whatever the window and period.
+ */
+#ifndef PTX_SLOPE_H
+#define PTX_SLOPE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PTX_SLOPE_MAX_SAMPLES   255U        // Samples fitted, later ones ignored
+#define PTX_SLOPE_MAX_T_MS      60000L      // Samples later than this are ignored (ms)
+#define PTX_SLOPE_MAX_ABS_Y     400000L     // Values clamped to this magnitude (m°C: 400 °C)
+#define PTX_SLOPE_MAX_RATE      30000L      // Largest |rate_per_s| for ptx_slope_at_least()
+
+/* Worst cases of num * 1000 and rate * den in the slope test */
+static_assert((int64_t)PTX_SLOPE_MAX_SAMPLES * PTX_SLOPE_MAX_SAMPLES * PTX_SLOPE_MAX_T_MS *
+              PTX_SLOPE_MAX_ABS_Y <= INT64_MAX / 2000, "slope numerator overflows int64");
+static_assert((int64_t)PTX_SLOPE_MAX_SAMPLES * PTX_SLOPE_MAX_SAMPLES * PTX_SLOPE_MAX_T_MS *
+              PTX_SLOPE_MAX_T_MS <= INT64_MAX / PTX_SLOPE_MAX_RATE, "slope denominator overflows int64");
+
+typedef struct {
+    uint16_t n;                 // Samples
+    int64_t  sum_t;             // Σt (ms)
+    int64_t  sum_tt;            // Σt²
+    int64_t  sum_y;             // Σy
+    int64_t  sum_ty;            // Σt·y
+} ptx_slope_t;
+
+static inline void ptx_slope_reset(ptx_slope_t* s) {
+    s->n = 0;
+    s->sum_t = 0;
+    s->sum_tt = 0;
+    s->sum_y = 0;
+    s->sum_ty = 0;
+}
+
+static inline void ptx_slope_add(ptx_slope_t* s, uint32_t t_ms, int32_t y) {
+    if ((s->n >= PTX_SLOPE_MAX_SAMPLES) || (t_ms > (uint32_t)PTX_SLOPE_MAX_T_MS)) return;
+    if (y > PTX_SLOPE_MAX_ABS_Y) y = PTX_SLOPE_MAX_ABS_Y;
+    if (y < -PTX_SLOPE_MAX_ABS_Y) y = -PTX_SLOPE_MAX_ABS_Y;
+
+    s->n++;
+    s->sum_t += t_ms;
+    s->sum_tt += (int64_t)t_ms * t_ms;
+    s->sum_y += y;
+    s->sum_ty += (int64_t)t_ms * y;
+}
+
+/**
+ * @brief True if the fitted slope is at least rate_per_s (value units per second)
+ * @param rate_per_s At most PTX_SLOPE_MAX_RATE in magnitude
+ * @note False with fewer than two distinct sample times.
+ */
+static inline bool ptx_slope_at_least(const ptx_slope_t* s, int32_t rate_per_s) {
+    int64_t den = (int64_t)s->n * s->sum_tt - s->sum_t * s->sum_t;     /* ms² */
+    int64_t num = (int64_t)s->n * s->sum_ty - s->sum_t * s->sum_y;     /* value·ms */
+    if (den <= 0) return false;
+    return num * 1000 >= (int64_t)rate_per_s * den;
+}
+
+/**
+ * @brief Fitted slope in value units per second (0 with fewer than two distinct times)
+ * @note One 64-bit division: for reporting, not for the per-sample test.
+ */
+static inline int32_t ptx_slope_per_s(const ptx_slope_t* s) {
+    int64_t den = (int64_t)s->n * s->sum_tt - s->sum_t * s->sum_t;
+    int64_t num = (int64_t)s->n * s->sum_ty - s->sum_t * s->sum_y;
+    if (den <= 0) return 0;
+    return (int32_t)(num * 1000 / den);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_SLOPE_H */
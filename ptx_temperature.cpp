@@ -0,0 +1,56 @@
+/**
+ * @file ptx_temperature.cpp
+ * @brief Implementation of float and fixed-point temperature conversion
+ */
+#include "ptx_temperature.h"
+
+float ptx_temp_compute_c(const ptx_cal_table_t* cal, float vref_mv, float signal_mv) {
+
+	/* Valid signal window is 10%..90% of vref */
+    float low = 0.10f * vref_mv;
+    float high = 0.90f * vref_mv;
+
+    /* Handle exception */
+    if (signal_mv <= low) return ptx_cal_temp_min_mc(cal) / 1000.0f;
+    if (signal_mv >= high) return ptx_cal_temp_max_mc(cal) / 1000.0f;
+
+    // Normalize voltage
+    float x = signal_mv / vref_mv; // fraction of Vref
+
+    // Look up the probe curve
+    return ptx_cal_lookup_c(cal, x);
+}
+
+void ptx_temp_recip_reset(ptx_temp_recip_t* cache) {
+    cache->vref_mv = 0;
+    cache->recip = 0;
+}
+
+int32_t ptx_temp_compute_mc(const ptx_cal_table_t* cal, ptx_temp_recip_t* cache,
+                            uint16_t vref_mv, uint16_t signal_mv) {
+    uint32_t s100 = (uint32_t)signal_mv * 100U;
+
+    /* Handle exception: same saturation as the float path, compared exactly */
+    if (s100 <= (uint32_t)vref_mv * PTX_SIGNAL_MIN_PCT) return ptx_cal_temp_min_mc(cal);
+    if (s100 >= (uint32_t)vref_mv * PTX_SIGNAL_MAX_PCT) return ptx_cal_temp_max_mc(cal);
+
+    /* signal < 0.9 * vref, so the Q32 ratio does not saturate */
+    return ptx_cal_lookup_mc(cal, ptx_temp_ratio_q32(cache, vref_mv, signal_mv));
+}
+
+uint32_t ptx_temp_ratio_q32(ptx_temp_recip_t* cache, uint16_t vref_mv, uint16_t signal_mv) {
+    if (signal_mv >= vref_mv) return 0xFFFFFFFFUL;
+
+    /* Filtered vref barely moves, so the division is almost never taken */
+    if (cache->vref_mv != vref_mv) {
+        cache->vref_mv = vref_mv;
+        cache->recip = 0xFFFFFFFFUL / vref_mv;
+    }
+    return (uint32_t)signal_mv * cache->recip;
+}
+
+bool ptx_temp_signal_in_range(uint16_t vref_mv, uint16_t signal_mv) {
+    uint32_t s100 = (uint32_t)signal_mv * 100U;
+    return (s100 >= (uint32_t)vref_mv * PTX_SIGNAL_MIN_PCT) &&
+           (s100 <= (uint32_t)vref_mv * PTX_SIGNAL_MAX_PCT);
+}
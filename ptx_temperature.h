@@ -0,0 +1,98 @@
+/**
+ * @file ptx_temperature.h
+ * @brief Sensor range checks and ratio to temperature conversion
+ * @details Provides a float implementation and an integer-only implementation
+ *          (millidegrees, no division in steady state) of the same conversion.
+ *          PTX_FIXED_POINT selects which one the controller runs; both are always
+ *          built so they can be checked against each other on the host. The
+ *          probe curve itself comes from a calibration table (ptx_calibration.h).
+ *
+ *          Agreement: inside the valid signal window the fixed-point result is
+ *          within 2 m°C (0.002 °C) of the float result. Range checks agree
+ *          except for readings that fall exactly on a 10% / 90% boundary, where
+ *          the integer check is exact and the float one depends on rounding of 0.1f.
+ */
+#ifndef PTX_TEMPERATURE_H
+#define PTX_TEMPERATURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ptx_calibration.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Select the integer-only controller pipeline
+ * @note Defaults to 1 on AVR (no FPU, every float op is a library call), 0 elsewhere.
+ */
+#ifndef PTX_FIXED_POINT
+#if defined(__AVR__)
+#define PTX_FIXED_POINT 1
+#else
+#define PTX_FIXED_POINT 0
+#endif
+#endif
+
+#define PTX_SIGNAL_MIN_PCT      10          // Signal must be >= 10% of vref
+#define PTX_SIGNAL_MAX_PCT      90          // Signal must be <= 90% of vref
+
+/* Saturation values of the nominal probe curve */
+#define PTX_TEMP_MIN_C          (-10.0f)    // At/below 10% of vref
+#define PTX_TEMP_MAX_C          300.0f      // At/above 90% of vref
+#define PTX_TEMP_MIN_MC         (-10000L)
+#define PTX_TEMP_MAX_MC         300000L
+
+/**
+ * @brief Cached reciprocal of the (slowly varying) filtered vref
+ */
+typedef struct {
+    uint16_t vref_mv;           /**< vref the reciprocal was computed for */
+    uint32_t recip;             /**< floor((2^32 - 1) / vref_mv) */
+} ptx_temp_recip_t;
+
+/**
+ * @brief Float conversion of a sensor reading to temperature
+ * @param cal Calibration table of the probe
+ * @param vref_mv Reference voltage (mV)
+ * @param signal_mv Signal voltage (mV)
+ * @return Temperature (°C), saturated to the table values at the signal limits
+ */
+float ptx_temp_compute_c(const ptx_cal_table_t* cal, float vref_mv, float signal_mv);
+
+/**
+ * @brief Integer conversion of a sensor reading to temperature
+ * @param cal Calibration table of the probe
+ * @param cache Reciprocal cache; a 32-bit division only happens when vref changes
+ * @param vref_mv Reference voltage (mV)
+ * @param signal_mv Signal voltage (mV)
+ * @return Temperature (m°C), saturated to the table values at the signal limits
+ * @note Only the ratio matters: both inputs may carry the same fractional bits
+ *       (mV << PTX_OVERSAMPLE_BITS), up to 16 bits.
+ */
+int32_t ptx_temp_compute_mc(const ptx_cal_table_t* cal, ptx_temp_recip_t* cache,
+                            uint16_t vref_mv, uint16_t signal_mv);
+
+/**
+ * @brief Reset a reciprocal cache so the next conversion recomputes it
+ */
+void ptx_temp_recip_reset(ptx_temp_recip_t* cache);
+
+/**
+ * @brief signal/vref in Q0.32 through the reciprocal cache
+ * @return Ratio, 0xFFFFFFFF if signal >= vref
+ */
+uint32_t ptx_temp_ratio_q32(ptx_temp_recip_t* cache, uint16_t vref_mv, uint16_t signal_mv);
+
+/**
+ * @brief Integer check of the signal window
+ * @return true if PTX_SIGNAL_MIN_PCT% <= signal/vref <= PTX_SIGNAL_MAX_PCT%
+ */
+bool ptx_temp_signal_in_range(uint16_t vref_mv, uint16_t signal_mv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_TEMPERATURE_H */
@@ -0,0 +1,112 @@
+/**
+ * @file ptx_trace.h
+ * @brief Binary trace of the single-oven controller: raw inputs, door edges, commands
+ * @details A trace is a ptx_trace_header_t followed by an array of
+ *          ptx_trace_record_t. Both have a fixed size and the same layout on
+ *          AVR and on hosts (little-endian, 4-byte fields 4-byte aligned, no
+ *          implicit padding), so a capture can be memory-mapped and indexed
+ *          directly, with no parsing.
+ *
+ *          Records are produced by ptx_oven_control_update() while a sink is
+ *          set (ptx_oven_set_trace_sink()):
+ *          - PTX_TRACE_DOOR for each door edge drained from the event queue,
+ *            before the update that acts on it;
+ *          - PTX_TRACE_UPDATE once per update: millis(), the two readings the
+ *            update filtered (mV << oversample_bits, from the ADC sampler when
+ *            it is enabled), the door level and the output commands that
+ *            update produced.
+ *
+ *          A capture starts right after ptx_oven_control_init(); the header
+ *          holds the configuration but no controller state. Replaying the DOOR
+ *          edges and UPDATE inputs in order through a freshly initialized
+ *          controller with the same configuration reproduces every command
+ *          (tests/replay/ptx_replay.h).
+ */
+#ifndef PTX_TRACE_H
+#define PTX_TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Compile the recorder into ptx_oven_control_update()
+ * @note Defaults to 0 on AVR (no call or branch added), 1 elsewhere.
+ */
+#ifndef PTX_TRACE_ENABLED
+#if defined(__AVR__)
+#define PTX_TRACE_ENABLED 0
+#else
+#define PTX_TRACE_ENABLED 1
+#endif
+#endif
+
+#define PTX_TRACE_MAGIC         0x54585450UL    // "PTXT"
+#define PTX_TRACE_VERSION       2U      // 2: readings with fractional bits
+
+/* Record kinds */
+#define PTX_TRACE_UPDATE        1U
+#define PTX_TRACE_DOOR          2U
+
+/* Record flags */
+#define PTX_TRACE_DOOR_OPEN     0x01U       // Door level (UPDATE: as used by the update; DOOR: the edge)
+#define PTX_TRACE_GAS           0x02U       // Gas valve command after the update
+#define PTX_TRACE_IGNITER       0x04U       // Igniter command after the update
+#define PTX_TRACE_LED           0x08U       // System LED after the update
+
+/**
+ * @brief Trace file header: format and the configuration in effect at start
+ */
+typedef struct {
+    uint32_t magic;                     // PTX_TRACE_MAGIC
+    uint16_t version;                   // PTX_TRACE_VERSION
+    uint16_t record_size;               // sizeof(ptx_trace_record_t)
+    uint32_t start_ms;                  // millis() when recording started
+
+    /* ptx_oven_config_t, field by field */
+    uint32_t ignition_duration_ms;
+    uint32_t periodic_log_ms;
+    uint32_t sensor_fault_window_ms;
+    uint32_t auto_resume_delay_ms;
+    float    vref_min_v;
+    float    vref_max_v;
+    float    temp_target_c;
+    float    temp_delta_c;
+    uint16_t iteration_period;
+    uint8_t  max_ignition_attempts;
+    uint8_t  probe_profile;
+
+    uint8_t  oversample_bits;           // PTX_OVERSAMPLE_BITS of the readings
+    uint8_t  reserved[3];               // 0
+} ptx_trace_header_t;
+
+/**
+ * @brief One trace record
+ */
+typedef struct {
+    uint32_t time;                      // UPDATE: millis(); DOOR: micros() of the edge
+    uint16_t vref_mv_q;                 // UPDATE: reference reading (mV << oversample_bits)
+    uint16_t signal_mv_q;               // UPDATE: signal reading (mV << oversample_bits)
+    uint8_t  kind;                      // PTX_TRACE_UPDATE or PTX_TRACE_DOOR
+    uint8_t  flags;                     // PTX_TRACE_* flags
+    uint16_t reserved;                  // 0
+} ptx_trace_record_t;
+
+#ifdef __cplusplus
+static_assert(sizeof(ptx_trace_header_t) == 52, "trace header layout is part of the file format");
+static_assert(sizeof(ptx_trace_record_t) == 12, "trace record layout is part of the file format");
+#endif
+
+/**
+ * @brief Receives each record as it is produced (main loop context)
+ */
+typedef void (*ptx_trace_sink_fn)(void* user, const ptx_trace_record_t* record);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_TRACE_H */
@@ -0,0 +1,181 @@
+/**
+ * @file bench_oven_control.cpp
+ * @brief Google Benchmark microbenchmarks of the control loop hot path
+ * @details Inputs come from the plant simulator, so the readings look like a
+ *          real probe: steady at the target, noisy, a storm of out-of-range
+ *          readings, or steady with the door toggling. The real logging is
+ *          linked in, so ptx_logf() formats and queues every line; the TX
+ *          queue is emptied after each call, as if Serial kept up.
+ *
+ *          Run with --benchmark_format=json (or the oven_control_bench_json
+ *          target) to track ns per update across releases.
+ */
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "ptx_oven_control.h"
+#include "ptx_oven_config.h"
+#include "ptx_sensor_filter.h"
+#include "ptx_temperature.h"
+#include "ptx_calibration.h"
+#include "ptx_event_queue.h"
+#include "ptx_serial_tx.h"
+#include "ptx_logging.h"
+#include "tests/sim/ptx_sim.h"
+#include "tests/mocks/mock_api.h"
+
+#define PTI_BENCH_SAMPLES   4096U   // Input pattern length (power of two)
+
+typedef enum {
+    PTI_SCENARIO_STEADY = 0,        // At the target, noise-free
+    PTI_SCENARIO_NOISY,             // At the target, 8 mV probe noise
+    PTI_SCENARIO_FAULT_STORM,       // Bursts of out-of-range vref and signal
+    PTI_SCENARIO_DOOR,              // Steady, door toggling every 20 updates
+} pti_scenario_t;
+
+typedef struct {
+    std::vector<uint16_t> vref_mv;
+    std::vector<uint16_t> signal_mv;
+    uint32_t next;
+} pti_bench_inputs_t;
+
+// Sample pattern of a scenario, from the simulated probe
+static void pti_bench_make_inputs(pti_bench_inputs_t* in, pti_scenario_t scenario) {
+    ptx_sim_params_t p;
+    ptx_sim_default_params(&p);
+    p.noise_mv = (scenario == PTI_SCENARIO_NOISY) ? 8.0 : 0.0;
+    ptx_sim_t sim;
+    ptx_sim_init(&sim, &p, 0);
+    sim.temp_c = ptx_oven_get_config()->temp_target_c;
+
+    in->vref_mv.resize(PTI_BENCH_SAMPLES);
+    in->signal_mv.resize(PTI_BENCH_SAMPLES);
+    in->next = 0;
+    for (uint32_t i = 0; i < PTI_BENCH_SAMPLES; ++i) {
+        in->vref_mv[i] = ptx_sim_read_mv(&sim, TEMPERATURE_SENSOR_REFERENCE);
+        in->signal_mv[i] = ptx_sim_read_mv(&sim, TEMPERATURE_SENSOR);
+
+        if (scenario == PTI_SCENARIO_FAULT_STORM) {
+            /* 30 of every 64 samples bad: alternately low vref and a saturated signal */
+            uint32_t phase = i % 64U;
+            if (phase < 15U) {
+                in->vref_mv[i] = 4000U;
+            } else if (phase < 30U) {
+                in->signal_mv[i] = (uint16_t)(in->vref_mv[i] * 95U / 100U);
+            }
+        }
+    }
+}
+
+static uint16_t pti_bench_input(void* user, input_t input) {
+    pti_bench_inputs_t* in = (pti_bench_inputs_t*)user;
+    uint32_t i = in->next & (PTI_BENCH_SAMPLES - 1U);
+    if (input == TEMPERATURE_SENSOR_REFERENCE) return in->vref_mv[i];
+    in->next++;                     /* The signal is read last */
+    return in->signal_mv[i];
+}
+
+// Drop whatever the logs queued
+static void pti_bench_drain_tx(void) {
+    const uint8_t* data;
+    uint16_t n;
+    while ((n = ptx_serial_tx_peek(&data)) > 0U) {
+        ptx_serial_tx_consume(n);
+    }
+}
+
+static void BM_ControlUpdate(benchmark::State& state, pti_scenario_t scenario) {
+    pti_bench_inputs_t in;
+    ptx_oven_reset_config_to_defaults();
+    pti_bench_make_inputs(&in, scenario);
+
+    mock_reset_time(0);
+    ptx_serial_tx_reset();
+    ptx_event_queue_reset();
+    ptx_oven_set_door_state(false);
+    ptx_oven_control_init();
+    mock_set_input_hook(pti_bench_input, &in);
+
+    uint32_t period = ptx_oven_get_iteration_period();
+    uint32_t n = 0;
+    bool door = false;
+    for (auto _ : state) {
+        if ((scenario == PTI_SCENARIO_DOOR) && ((++n % 20U) == 0U)) {
+            door = !door;
+            ptx_oven_door_isr(door);
+        }
+        mock_advance_ms(period);
+        ptx_oven_control_update();
+        pti_bench_drain_tx();
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    mock_set_input_hook(NULL, NULL);
+    ptx_oven_door_isr(false);
+}
+BENCHMARK_CAPTURE(BM_ControlUpdate, steady, PTI_SCENARIO_STEADY);
+BENCHMARK_CAPTURE(BM_ControlUpdate, noisy, PTI_SCENARIO_NOISY);
+BENCHMARK_CAPTURE(BM_ControlUpdate, fault_storm, PTI_SCENARIO_FAULT_STORM);
+BENCHMARK_CAPTURE(BM_ControlUpdate, door_toggle, PTI_SCENARIO_DOOR);
+
+// Conversion behind ptx_compute_temperature(): float, or integer with the reciprocal cache
+static void BM_ComputeTemperature(benchmark::State& state, pti_scenario_t scenario) {
+    pti_bench_inputs_t in;
+    ptx_oven_reset_config_to_defaults();
+    pti_bench_make_inputs(&in, scenario);
+    const ptx_cal_table_t* cal = ptx_cal_get_table(ptx_oven_get_config()->probe_profile);
+#if PTX_FIXED_POINT
+    ptx_temp_recip_t recip;
+    ptx_temp_recip_reset(&recip);
+#endif
+
+    uint32_t i = 0;
+    for (auto _ : state) {
+        uint32_t k = i++ & (PTI_BENCH_SAMPLES - 1U);
+#if PTX_FIXED_POINT
+        benchmark::DoNotOptimize(ptx_temp_compute_mc(cal, &recip, in.vref_mv[k], in.signal_mv[k]));
+#else
+        benchmark::DoNotOptimize(ptx_temp_compute_c(cal, in.vref_mv[k], in.signal_mv[k]));
+#endif
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(BM_ComputeTemperature, steady, PTI_SCENARIO_STEADY);
+BENCHMARK_CAPTURE(BM_ComputeTemperature, noisy, PTI_SCENARIO_NOISY);
+BENCHMARK_CAPTURE(BM_ComputeTemperature, fault_storm, PTI_SCENARIO_FAULT_STORM);
+
+static void BM_SensorFilter(benchmark::State& state, pti_scenario_t scenario) {
+    pti_bench_inputs_t in;
+    ptx_oven_reset_config_to_defaults();
+    pti_bench_make_inputs(&in, scenario);
+    ptx_sensor_filter_t filter;
+    ptx_sensor_filter_init_ctx(&filter, (uint8_t)state.range(0));
+
+    uint32_t i = 0;
+    for (auto _ : state) {
+        uint32_t k = i++ & (PTI_BENCH_SAMPLES - 1U);
+        benchmark::DoNotOptimize(ptx_sensor_filter_update_ctx(&filter, in.vref_mv[k], in.signal_mv[k]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(BM_SensorFilter, steady, PTI_SCENARIO_STEADY)->Arg(5)->Arg(PTX_SENSOR_FILTER_MAX_WINDOW);
+BENCHMARK_CAPTURE(BM_SensorFilter, noisy, PTI_SCENARIO_NOISY)->Arg(5)->Arg(PTX_SENSOR_FILTER_MAX_WINDOW);
+BENCHMARK_CAPTURE(BM_SensorFilter, fault_storm, PTI_SCENARIO_FAULT_STORM)->Arg(5);
+
+// One status line as ptx_oven_run_log() writes it: format and queue
+static void BM_Logf(benchmark::State& state) {
+    mock_reset_time(123456);
+    ptx_serial_tx_reset();
+
+    int32_t temp = 180;
+    for (auto _ : state) {
+        ptx_logf(PTX_LOG_FILENAME, __LINE__,
+                 PTX_PSTR("temp=%d°C door=%s state=%d gas=%d ign=%d attempt=%d lockout=%d"),
+                 (int)temp, "CLOSED", 2, 1, 0, 1, 0);
+        pti_bench_drain_tx();
+        temp ^= 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Logf);
+
+BENCHMARK_MAIN();
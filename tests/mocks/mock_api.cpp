@@ -1,5 +1,6 @@
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include "api.h"
 #include "mock_api.h"
 
@@ -8,31 +9,55 @@ static uint16_t pti_vref_mv = 5000;
 static uint16_t pti_signal_mv = 2000;
 static bool pti_gas = false;
 static bool pti_igniter = false;
+static bool pti_led = false;
+static uint32_t pti_output_writes = 0;
+static int pti_stuck_output = -1;       /* Output that ignores writes, -1 for none */
+static mock_input_hook_t pti_input_hook = NULL;
+static void* pti_input_hook_user = NULL;
+static uint8_t pti_eeprom[EEPROM_SIZE_BYTES];
+static bool pti_eeprom_ready = false;   /* Erased on first use */
+static FILE* pti_eeprom_file = NULL;
+static uint32_t pti_eeprom_written = 0;
+static int32_t pti_eeprom_budget = -1;  /* Byte writes left before power loss, -1 for no limit */
 
 extern "C" unsigned long millis(void) {
     return pti_now_ms;
 }
 
+extern "C" unsigned long micros(void) {
+    return pti_now_ms * 1000UL;
+}
+
 extern "C" void mock_reset_time(unsigned long now_ms) { pti_now_ms = now_ms; }
 extern "C" void mock_advance_ms(unsigned long delta_ms) { pti_now_ms += delta_ms; }
 
 extern "C" void mock_set_vref_mv(uint16_t mv) { pti_vref_mv = mv; }
 extern "C" void mock_set_signal_mv(uint16_t mv) { pti_signal_mv = mv; }
 
+extern "C" void mock_set_input_hook(mock_input_hook_t hook, void* user) {
+    pti_input_hook = hook;
+    pti_input_hook_user = user;
+}
+
 extern "C" uint16_t read_voltage(input_t input) {
+    if (pti_input_hook != NULL) return pti_input_hook(pti_input_hook_user, input);
     if (input == TEMPERATURE_SENSOR_REFERENCE) return pti_vref_mv;
     if (input == TEMPERATURE_SENSOR) return pti_signal_mv;
     return 0;
 }
 
 extern "C" void set_output(output_t output, bool output_state) {
+    pti_output_writes++;
+    if ((int)output == pti_stuck_output) return;
     if (output == GAS_VALVE) pti_gas = output_state;
     else if (output == IGNITER) pti_igniter = output_state;
+    else if (output == SYS_LED_STATUS) pti_led = output_state;
 }
 
 extern "C" bool read_output(output_t output) {
     if (output == GAS_VALVE) return pti_gas;
     if (output == IGNITER) return pti_igniter;
+    if (output == SYS_LED_STATUS) return pti_led;
     return false;
 }
 
@@ -42,5 +67,76 @@ extern "C" void serial_printf(const char * format, ...) {
     // no-op for tests
 }
 
+extern "C" void serial_service(void) { /* no-op for tests */ }
+
 extern "C" bool mock_get_gas_output(void) { return pti_gas; }
 extern "C" bool mock_get_igniter_output(void) { return pti_igniter; }
+extern "C" uint32_t mock_get_output_writes(void) { return pti_output_writes; }
+extern "C" void mock_set_output_stuck(int output) { pti_stuck_output = output; }
+
+static void pti_eeprom_init(void) {
+    if (!pti_eeprom_ready) {
+        memset(pti_eeprom, 0xFF, sizeof(pti_eeprom));
+        pti_eeprom_ready = true;
+    }
+}
+
+extern "C" bool mock_eeprom_attach(const char* path) {
+    if (pti_eeprom_file != NULL) {
+        fclose(pti_eeprom_file);
+        pti_eeprom_file = NULL;
+    }
+    memset(pti_eeprom, 0xFF, sizeof(pti_eeprom));
+    pti_eeprom_ready = true;
+    pti_eeprom_written = 0;
+    pti_eeprom_budget = -1;
+    if (path == NULL) return true;
+
+    FILE* file = fopen(path, "r+b");
+    if (file != NULL) {
+        size_t got = fread(pti_eeprom, 1, sizeof(pti_eeprom), file);
+        (void)got;                      /* A short file reads as erased past its end */
+    } else {
+        file = fopen(path, "w+b");
+        if (file == NULL) return false;
+    }
+    if ((fseek(file, 0, SEEK_SET) != 0) ||
+        (fwrite(pti_eeprom, 1, sizeof(pti_eeprom), file) != sizeof(pti_eeprom)) ||
+        (fflush(file) != 0)) {
+        fclose(file);
+        return false;
+    }
+    pti_eeprom_file = file;
+    return true;
+}
+
+extern "C" uint32_t mock_eeprom_bytes_written(void) { return pti_eeprom_written; }
+extern "C" void mock_eeprom_set_write_budget(int32_t bytes) { pti_eeprom_budget = bytes; }
+
+extern "C" void read_eeprom(uint16_t address, void * data, uint16_t length) {
+    pti_eeprom_init();
+    uint8_t* out = (uint8_t*)data;
+    for (uint16_t i = 0; i < length; ++i) {
+        uint32_t at = (uint32_t)address + i;
+        out[i] = (at < EEPROM_SIZE_BYTES) ? pti_eeprom[at] : 0xFFU;
+    }
+}
+
+extern "C" void update_eeprom(uint16_t address, const void * data, uint16_t length) {
+    pti_eeprom_init();
+    const uint8_t* in = (const uint8_t*)data;
+    for (uint16_t i = 0; i < length; ++i) {
+        uint32_t at = (uint32_t)address + i;
+        if ((at >= EEPROM_SIZE_BYTES) || (pti_eeprom[at] == in[i])) continue;
+        if (pti_eeprom_budget == 0) return;
+        if (pti_eeprom_budget > 0) pti_eeprom_budget--;
+
+        pti_eeprom[at] = in[i];
+        pti_eeprom_written++;
+        if (pti_eeprom_file != NULL) {
+            fseek(pti_eeprom_file, (long)at, SEEK_SET);
+            fputc(in[i], pti_eeprom_file);
+            fflush(pti_eeprom_file);
+        }
+    }
+}
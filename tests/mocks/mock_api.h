@@ -15,9 +15,25 @@ void mock_advance_ms(unsigned long delta_ms);
 void mock_set_vref_mv(uint16_t mv);
 void mock_set_signal_mv(uint16_t mv);
 
+// Route read_voltage() through a callback instead (NULL: back to the values above)
+typedef uint16_t (*mock_input_hook_t)(void* user, input_t input);
+void mock_set_input_hook(mock_input_hook_t hook, void* user);
+
 // Inspect outputs
 bool mock_get_gas_output(void);
 bool mock_get_igniter_output(void);
+uint32_t mock_get_output_writes(void);      // set_output() calls so far
+
+// Make an output ignore writes (-1: none)
+void mock_set_output_stuck(int output);
+
+// Back the EEPROM with a file, loaded now and written through on every update
+// (a missing file starts erased); NULL: in memory, erased
+bool mock_eeprom_attach(const char* path);
+// Bytes update_eeprom() actually changed so far
+uint32_t mock_eeprom_bytes_written(void);
+// Lose power after this many more byte writes: later writes are dropped (-1: never)
+void mock_eeprom_set_write_budget(int32_t bytes);
 
 #ifdef __cplusplus
 }
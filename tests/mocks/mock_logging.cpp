@@ -8,8 +8,11 @@ void ptx_logf(const char* file, int line, const char* format, ...) {
     // Optional: capture logs for assertions; for now, ignore.
     (void)file; (void)line; (void)format;
 }
-void ptx_dbg_logf(const char* file, int line, const char* format, ...) {
-    // Optional: capture logs for assertions; for now, ignore.
+void ptx_logf_periodic(const char* file, int line, const char* format, ...) {
     (void)file; (void)line; (void)format;
 }
-const char* ptx_get_filename(const char* path) { return path; }
+void ptx_logf_level(const char* file, int line, uint8_t level, const char* format, ...) {
+    // Optional: capture logs for assertions; for now, ignore.
+    (void)file; (void)line; (void)level; (void)format;
+}
+void ptx_log_drain(void) { /* no-op */ }
@@ -0,0 +1,234 @@
+/**
+ * @file ptx_replay.cpp
+ * @brief Implementation of the trace recorder, reader and replay driver
+ */
+#include "tests/replay/ptx_replay.h"
+#include "tests/mocks/mock_api.h"
+#include "ptx_oven_control.h"
+#include "ptx_event_queue.h"
+#include "ptx_sensor_filter.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static void pti_writer_sink(void* user, const ptx_trace_record_t* record) {
+    ptx_trace_writer_t* w = (ptx_trace_writer_t*)user;
+    if (w->failed) return;
+    if (fwrite(record, sizeof(*record), 1, w->file) != 1) {
+        w->failed = true;
+        return;
+    }
+    w->records++;
+}
+
+bool ptx_trace_writer_open(ptx_trace_writer_t* writer, const char* path) {
+    ptx_trace_header_t header;
+
+    writer->records = 0;
+    writer->failed = false;
+    writer->file = fopen(path, "wb");
+    if (writer->file == NULL) return false;
+
+    /* The header holds no controller state: every capture starts from init */
+    ptx_oven_control_init();
+    ptx_oven_trace_header(&header);
+    if (fwrite(&header, sizeof(header), 1, writer->file) != 1) {
+        fclose(writer->file);
+        writer->file = NULL;
+        return false;
+    }
+    ptx_oven_set_trace_sink(pti_writer_sink, writer);
+    return true;
+}
+
+bool ptx_trace_writer_close(ptx_trace_writer_t* writer) {
+    ptx_oven_set_trace_sink(NULL, NULL);
+    if (writer->file == NULL) return false;
+    if (fclose(writer->file) != 0) writer->failed = true;
+    writer->file = NULL;
+    return !writer->failed;
+}
+
+bool ptx_trace_view(ptx_trace_map_t* map, const void* data, size_t size) {
+    const ptx_trace_header_t* header = (const ptx_trace_header_t*)data;
+
+    map->header = NULL;
+    map->records = NULL;
+    map->count = 0;
+    if ((data == NULL) || (size < sizeof(*header))) return false;
+    if ((header->magic != PTX_TRACE_MAGIC) || (header->version != PTX_TRACE_VERSION) ||
+            (header->record_size != sizeof(ptx_trace_record_t))) {
+        return false;
+    }
+
+    map->header = header;
+    map->records = (const ptx_trace_record_t*)(header + 1);
+    map->count = (uint32_t)((size - sizeof(*header)) / sizeof(ptx_trace_record_t));
+    return true;
+}
+
+bool ptx_trace_map(ptx_trace_map_t* map, const char* path) {
+    map->base = NULL;
+    map->size = 0;
+
+#if defined(_WIN32)
+    /* No mmap: read the file in one go */
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) return false;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    void* base = (size > 0) ? malloc((size_t)size) : NULL;
+    bool ok = (base != NULL) && (fread(base, (size_t)size, 1, f) == 1);
+    fclose(f);
+    if (!ok) {
+        free(base);
+        return false;
+    }
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if ((fstat(fd, &st) != 0) || (st.st_size <= 0)) {
+        close(fd);
+        return false;
+    }
+    size_t size = (size_t)st.st_size;
+    void* base = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return false;
+    madvise(base, size, MADV_SEQUENTIAL);
+#endif
+
+    map->base = base;
+    map->size = (size_t)size;
+    if (!ptx_trace_view(map, base, map->size)) {
+        ptx_trace_unmap(map);
+        return false;
+    }
+    return true;
+}
+
+void ptx_trace_unmap(ptx_trace_map_t* map) {
+    if (map->base != NULL) {
+#if defined(_WIN32)
+        free(map->base);
+#else
+        munmap(map->base, map->size);
+#endif
+    }
+    map->base = NULL;
+    map->size = 0;
+    map->header = NULL;
+    map->records = NULL;
+    map->count = 0;
+}
+
+void ptx_trace_config(const ptx_trace_header_t* header, ptx_oven_config_t* config) {
+    config->ignition_duration_ms = header->ignition_duration_ms;
+    config->periodic_log_ms = header->periodic_log_ms;
+    config->sensor_fault_window_ms = header->sensor_fault_window_ms;
+    config->auto_resume_delay_ms = header->auto_resume_delay_ms;
+    config->vref_min_v = header->vref_min_v;
+    config->vref_max_v = header->vref_max_v;
+    config->temp_target_c = header->temp_target_c;
+    config->temp_delta_c = header->temp_delta_c;
+    config->iteration_period = header->iteration_period;
+    config->max_ignition_attempts = header->max_ignition_attempts;
+    config->probe_profile = header->probe_profile;
+}
+
+/* Replay state shared with the input hook and the comparing sink */
+typedef struct {
+    const ptx_trace_map_t*    map;
+    uint32_t                  cursor;   // Next captured record to compare with
+    ptx_replay_result_t*      result;
+} pti_replay_t;
+
+static void pti_replay_sink(void* user, const ptx_trace_record_t* actual) {
+    pti_replay_t* r = (pti_replay_t*)user;
+    uint32_t index = r->cursor++;
+    bool same = false;
+    uint8_t expected_flags = 0;
+
+    if (index < r->map->count) {
+        const ptx_trace_record_t* expected = &r->map->records[index];
+        expected_flags = expected->flags;
+        same = (actual->kind == expected->kind) && (actual->flags == expected->flags);
+        if (same && (actual->kind == PTX_TRACE_UPDATE)) {
+            same = (actual->time == expected->time) && (actual->vref_mv_q == expected->vref_mv_q) &&
+                   (actual->signal_mv_q == expected->signal_mv_q);
+        }
+    }
+    if (same) return;
+
+    if (r->result->mismatches++ == 0U) {
+        r->result->first_mismatch = index;
+        r->result->expected_flags = expected_flags;
+        r->result->actual_flags = actual->flags;
+    }
+}
+
+bool ptx_replay_run(const ptx_trace_map_t* map, ptx_replay_result_t* result) {
+    pti_replay_t r;
+    ptx_oven_config_t config;
+
+    memset(result, 0, sizeof(*result));
+    result->first_mismatch = PTX_REPLAY_NONE;
+    r.map = map;
+    r.cursor = 0;
+    r.result = result;
+
+    /* Captures start right after ptx_oven_control_init(): do the same here */
+    ptx_oven_reset_config_to_defaults();
+    ptx_trace_config(map->header, &config);
+    if ((map->header->oversample_bits != PTX_OVERSAMPLE_BITS) || !ptx_oven_set_config(&config)) {
+        result->first_mismatch = 0;     /* Nothing replayable: count every record */
+        result->mismatches = map->count;
+        return false;
+    }
+    mock_reset_time(map->header->start_ms);
+    ptx_event_queue_reset();
+    ptx_oven_set_door_state(false);
+    ptx_oven_control_init();
+    bool door_open = false;
+
+    ptx_oven_set_trace_sink(pti_replay_sink, &r);
+
+    for (uint32_t i = 0; i < map->count; ++i) {
+        const ptx_trace_record_t* rec = &map->records[i];
+        bool open = (rec->flags & PTX_TRACE_DOOR_OPEN) != 0U;
+
+        if (rec->kind == PTX_TRACE_DOOR) {
+            ptx_oven_door_isr(open);
+            door_open = open;
+            result->doors++;
+        } else if (rec->kind == PTX_TRACE_UPDATE) {
+            if (open != door_open) {
+                ptx_oven_set_door_state(open);      /* Level set without an interrupt */
+                door_open = open;
+            }
+            mock_reset_time(rec->time);
+            ptx_oven_control_update_q(rec->vref_mv_q, rec->signal_mv_q);
+            result->updates++;
+        }
+    }
+
+    ptx_oven_set_trace_sink(NULL, NULL);
+
+    /* Captured records the replay never produced */
+    if (r.cursor < map->count) {
+        if (result->mismatches == 0U) {
+            result->first_mismatch = r.cursor;
+            result->expected_flags = map->records[r.cursor].flags;
+        }
+        result->mismatches += map->count - r.cursor;
+    }
+    return result->mismatches == 0U;
+}
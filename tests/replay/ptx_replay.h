@@ -0,0 +1,117 @@
+/**
+ * @file ptx_replay.h
+ * @brief Host-side trace recorder, memory-mapped reader and replay driver
+ * @details The recorder writes the trace of the single-oven API to a file
+ *          (ptx_trace.h format). The reader maps a trace file read-only and
+ *          exposes the header and the record array in place, so a multi-day
+ *          capture costs nothing to open.
+ *
+ *          The replay driver runs the real control update over a trace as
+ *          fast as the host allows: it restores the recorded configuration,
+ *          initializes the controller as the recorder did, sets the mock clock
+ *          to each UPDATE time, feeds the recorded readings to the sensor
+ *          filter (ptx_oven_control_update_q()), fires each DOOR edge through
+ *          ptx_oven_door_isr(), and records the replay itself. Every record
+ *          produced is compared with the captured one: same kind, same flags
+ *          (door level and output commands) and, for UPDATE, same time and
+ *          readings. Door edge timestamps are not compared. A trace recorded
+ *          with other PTX_OVERSAMPLE_BITS is not replayed.
+ */
+#ifndef PTX_REPLAY_H
+#define PTX_REPLAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "ptx_trace.h"
+#include "ptx_oven_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PTX_REPLAY_NONE     0xFFFFFFFFUL    // No mismatch
+
+/**
+ * @brief File recorder of the single-oven API
+ */
+typedef struct {
+    FILE*    file;
+    uint32_t records;           // Records written so far
+    bool     failed;            // A write failed; the trace is truncated
+} ptx_trace_writer_t;
+
+/**
+ * @brief Create a trace file and start recording
+ * @note Reinitializes the single-oven controller first (ptx_oven_control_init()),
+ *       then writes the header from the current configuration and millis(). The
+ *       header carries no controller state, so a replay can only start from a
+ *       freshly initialized controller.
+ * @return false if the file could not be created
+ */
+bool ptx_trace_writer_open(ptx_trace_writer_t* writer, const char* path);
+
+/**
+ * @brief Stop recording and close the file
+ * @return false if any write failed
+ */
+bool ptx_trace_writer_close(ptx_trace_writer_t* writer);
+
+/**
+ * @brief A trace in memory, mapped from a file or borrowed from a buffer
+ */
+typedef struct {
+    const ptx_trace_header_t* header;
+    const ptx_trace_record_t* records;
+    uint32_t count;             // Number of records
+    void*    base;              // Mapping to release, NULL for a borrowed buffer
+    size_t   size;
+} ptx_trace_map_t;
+
+/**
+ * @brief View a trace held in memory (no copy)
+ * @return false if the data is not a trace of this version (trailing partial record ignored)
+ */
+bool ptx_trace_view(ptx_trace_map_t* map, const void* data, size_t size);
+
+/**
+ * @brief Map a trace file read-only
+ * @return false if the file cannot be mapped or is not a trace
+ */
+bool ptx_trace_map(ptx_trace_map_t* map, const char* path);
+
+/**
+ * @brief Release a mapping from ptx_trace_map()
+ */
+void ptx_trace_unmap(ptx_trace_map_t* map);
+
+/**
+ * @brief Configuration stored in a trace header
+ */
+void ptx_trace_config(const ptx_trace_header_t* header, ptx_oven_config_t* config);
+
+/**
+ * @brief Replay outcome
+ */
+typedef struct {
+    uint32_t updates;           // UPDATE records replayed
+    uint32_t doors;             // DOOR records replayed
+    uint32_t mismatches;        // Records that differ from the capture
+    uint32_t first_mismatch;    // Index of the first one, PTX_REPLAY_NONE if none
+    uint8_t  expected_flags;    // Captured flags at first_mismatch
+    uint8_t  actual_flags;      // Replayed flags at first_mismatch
+} ptx_replay_result_t;
+
+/**
+ * @brief Replay a trace through ptx_oven_control_update()
+ * @note Reinitializes the single-oven API and the process-wide configuration.
+ * @return true if every record matched
+ */
+bool ptx_replay_run(const ptx_trace_map_t* map, ptx_replay_result_t* result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_REPLAY_H */
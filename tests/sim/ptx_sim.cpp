@@ -0,0 +1,298 @@
+/**
+ * @file ptx_sim.cpp
+ * @brief Implementation of the closed-loop oven simulator
+ */
+#include "tests/sim/ptx_sim.h"
+#include "tests/mocks/mock_api.h"
+#include "ptx_calibration.h"
+#include <math.h>
+#include <string.h>
+
+void ptx_sim_default_params(ptx_sim_params_t* params) {
+    params->ambient_c     = 25.0;
+    params->gain_c        = 350.0;
+    params->tau_s         = 900.0;
+    params->door_tau_s    = 120.0;
+    params->dead_time_ms  = 8000U;
+    params->noise_mv      = 2.0;
+    params->vref_mv       = 5000U;
+    params->probe_profile = PTX_CAL_PROFILE_NOMINAL;
+    params->seed          = 12345U;
+    params->setpoint_c    = 180.0;
+}
+
+void ptx_sim_init(ptx_sim_t* sim, const ptx_sim_params_t* params, uint32_t start_ms) {
+    memset(sim, 0, sizeof(*sim));
+    sim->p = *params;
+    sim->start_ms = start_ms;
+    sim->now_ms = start_ms;
+    sim->temp_c = params->ambient_c;
+    sim->rng = (params->seed != 0U) ? params->seed : 1U;
+    sim->stats.max_temp_c = params->ambient_c;
+    sim->stats.reach_ms = (params->ambient_c >= params->setpoint_c) ? 0U : PTX_SIM_NEVER;
+}
+
+// Decay rate (1/s) and steady-state temperature for constant inputs
+static void pti_sim_dynamics(const ptx_sim_params_t* p, bool gas, bool door,
+                             double* rate, double* t_ss) {
+    double drive = (p->ambient_c + (gas ? p->gain_c : 0.0)) / p->tau_s +
+                   (door ? p->ambient_c / p->door_tau_s : 0.0);
+    *rate = 1.0 / p->tau_s + (door ? 1.0 / p->door_tau_s : 0.0);
+    *t_ss = drive / *rate;
+}
+
+// Integrate [now, now + dt_ms) with constant inputs: exact exponential step
+static void pti_sim_segment(ptx_sim_t* sim, uint32_t dt_ms) {
+    const ptx_sim_params_t* p = &sim->p;
+    double rate, t_ss;
+    pti_sim_dynamics(p, sim->gas_effective, sim->door_open, &rate, &t_ss);
+    double t0 = sim->temp_c;
+    double t1 = t_ss + (t0 - t_ss) * exp(-rate * (dt_ms / 1000.0));
+
+    /* The segment is monotonic, so the setpoint is crossed at most once */
+    if ((sim->stats.reach_ms == PTX_SIM_NEVER) && (t0 < p->setpoint_c) && (t1 >= p->setpoint_c)) {
+        double cross_s = -log((p->setpoint_c - t_ss) / (t0 - t_ss)) / rate;
+        sim->stats.reach_ms = (sim->now_ms - sim->start_ms) + (uint32_t)(cross_s * 1000.0);
+    }
+    if (sim->gas_cmd) {
+        sim->stats.gas_on_ms += dt_ms;
+    }
+    if (t1 > sim->stats.max_temp_c) {
+        sim->stats.max_temp_c = t1;
+    }
+
+    sim->temp_c = t1;
+    sim->now_ms += dt_ms;
+}
+
+void ptx_sim_advance(ptx_sim_t* sim, uint32_t to_ms) {
+    while ((int32_t)(to_ms - sim->now_ms) > 0) {
+        uint32_t until = to_ms;
+        bool edge = false;
+
+        /* Stop at the next valve edge that reaches the plant */
+        if (sim->pending_count > 0U) {
+            uint32_t at = sim->pending[sim->pending_head].at_ms + sim->p.dead_time_ms;
+            if ((int32_t)(at - until) <= 0) {
+                until = at;
+                edge = true;
+            }
+        }
+
+        if ((int32_t)(until - sim->now_ms) > 0) {
+            pti_sim_segment(sim, until - sim->now_ms);
+        }
+        if (edge) {
+            sim->gas_effective = sim->pending[sim->pending_head].on;
+            sim->pending_head = (uint8_t)((sim->pending_head + 1U) % PTX_SIM_MAX_PENDING);
+            sim->pending_count--;
+        }
+    }
+}
+
+void ptx_sim_set_gas(ptx_sim_t* sim, bool on) {
+    if (on == sim->gas_cmd) return;
+    sim->gas_cmd = on;
+
+    if (sim->p.dead_time_ms == 0U) {
+        sim->gas_effective = on;
+        return;
+    }
+    if (sim->pending_count == PTX_SIM_MAX_PENDING) {
+        /* Chattering faster than the dead time: let the oldest edge through early */
+        sim->gas_effective = sim->pending[sim->pending_head].on;
+        sim->pending_head = (uint8_t)((sim->pending_head + 1U) % PTX_SIM_MAX_PENDING);
+        sim->pending_count--;
+    }
+    uint8_t tail = (uint8_t)((sim->pending_head + sim->pending_count) % PTX_SIM_MAX_PENDING);
+    sim->pending[tail].at_ms = sim->now_ms;
+    sim->pending[tail].on = on;
+    sim->pending_count++;
+}
+
+void ptx_sim_set_igniter(ptx_sim_t* sim, bool on) {
+    if (on && !sim->igniter_cmd) {
+        sim->stats.ignitions++;
+    }
+    sim->igniter_cmd = on;
+}
+
+void ptx_sim_set_door(ptx_sim_t* sim, bool open) {
+    sim->door_open = open;
+}
+
+uint32_t ptx_sim_predict_ms(const ptx_sim_t* sim, double threshold_c, bool rising) {
+    double temp = sim->temp_c;
+    bool gas = sim->gas_effective;
+    double elapsed_ms = 0.0;
+
+    /* One exponential segment per valve edge still in flight, then the last one forever */
+    for (uint8_t k = 0; k <= sim->pending_count; ++k) {
+        if (rising ? (temp >= threshold_c) : (temp <= threshold_c)) {
+            return (uint32_t)elapsed_ms;
+        }
+
+        double rate, t_ss;
+        pti_sim_dynamics(&sim->p, gas, sim->door_open, &rate, &t_ss);
+
+        bool last = (k == sim->pending_count);
+        double seg_ms = 0.0;
+        if (!last) {
+            uint8_t slot = (uint8_t)((sim->pending_head + k) % PTX_SIM_MAX_PENDING);
+            uint32_t at = sim->pending[slot].at_ms + sim->p.dead_time_ms - sim->now_ms;
+            seg_ms = (double)at - elapsed_ms;
+        }
+
+        if (rising ? (t_ss > threshold_c) : (t_ss < threshold_c)) {
+            double cross_ms = -log((threshold_c - t_ss) / (temp - t_ss)) / rate * 1000.0;
+            if (last || (cross_ms <= seg_ms)) {
+                double t = elapsed_ms + cross_ms;
+                return (t >= (double)PTX_SIM_NEVER) ? PTX_SIM_NEVER : (uint32_t)t;
+            }
+        }
+        if (last) break;
+
+        temp = t_ss + (temp - t_ss) * exp(-rate * (seg_ms / 1000.0));
+        elapsed_ms += seg_ms;
+        gas = sim->pending[(sim->pending_head + k) % PTX_SIM_MAX_PENDING].on;
+    }
+    return PTX_SIM_NEVER;
+}
+
+// Standard normal sample (xorshift32 + Box-Muller)
+static double pti_sim_gauss(ptx_sim_t* sim) {
+    double u[2];
+    for (int k = 0; k < 2; ++k) {
+        uint32_t x = sim->rng;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        sim->rng = x;
+        u[k] = ((double)x + 1.0) / 4294967296.0;   /* (0, 1] */
+    }
+    return sqrt(-2.0 * log(u[0])) * cos(6.283185307179586 * u[1]);
+}
+
+// Probe ratio (signal / vref) for a temperature: inverse of the calibration table
+static double pti_sim_ratio(const ptx_sim_t* sim, double temp_c) {
+    const ptx_cal_table_t* cal = ptx_cal_get_table(sim->p.probe_profile);
+    double mc = temp_c * 1000.0;
+    uint32_t i = 0;
+
+    while ((i < PTX_CAL_SEGMENTS - 1U) && (mc > cal->temp_mc[i + 1U])) {
+        ++i;
+    }
+    double t0 = cal->temp_mc[i];
+    double t1 = cal->temp_mc[i + 1U];
+    double ratio = (i + (mc - t0) / (t1 - t0)) / PTX_CAL_SEGMENTS;
+
+    return (ratio < 0.0) ? 0.0 : ((ratio > 1.0) ? 1.0 : ratio);
+}
+
+static uint16_t pti_sim_clamp_mv(double mv) {
+    if (mv <= 0.0) return 0U;
+    if (mv >= 65535.0) return 65535U;
+    return (uint16_t)(mv + 0.5);
+}
+
+uint16_t ptx_sim_read_mv(ptx_sim_t* sim, input_t input) {
+    double noise = (sim->p.noise_mv > 0.0) ? sim->p.noise_mv * pti_sim_gauss(sim) : 0.0;
+
+    if (input == TEMPERATURE_SENSOR_REFERENCE) {
+        return pti_sim_clamp_mv(sim->p.vref_mv + noise);
+    }
+    return pti_sim_clamp_mv(sim->p.vref_mv * pti_sim_ratio(sim, sim->temp_c) + noise);
+}
+
+static uint16_t pti_sim_io_read_mv(void* user, input_t input) {
+    return ptx_sim_read_mv((ptx_sim_t*)user, input);
+}
+
+static void pti_sim_io_write(void* user, output_t output, bool on) {
+    ptx_sim_t* sim = (ptx_sim_t*)user;
+    switch (output) {
+        case GAS_VALVE:      ptx_sim_set_gas(sim, on); break;
+        case IGNITER:        ptx_sim_set_igniter(sim, on); break;
+        case SYS_LED_STATUS: sim->led = on; break;
+    }
+}
+
+static bool pti_sim_io_read(void* user, output_t output) {
+    const ptx_sim_t* sim = (const ptx_sim_t*)user;
+    switch (output) {
+        case GAS_VALVE:      return sim->gas_cmd;
+        case IGNITER:        return sim->igniter_cmd;
+        case SYS_LED_STATUS: return sim->led;
+    }
+    return false;
+}
+
+ptx_io_table_t ptx_sim_io(ptx_sim_t* sim) {
+    ptx_io_table_t io = { sim, pti_sim_io_read_mv, pti_sim_io_write, pti_sim_io_read };
+    return io;
+}
+
+void ptx_sim_run(ptx_sim_t* sim, ptx_oven_ctx_t* ctx, uint32_t duration_ms, uint32_t period_ms) {
+    ptx_io_table_t io = ptx_sim_io(sim);
+    uint32_t end_ms = sim->now_ms + duration_ms;
+
+    while ((int32_t)(end_ms - sim->now_ms) > 0) {
+        ptx_oven_set_door_state_ctx(ctx, sim->door_open);
+        ptx_oven_control_update_ctx(ctx, &io, sim->now_ms);
+        sim->stats.updates++;
+        ptx_sim_advance(sim, sim->now_ms + period_ms);
+    }
+}
+
+// Plant prediction for the controller, with a guard band on the early side
+static uint32_t pti_sim_predict(void* user, int32_t threshold_mc, bool rising) {
+    double threshold_c = threshold_mc / 1000.0;
+    threshold_c += rising ? -PTX_SIM_PREDICT_MARGIN_C : PTX_SIM_PREDICT_MARGIN_C;
+    return ptx_sim_predict_ms((const ptx_sim_t*)user, threshold_c, rising);
+}
+
+void ptx_sim_run_skip(ptx_sim_t* sim, ptx_oven_ctx_t* ctx, uint32_t duration_ms,
+                      uint32_t period_ms, uint8_t events) {
+    ptx_io_table_t io = ptx_sim_io(sim);
+    uint32_t end_ms = sim->now_ms + duration_ms;
+    uint32_t refill = ctx->filter.signal.size;     /* Updates that rebuild the median window */
+
+    while ((int32_t)(end_ms - sim->now_ms) > 0) {
+        ptx_oven_set_door_state_ctx(ctx, sim->door_open);
+        ptx_oven_control_update_ctx(ctx, &io, sim->now_ms);
+        sim->stats.updates++;
+        ptx_sim_advance(sim, sim->now_ms + period_ms);
+
+        if (sim->p.noise_mv > 0.0) continue;
+
+        /* Grid steps until the update that first sees the event */
+        uint32_t next = ptx_oven_next_event_ctx(ctx, sim->now_ms, events, pti_sim_predict, sim);
+        uint32_t steps_left = (end_ms - sim->now_ms + period_ms - 1U) / period_ms;
+        uint32_t steps = (next == PTX_NEXT_NONE) ? steps_left : (next + period_ms - 1U) / period_ms;
+        if (steps > steps_left) steps = steps_left;
+
+        if (steps > refill) {
+            ptx_sim_advance(sim, sim->now_ms + (steps - refill) * period_ms);
+        }
+    }
+}
+
+void ptx_sim_run_global(ptx_sim_t* sim, uint32_t duration_ms, uint32_t period_ms) {
+    uint32_t end_ms = sim->now_ms + duration_ms;
+
+    mock_set_input_hook(pti_sim_io_read_mv, sim);
+    mock_reset_time(sim->now_ms);
+
+    while ((int32_t)(end_ms - sim->now_ms) > 0) {
+        ptx_oven_set_door_state(sim->door_open);
+        ptx_oven_control_update();
+        sim->stats.updates++;
+        ptx_sim_set_gas(sim, mock_get_gas_output());
+        ptx_sim_set_igniter(sim, mock_get_igniter_output());
+
+        ptx_sim_advance(sim, sim->now_ms + period_ms);
+        mock_advance_ms(period_ms);
+    }
+
+    mock_set_input_hook(NULL, NULL);
+}
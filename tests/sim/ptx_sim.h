@@ -0,0 +1,168 @@
+/**
+ * @file ptx_sim.h
+ * @brief Host-side closed-loop oven simulator (first-order plus dead time plant)
+ * @details The plant is a first-order thermal model driven by the gas valve
+ *          through a transport delay:
+ *
+ *              dT/dt = (T_amb + gain * gas(t - dead_time) - T) / tau
+ *                    + door * (T_amb - T) / door_tau
+ *
+ *          Between input changes the solution is an exact exponential, so the
+ *          plant can be advanced by any amount of virtual time in one step,
+ *          with no integration error. The probe reading is the temperature
+ *          mapped back through the calibration table, plus Gaussian noise.
+ *
+ *          The harnesses close the loop on virtual time:
+ *          - ptx_sim_run_global(): the single-oven API, through the mock API
+ *            (millis() and read_voltage() follow the simulation);
+ *          - ptx_sim_run(): one ptx_oven_ctx_t through an injected I/O table,
+ *            independent of any global state;
+ *          - ptx_sim_run_skip(): the same, jumping over updates where nothing
+ *            can happen.
+ */
+#ifndef PTX_SIM_H
+#define PTX_SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ptx_io.h"
+#include "ptx_oven_control.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PTX_SIM_MAX_PENDING     16U     // Valve edges in flight through the dead time
+#define PTX_SIM_NEVER           0xFFFFFFFFUL
+#define PTX_SIM_PREDICT_MARGIN_C 0.25   // Crossing guard band for time skipping (°C)
+
+/**
+ * @brief Plant and probe parameters
+ */
+typedef struct {
+    double   ambient_c;         // Ambient temperature (°C)
+    double   gain_c;            // Steady-state rise above ambient with gas on (°C)
+    double   tau_s;             // Time constant, door closed (s)
+    double   door_tau_s;        // Extra heat-loss time constant while the door is open (s)
+    uint32_t dead_time_ms;      // Valve to probe transport delay (ms)
+    double   noise_mv;          // Probe noise, standard deviation (mV)
+    uint16_t vref_mv;           // Reference voltage (mV)
+    uint8_t  probe_profile;     // Calibration profile of the simulated probe
+    uint32_t seed;              // Noise generator seed
+    double   setpoint_c;        // Reference for time-to-setpoint and overshoot stats
+} ptx_sim_params_t;
+
+/**
+ * @brief Closed-loop statistics since ptx_sim_init()
+ */
+typedef struct {
+    uint32_t gas_on_ms;         // Time with the valve commanded open
+    uint32_t ignitions;         // Igniter off-to-on edges
+    double   max_temp_c;        // Highest plant temperature
+    uint32_t reach_ms;          // Time from start to setpoint_c, PTX_SIM_NEVER if not reached
+    uint32_t updates;           // Control updates executed
+} ptx_sim_stats_t;
+
+/**
+ * @brief Simulator state
+ */
+typedef struct {
+    ptx_sim_params_t p;
+    uint32_t start_ms;
+    uint32_t now_ms;            // Virtual time
+    double   temp_c;            // Plant temperature
+    bool     door_open;
+    bool     gas_cmd;           // Outputs as last written by the controller
+    bool     igniter_cmd;
+    bool     led;
+    bool     gas_effective;     // Valve state the plant currently sees
+    struct {
+        uint32_t at_ms;         // When the controller switched the valve
+        bool     on;
+    } pending[PTX_SIM_MAX_PENDING];
+    uint8_t  pending_head;
+    uint8_t  pending_count;
+    uint32_t rng;
+    ptx_sim_stats_t stats;
+} ptx_sim_t;
+
+/**
+ * @brief Default plant: 25 °C ambient, 350 °C gain, 15 min time constant, 8 s dead time
+ */
+void ptx_sim_default_params(ptx_sim_params_t* params);
+
+/**
+ * @brief Start a simulation at ambient temperature, valve closed
+ */
+void ptx_sim_init(ptx_sim_t* sim, const ptx_sim_params_t* params, uint32_t start_ms);
+
+/**
+ * @brief Advance the plant to to_ms (exact, any step size)
+ */
+void ptx_sim_advance(ptx_sim_t* sim, uint32_t to_ms);
+
+/**
+ * @brief Record a valve command at the current time
+ */
+void ptx_sim_set_gas(ptx_sim_t* sim, bool on);
+
+/**
+ * @brief Record an igniter command at the current time
+ */
+void ptx_sim_set_igniter(ptx_sim_t* sim, bool on);
+
+/**
+ * @brief Open or close the door
+ */
+void ptx_sim_set_door(ptx_sim_t* sim, bool open);
+
+/**
+ * @brief Sample an input now (mV), noise included
+ */
+uint16_t ptx_sim_read_mv(ptx_sim_t* sim, input_t input);
+
+/**
+ * @brief Time until the plant temperature reaches a threshold
+ * @details Follows the exact trajectory, including valve edges still in the
+ *          dead time and the current door state.
+ * @param rising true: until temperature >= threshold_c, false: until <= threshold_c
+ * @return ms from now, rounded down; 0 if already there, PTX_SIM_NEVER if never
+ */
+uint32_t ptx_sim_predict_ms(const ptx_sim_t* sim, double threshold_c, bool rising);
+
+/**
+ * @brief I/O table that connects a ptx_oven_ctx_t to this simulation
+ */
+ptx_io_table_t ptx_sim_io(ptx_sim_t* sim);
+
+/**
+ * @brief Run one oven instance for duration_ms, one update every period_ms
+ */
+void ptx_sim_run(ptx_sim_t* sim, ptx_oven_ctx_t* ctx, uint32_t duration_ms, uint32_t period_ms);
+
+/**
+ * @brief ptx_sim_run() with next-event time skipping
+ * @details After each update the controller is asked for its next event
+ *          (ptx_oven_next_event_ctx(), plant crossings from
+ *          ptx_sim_predict_ms() with a PTX_SIM_PREDICT_MARGIN_C guard band).
+ *          The harness jumps ahead on the period grid and resumes normal updates
+ *          one median window before the event, so the filter is refilled
+ *          exactly as in a fixed-step run. For the selected events the result
+ *          matches ptx_sim_run(); unselected ones (e.g. LED, log) are skipped
+ *          over. Door changes happen between runs.
+ * @note Skipping needs a deterministic probe: with noise_mv > 0 this is ptx_sim_run().
+ */
+void ptx_sim_run_skip(ptx_sim_t* sim, ptx_oven_ctx_t* ctx, uint32_t duration_ms,
+                      uint32_t period_ms, uint8_t events);
+
+/**
+ * @brief Run the single-oven API for duration_ms, one update every period_ms
+ * @note Drives the mock clock and the mock inputs; restores the mock inputs on return.
+ */
+void ptx_sim_run_global(ptx_sim_t* sim, uint32_t duration_ms, uint32_t period_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_SIM_H */
@@ -1,10 +1,23 @@
 #pragma once
 #include <stdint.h>
+#include <stddef.h>
 #ifdef __cplusplus
 extern "C" {
 #endif
 // Minimal Arduino stub for host-side tests
 unsigned long millis(void);
+unsigned long micros(void);
 #ifdef __cplusplus
 }
 #endif
+
+#ifdef __cplusplus
+// Serial port that accepts everything (host builds of the real logging)
+struct HardwareSerial {
+    void begin(unsigned long baud) { (void)baud; }
+    int availableForWrite(void) { return 64; }
+    size_t write(const uint8_t* data, size_t count) { (void)data; return count; }
+    explicit operator bool() const { return true; }
+};
+inline HardwareSerial Serial;    // One object for the whole program (C++17)
+#endif
@@ -0,0 +1,73 @@
+/**
+ * @file test_actuator_gtest.cpp
+ * @brief Google Test suite for change-only actuator writes and readback checks
+ */
+#include <gtest/gtest.h>
+#include "ptx_actuator.h"
+#include "tests/mocks/mock_api.h"
+
+class ActuatorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        mock_set_output_stuck(-1);
+        ptx_actuator_init();
+    }
+    void TearDown() override {
+        mock_set_output_stuck(-1);
+    }
+};
+
+TEST_F(ActuatorTest, WritesOnlyOnChange) {
+    uint32_t writes = mock_get_output_writes();
+
+    ptx_actuator_set_gas(false);            // Already off after init
+    ptx_actuator_set_igniter(false);
+    EXPECT_EQ(writes, mock_get_output_writes());
+
+    ptx_actuator_set_gas(true);
+    EXPECT_TRUE(mock_get_gas_output());
+    EXPECT_EQ(writes + 1U, mock_get_output_writes());
+
+    for (int i = 0; i < 10; ++i) ptx_actuator_set_gas(true);
+    EXPECT_EQ(writes + 1U, mock_get_output_writes());
+
+    ptx_actuator_set_system_led_status(true);   // First LED command always writes
+    ptx_actuator_set_system_led_status(true);
+    EXPECT_EQ(writes + 2U, mock_get_output_writes());
+    EXPECT_EQ(0U, ptx_actuator_get_readback_faults());
+}
+
+TEST_F(ActuatorTest, EmergencyStopIgnoresCache) {
+    ptx_actuator_set_gas(true);
+    ptx_actuator_set_igniter(true);
+
+    uint32_t writes = mock_get_output_writes();
+    ptx_actuator_emergency_stop();
+    ptx_actuator_emergency_stop();
+    EXPECT_EQ(writes + 4U, mock_get_output_writes());
+    EXPECT_FALSE(mock_get_gas_output());
+    EXPECT_FALSE(mock_get_igniter_output());
+
+    // Cache follows the stop: turning gas back on writes again
+    ptx_actuator_set_gas(true);
+    EXPECT_TRUE(mock_get_gas_output());
+}
+
+TEST_F(ActuatorTest, ReadbackMismatchIsCountedAndRetried) {
+    mock_set_output_stuck(IGNITER);
+    uint32_t writes = mock_get_output_writes();
+
+    ptx_actuator_set_igniter(true);
+    EXPECT_EQ(1U, ptx_actuator_get_readback_faults());
+    EXPECT_FALSE(ptx_actuator_get_igniter_state());
+
+    // Not cached as done: the same command is written again
+    ptx_actuator_set_igniter(true);
+    EXPECT_EQ(writes + 2U, mock_get_output_writes());
+    EXPECT_EQ(2U, ptx_actuator_get_readback_faults());
+
+    mock_set_output_stuck(-1);
+    ptx_actuator_set_igniter(true);
+    EXPECT_TRUE(mock_get_igniter_output());
+    EXPECT_EQ(2U, ptx_actuator_get_readback_faults());
+}
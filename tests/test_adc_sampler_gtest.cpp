@@ -0,0 +1,157 @@
+/**
+ * @file test_adc_sampler_gtest.cpp
+ * @brief Google Test suite for the interrupt-driven ADC sampler ring
+ */
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include "ptx_adc_sampler.h"
+#include "ptx_io.h"
+#include "ptx_sensor_filter.h"
+
+// One vref/signal pair, as the interrupt sees it: vref first, then signal
+static bool convert_pair(uint16_t vref, uint16_t signal) {
+    EXPECT_TRUE(ptx_adc_sampler_on_conversion(vref)) << "signal converts next";
+    return ptx_adc_sampler_on_conversion(signal);
+}
+
+// On-demand scaling of whole counts, what one pair (or a mean of them) reads as
+static uint16_t vref_mv(uint16_t counts) {
+    return ptx_input_traits<TEMPERATURE_SENSOR_REFERENCE>::to_mv_q(counts, 0);
+}
+static uint16_t signal_mv(uint16_t counts) {
+    return ptx_input_traits<TEMPERATURE_SENSOR>::to_mv_q(counts, 0);
+}
+
+class AdcSamplerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ptx_adc_sampler_reset();
+    }
+};
+
+TEST_F(AdcSamplerTest, ChannelsAlternateIntoPairs) {
+    static_assert(PTX_OVERSAMPLE_BITS == 0U, "host build: one output per pair, whole millivolts");
+    uint16_t vref, signal;
+    EXPECT_TRUE(ptx_adc_sampler_on_conversion(800U));
+    ptx_adc_sampler_read_mv_q(&vref, &signal);
+    EXPECT_EQ(0U, vref) << "Half a pair is not published";
+    EXPECT_EQ(0U, signal);
+
+    EXPECT_FALSE(ptx_adc_sampler_on_conversion(300U)) << "vref converts next";
+    ptx_adc_sampler_read_mv_q(&vref, &signal);
+    EXPECT_EQ(vref_mv(800U), vref);
+    EXPECT_EQ(signal_mv(300U), signal);
+}
+
+TEST_F(AdcSamplerTest, ReadMvAveragesAndRepeatsWhenIdle) {
+    uint16_t vref, signal;
+    ptx_adc_sampler_read_mv_q(&vref, &signal);
+    EXPECT_EQ(0U, vref) << "Nothing converted yet";
+    EXPECT_EQ(0U, signal);
+
+    /* Mean counts 512 and 1023: the on-demand scaling of those counts */
+    convert_pair(511U, 1023U);
+    convert_pair(513U, 1023U);
+    ptx_adc_sampler_read_mv_q(&vref, &signal);
+    EXPECT_EQ(4500U + 512U * 1000U / 1023U, vref);
+    EXPECT_EQ(5000U, signal);
+
+    ptx_adc_sampler_read_mv_q(&vref, &signal);
+    EXPECT_EQ(4500U + 512U * 1000U / 1023U, vref) << "Previous reading repeated";
+    EXPECT_EQ(5000U, signal);
+}
+
+TEST_F(AdcSamplerTest, LastMvLeavesTheQueueAlone) {
+    convert_pair(600U, 700U);
+    uint16_t vref, signal;
+    ptx_adc_sampler_read_mv_q(&vref, &signal);
+
+    convert_pair(100U, 200U);
+    uint16_t last_vref, last_signal;
+    ptx_adc_sampler_last_mv_q(&last_vref, &last_signal);
+    EXPECT_EQ(vref_mv(600U), last_vref) << "Still the previous reading";
+    EXPECT_EQ(signal_mv(700U), last_signal);
+
+    ptx_adc_sampler_read_mv_q(&vref, &signal);
+    EXPECT_EQ(vref_mv(100U), vref) << "The queued pair was not consumed";
+    EXPECT_EQ(signal_mv(200U), signal);
+}
+
+TEST_F(AdcSamplerTest, ReadMvRoundsTheMean) {
+    for (uint16_t i = 0; i < 10U; ++i) {
+        convert_pair((uint16_t)(500U + i), (uint16_t)(200U + i));
+    }
+    uint16_t vref, signal;
+    ptx_adc_sampler_read_mv_q(&vref, &signal);
+    EXPECT_EQ(vref_mv(505U), vref) << "504.5 rounds up";
+    EXPECT_EQ(signal_mv(205U), signal);
+}
+
+TEST_F(AdcSamplerTest, FullRingDropsNewestAndCounts) {
+    for (uint16_t i = 0; i < PTX_ADC_RING_SIZE + 3U; ++i) {
+        convert_pair(1U, (uint16_t)(10U * i));
+    }
+    EXPECT_EQ(3U, ptx_adc_sampler_dropped());
+
+    /* Only the oldest pairs were kept: mean of 10 * (0 .. RING_SIZE - 1) */
+    uint16_t vref, signal;
+    ptx_adc_sampler_read_mv_q(&vref, &signal);
+    EXPECT_EQ(vref_mv(1U), vref);
+    EXPECT_EQ(signal_mv((uint16_t)(5U * (PTX_ADC_RING_SIZE - 1U))), signal);
+
+    /* Emptied: the next pair is read on its own */
+    convert_pair(7U, 9U);
+    ptx_adc_sampler_read_mv_q(&vref, &signal);
+    EXPECT_EQ(vref_mv(7U), vref);
+    EXPECT_EQ(signal_mv(9U), signal);
+    EXPECT_EQ(3U, ptx_adc_sampler_dropped());
+}
+
+TEST_F(AdcSamplerTest, ConcurrentProducerConsumer) {
+    const uint32_t kPairs = 50000U;        // Drops fit the 16-bit counter
+    std::atomic<bool> done(false);
+
+    /* The "interrupt" never waits: pairs that find the ring full are dropped */
+    std::thread producer([&]() {
+        for (uint32_t i = 0; i < kPairs; ++i) {
+            uint16_t v = (uint16_t)(i & 0x1FFU);
+            ptx_adc_sampler_on_conversion(v);
+            ptx_adc_sampler_on_conversion((uint16_t)(v + 1U));
+        }
+        done.store(true);
+    });
+
+    // Signal scaling is one-to-one: recover the mean signal counts of a reading
+    uint16_t signal_table[1024];
+    for (uint16_t c = 0; c < 1024U; ++c) signal_table[c] = signal_mv(c);
+
+    // Every pair read is whole: the mean signal is always the mean vref + 1
+    uint32_t reads = 0;
+    uint32_t torn = 0;                      /* Checked after the join */
+    for (;;) {
+        bool finished = done.load();
+        uint16_t vref, signal;
+        ptx_adc_sampler_read_mv_q(&vref, &signal);
+        if (signal != 0U) {
+            const uint16_t* at = std::lower_bound(signal_table, signal_table + 1024, signal);
+            uint16_t counts = (uint16_t)(at - signal_table);
+            if (counts == 0U || counts >= 1024U || *at != signal ||
+                vref != vref_mv((uint16_t)(counts - 1U))) torn++;
+            reads++;
+        }
+        if (finished) break;
+    }
+    producer.join();
+    EXPECT_EQ(0U, torn);
+    EXPECT_GT(reads, 0U);
+    EXPECT_LT(ptx_adc_sampler_dropped(), kPairs);
+
+    /* Nothing left queued: a new pair is read on its own */
+    convert_pair(40U, 41U);
+    uint16_t vref, signal;
+    ptx_adc_sampler_read_mv_q(&vref, &signal);
+    EXPECT_EQ(vref_mv(40U), vref);
+    EXPECT_EQ(signal_mv(41U), signal);
+}
@@ -0,0 +1,196 @@
+/**
+ * @file test_batch_gtest.cpp
+ * @brief Google Test suite for the batched SoA control step
+ */
+#include <gtest/gtest.h>
+#include <vector>
+#include "gateway/ptx_batch.h"
+#include "ptx_oven_control.h"
+#include "ptx_oven_config.h"
+#include "ptx_sensor_filter.h"
+#include "tests/mocks/mock_api.h"
+
+// Deterministic pseudo-random numbers
+struct Lcg {
+    uint32_t x;
+    explicit Lcg(uint32_t seed) : x(seed) {}
+    uint32_t next(uint32_t n) {
+        x = x * 1664525U + 1013904223U;
+        return (x >> 8) % n;
+    }
+};
+
+// Readings that walk around the heating band and sometimes jump out of range
+static void random_inputs(ptx_batch_t* b, Lcg& rng) {
+    for (uint32_t i = 0; i < b->count; ++i) {
+        uint32_t pick = rng.next(100);
+        if (pick < 3) {
+            b->vref_mv[i] = (uint16_t)rng.next(6000);           // Anything, including 0
+            b->signal_mv[i] = (uint16_t)rng.next(6000);
+        } else {
+            b->vref_mv[i] = (uint16_t)(4400 + rng.next(1200));
+            b->signal_mv[i] = (uint16_t)(b->vref_mv[i] * (40 + rng.next(30)) / 100);
+        }
+        b->door_open[i] = (rng.next(50) == 0) ? 1U : 0U;
+    }
+}
+
+// Defaults with the band, ignition time and probe varied
+static ptx_oven_config_t random_config(Lcg& rng) {
+    ptx_oven_config_t cfg = *ptx_oven_get_config();
+    cfg.temp_target_c = 150.0f + (float)rng.next(60);
+    cfg.temp_delta_c = 1.0f + (float)rng.next(8);
+    cfg.ignition_duration_ms = 100U * (1U + rng.next(10));
+    cfg.probe_profile = (uint8_t)rng.next(PTX_CAL_PROFILE_COUNT);
+    return cfg;
+}
+
+static void random_configs(ptx_batch_t* b, Lcg& rng) {
+    for (uint32_t i = 0; i < b->count; ++i) {
+        ptx_oven_config_t cfg = random_config(rng);
+        ptx_batch_set_config(b, i, &cfg);
+    }
+}
+
+static void expect_same(const ptx_batch_t& a, const ptx_batch_t& b, uint32_t step) {
+    for (uint32_t i = 0; i < a.count; ++i) {
+        ASSERT_EQ(a.temperature_mc[i], b.temperature_mc[i]) << "oven " << i << " step " << step;
+        ASSERT_EQ(a.state[i], b.state[i]) << "oven " << i << " step " << step;
+        ASSERT_EQ(a.flags[i], b.flags[i]) << "oven " << i << " step " << step;
+        ASSERT_EQ(a.ignition_attempt[i], b.ignition_attempt[i]) << "oven " << i << " step " << step;
+    }
+}
+
+class BatchTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ptx_oven_reset_config_to_defaults();
+    }
+};
+
+TEST_F(BatchTest, SimdMatchesScalar) {
+    if (!ptx_batch_has_simd()) {
+        GTEST_SKIP() << "No SIMD kernel on this CPU";
+    }
+
+    const uint32_t kOvens = 1003;           // Not a multiple of the lane count
+    ptx_batch_t scalar, simd;
+    ASSERT_TRUE(ptx_batch_init(&scalar, kOvens));
+    ASSERT_TRUE(ptx_batch_init(&simd, kOvens));
+
+    Lcg cfg_rng(7);
+    random_configs(&scalar, cfg_rng);
+    Lcg cfg_rng2(7);
+    random_configs(&simd, cfg_rng2);
+
+    Lcg rng(42);
+    for (uint32_t step = 0; step < 300; ++step) {
+        random_inputs(&scalar, rng);
+        memcpy(simd.vref_mv, scalar.vref_mv, kOvens * sizeof(uint16_t));
+        memcpy(simd.signal_mv, scalar.signal_mv, kOvens * sizeof(uint16_t));
+        memcpy(simd.door_open, scalar.door_open, kOvens);
+
+        uint32_t now = 0xFFFFF000U + step * 100U;    // Crosses the millis() wrap
+        ptx_batch_step_scalar(&scalar, now);
+        ASSERT_TRUE(ptx_batch_step_simd(&simd, now));
+        expect_same(scalar, simd, step);
+    }
+
+    ptx_batch_free(&scalar);
+    ptx_batch_free(&simd);
+}
+
+TEST_F(BatchTest, ExtremeReadings) {
+    ptx_batch_t scalar, fast;
+    const uint32_t kOvens = 16;
+    ASSERT_TRUE(ptx_batch_init(&scalar, kOvens));
+    ASSERT_TRUE(ptx_batch_init(&fast, kOvens));
+
+    const uint16_t vref[] = { 0, 1, 2, 3, 4500, 5000, 5500, 65535, 5000, 5000, 5000, 5000, 1, 0, 65535, 100 };
+    const uint16_t sig[]  = { 0, 0, 1, 2, 450,  500,  4950, 65535, 499,  501,  4499, 4501, 1, 5, 6553,  50 };
+    for (uint32_t i = 0; i < kOvens; ++i) {
+        scalar.vref_mv[i] = fast.vref_mv[i] = vref[i];
+        scalar.signal_mv[i] = fast.signal_mv[i] = sig[i];
+    }
+
+    ptx_batch_step_scalar(&scalar, 0);
+    ptx_batch_step(&fast, 0);
+    expect_same(scalar, fast, 0);
+    EXPECT_EQ(PTX_TEMP_MAX_MC, scalar.temperature_mc[6]);
+    EXPECT_EQ(PTX_TEMP_MIN_MC, scalar.temperature_mc[8]);
+
+    ptx_batch_free(&scalar);
+    ptx_batch_free(&fast);
+}
+
+#if PTX_FIXED_POINT
+// Simulated I/O of one oven, feeding the per-instance controller
+struct FakeIo {
+    uint16_t vref_mv;
+    uint16_t signal_mv;
+    bool out[3];
+};
+
+static uint16_t fake_read_mv(void* user, input_t input) {
+    FakeIo* io = static_cast<FakeIo*>(user);
+    return (input == TEMPERATURE_SENSOR_REFERENCE) ? io->vref_mv : io->signal_mv;
+}
+static void fake_write(void* user, output_t output, bool on) {
+    static_cast<FakeIo*>(user)->out[output] = on;
+}
+static bool fake_read(void* user, output_t output) {
+    return static_cast<FakeIo*>(user)->out[output];
+}
+
+TEST_F(BatchTest, MatchesController) {
+    const uint32_t kOvens = 40;
+    std::vector<FakeIo> fake(kOvens);
+    std::vector<ptx_io_table_t> io(kOvens);
+    std::vector<ptx_oven_ctx_t> ctx(kOvens);
+    std::vector<ptx_sensor_filter_t> filter(kOvens);
+    ptx_batch_t batch;
+    ASSERT_TRUE(ptx_batch_init(&batch, kOvens));
+
+    Lcg cfg_rng(3);
+    random_configs(&batch, cfg_rng);
+    Lcg cfg_rng2(3);
+    for (uint32_t i = 0; i < kOvens; ++i) {
+        ptx_oven_config_t cfg = random_config(cfg_rng2);    // Same sequence as the batch got
+
+        io[i] = ptx_io_table_t{ &fake[i], fake_read_mv, fake_write, fake_read };
+        ptx_oven_control_init_ctx(&ctx[i], &cfg, &io[i]);
+        ptx_sensor_filter_init_ctx(&filter[i], 5);
+    }
+
+    Lcg rng(99);
+    for (uint32_t step = 1; step <= 500; ++step) {
+        uint32_t now = step * 100U;
+        for (uint32_t i = 0; i < kOvens; ++i) {
+            fake[i].vref_mv = (uint16_t)(4400 + rng.next(1200));
+            fake[i].signal_mv = (uint16_t)(fake[i].vref_mv * (45 + rng.next(20)) / 100);
+            bool door = (rng.next(40) == 0);
+
+            ptx_oven_set_door_state_ctx(&ctx[i], door);
+            ptx_oven_control_update_ctx(&ctx[i], &io[i], now);
+
+            ptx_sensor_reading_t r = ptx_sensor_filter_update_ctx(&filter[i], fake[i].vref_mv, fake[i].signal_mv);
+            batch.vref_mv[i] = r.vref_mv;
+            batch.signal_mv[i] = r.signal_mv;
+            batch.door_open[i] = door ? 1U : 0U;
+        }
+        ptx_batch_step(&batch, now);
+
+        for (uint32_t i = 0; i < kOvens; ++i) {
+            const ptx_oven_status_t* st = ptx_oven_get_status_ctx(&ctx[i]);
+            ASSERT_EQ(st->temperature_mc, batch.temperature_mc[i]) << "oven " << i << " step " << step;
+            ASSERT_EQ((int32_t)st->state, batch.state[i]) << "oven " << i << " step " << step;
+            ASSERT_EQ(st->gas_on, (batch.flags[i] & PTX_BATCH_GAS) != 0U);
+            ASSERT_EQ(st->igniter_on, (batch.flags[i] & PTX_BATCH_IGNITER) != 0U);
+            ASSERT_EQ(st->vref_fault, (batch.flags[i] & PTX_BATCH_VREF_FAULT) != 0U);
+            ASSERT_EQ(st->signal_fault, (batch.flags[i] & PTX_BATCH_SIGNAL_FAULT) != 0U);
+            ASSERT_EQ(st->ignition_attempt, batch.ignition_attempt[i]);
+        }
+    }
+    ptx_batch_free(&batch);
+}
+#endif
@@ -0,0 +1,176 @@
+/**
+ * @file test_config_store_gtest.cpp
+ * @brief Google Test suite for the EEPROM configuration store (file-backed EEPROM)
+ */
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include "ptx_config_store.h"
+#include "ptx_oven_config.h"
+#include "mock_api.h"
+#include "tests/test_temp_path.h"
+
+class ConfigStoreTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path = test_temp_path("ptx_eeprom");
+        remove(path.c_str());
+        ASSERT_TRUE(mock_eeprom_attach(path.c_str()));
+        ptx_oven_reset_config_to_defaults();
+    }
+    void TearDown() override {
+        mock_eeprom_attach(NULL);
+        remove(path.c_str());
+        ptx_oven_reset_config_to_defaults();
+    }
+
+    // Power cycle: RAM back to the defaults, the EEPROM reloaded from its file
+    void reboot() {
+        ptx_oven_reset_config_to_defaults();
+        ASSERT_TRUE(mock_eeprom_attach(path.c_str()));
+    }
+
+    static uint16_t slot_addr(uint8_t slot) {
+        return (uint16_t)(PTX_CONFIG_STORE_ADDR + slot * PTX_CONFIG_RECORD_SIZE);
+    }
+
+    std::string path;
+};
+
+TEST_F(ConfigStoreTest, BlankEepromBootsWithDefaults) {
+    ptx_oven_set_temp_target_c(150.0f);
+    EXPECT_FALSE(ptx_config_store_load());
+    EXPECT_EQ(0, memcmp(ptx_oven_get_config_defaults(), ptx_oven_get_config(),
+                        sizeof(ptx_oven_config_t)));
+}
+
+TEST_F(ConfigStoreTest, TuningSurvivesPowerCycle) {
+    ASSERT_FALSE(ptx_config_store_load());
+    ASSERT_TRUE(ptx_oven_set_temp_target_c(165.5f));
+    ASSERT_TRUE(ptx_oven_set_temp_delta_c(3.25f));
+    ASSERT_TRUE(ptx_oven_set_vref_range_v(4.6f, 5.4f));
+    ASSERT_TRUE(ptx_oven_set_max_ignition_attempts(4U));
+    ASSERT_TRUE(ptx_oven_set_ignition_duration_ms(4500U));
+    ptx_oven_config_t saved = *ptx_oven_get_config();
+    EXPECT_TRUE(ptx_config_store_save());
+
+    reboot();
+    EXPECT_FLOAT_EQ(2.0f, ptx_oven_get_temp_delta_c()) << "Defaults before the load";
+    EXPECT_TRUE(ptx_config_store_load());
+    EXPECT_EQ(0, memcmp(&saved, ptx_oven_get_config(), sizeof(saved)))
+        << "Milli-unit values come back exactly";
+}
+
+TEST_F(ConfigStoreTest, UnchangedConfigIsNotRewritten) {
+    ASSERT_FALSE(ptx_config_store_load());
+    EXPECT_TRUE(ptx_config_store_save());
+    uint32_t written = mock_eeprom_bytes_written();
+    EXPECT_GT(written, 0U);
+    EXPECT_LE(written, PTX_CONFIG_RECORD_SIZE);
+
+    EXPECT_TRUE(ptx_config_store_save());
+    EXPECT_EQ(written, mock_eeprom_bytes_written());
+}
+
+TEST_F(ConfigStoreTest, SavesRotateThroughEverySlot) {
+    ASSERT_FALSE(ptx_config_store_load());
+    const uint8_t kSaves = 2U * PTX_CONFIG_STORE_SLOTS + 3U;
+    for (uint8_t i = 0; i < kSaves; ++i) {
+        ASSERT_TRUE(ptx_oven_set_temp_target_c(100.0f + i));
+        ASSERT_TRUE(ptx_config_store_save());
+    }
+
+    /* Every slot in use; sequences count up from the oldest slot on */
+    uint8_t newest = (uint8_t)((kSaves - 1U) % PTX_CONFIG_STORE_SLOTS);
+    for (uint8_t k = 1; k <= PTX_CONFIG_STORE_SLOTS; ++k) {
+        uint8_t slot = (uint8_t)((newest + k) % PTX_CONFIG_STORE_SLOTS);
+        uint8_t header[4];
+        read_eeprom(slot_addr(slot), header, sizeof(header));
+        EXPECT_EQ(PTX_CONFIG_RECORD_MAGIC, header[0]);
+        EXPECT_EQ(kSaves - PTX_CONFIG_STORE_SLOTS + k - 1U, (unsigned)(header[2] | (header[3] << 8)))
+            << "slot " << (int)slot;
+    }
+
+    reboot();
+    EXPECT_TRUE(ptx_config_store_load());
+    EXPECT_FLOAT_EQ(100.0f + kSaves - 1U, ptx_oven_get_temp_target_c());
+}
+
+TEST_F(ConfigStoreTest, SaveWithoutLoadContinuesTheRotation) {
+    ASSERT_FALSE(ptx_config_store_load());
+    for (uint8_t i = 0; i < 3U; ++i) {
+        ASSERT_TRUE(ptx_oven_set_temp_target_c(150.0f + i));
+        ASSERT_TRUE(ptx_config_store_save());
+    }
+
+    /* Boot that saves before (or without) loading */
+    reboot();
+    ASSERT_TRUE(ptx_oven_set_temp_target_c(152.0f));
+    uint32_t written = mock_eeprom_bytes_written();
+    ASSERT_TRUE(ptx_config_store_save());
+    EXPECT_EQ(written, mock_eeprom_bytes_written()) << "Newest record already holds it";
+
+    ASSERT_TRUE(ptx_oven_set_temp_target_c(170.0f));
+    ASSERT_TRUE(ptx_config_store_save());
+    uint8_t magic;
+    read_eeprom(slot_addr(3), &magic, 1);
+    EXPECT_EQ(PTX_CONFIG_RECORD_MAGIC, magic) << "Written after the newest slot, not over slot 0";
+    read_eeprom(slot_addr(0), &magic, 1);
+    EXPECT_EQ(PTX_CONFIG_RECORD_MAGIC, magic);
+
+    reboot();
+    EXPECT_TRUE(ptx_config_store_load());
+    EXPECT_FLOAT_EQ(170.0f, ptx_oven_get_temp_target_c());
+}
+
+TEST_F(ConfigStoreTest, PowerLossMidSaveKeepsPreviousRecord) {
+    ASSERT_FALSE(ptx_config_store_load());
+    ASSERT_TRUE(ptx_oven_set_temp_target_c(150.0f));
+    ASSERT_TRUE(ptx_config_store_save());
+
+    ASSERT_TRUE(ptx_oven_set_temp_target_c(160.0f));
+    mock_eeprom_set_write_budget(10);
+    EXPECT_FALSE(ptx_config_store_save());
+
+    reboot();
+    EXPECT_TRUE(ptx_config_store_load());
+    EXPECT_FLOAT_EQ(150.0f, ptx_oven_get_temp_target_c());
+}
+
+TEST_F(ConfigStoreTest, CorruptNewestFallsBackThenIsReplaced) {
+    ASSERT_FALSE(ptx_config_store_load());
+    ASSERT_TRUE(ptx_oven_set_temp_target_c(150.0f));
+    ASSERT_TRUE(ptx_config_store_save());
+    ASSERT_TRUE(ptx_oven_set_temp_target_c(160.0f));
+    ASSERT_TRUE(ptx_config_store_save());
+
+    uint8_t byte;
+    read_eeprom((uint16_t)(slot_addr(1) + 25U), &byte, 1);
+    byte ^= 0x04U;
+    update_eeprom((uint16_t)(slot_addr(1) + 25U), &byte, 1);
+
+    reboot();
+    EXPECT_TRUE(ptx_config_store_load());
+    EXPECT_FLOAT_EQ(150.0f, ptx_oven_get_temp_target_c()) << "CRC rejects the newest";
+
+    /* The next save must win over the corrupt record's sequence */
+    ASSERT_TRUE(ptx_oven_set_temp_target_c(170.0f));
+    ASSERT_TRUE(ptx_config_store_save());
+    reboot();
+    EXPECT_TRUE(ptx_config_store_load());
+    EXPECT_FLOAT_EQ(170.0f, ptx_oven_get_temp_target_c());
+}
+
+TEST_F(ConfigStoreTest, OtherFormatVersionIsIgnored) {
+    ASSERT_FALSE(ptx_config_store_load());
+    ASSERT_TRUE(ptx_oven_set_temp_target_c(150.0f));
+    ASSERT_TRUE(ptx_config_store_save());
+
+    uint8_t version = PTX_CONFIG_RECORD_VERSION + 1U;
+    update_eeprom((uint16_t)(slot_addr(0) + 1U), &version, 1);
+
+    reboot();
+    EXPECT_FALSE(ptx_config_store_load());
+    EXPECT_FLOAT_EQ(ptx_oven_get_config_defaults()->temp_target_c, ptx_oven_get_temp_target_c());
+}
@@ -0,0 +1,153 @@
+/**
+ * @file test_event_queue_gtest.cpp
+ * @brief Google Test suite for the ISR event queue and door latency instrumentation
+ */
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include "ptx_event_queue.h"
+#include "ptx_oven_control.h"
+#include "ptx_oven_config.h"
+#include "tests/mocks/mock_api.h"
+
+static ptx_event_t make_event(uint8_t value, uint32_t time_us) {
+    ptx_event_t ev;
+    ev.type = PTX_EVENT_DOOR;
+    ev.value = value;
+    ev.time_us = time_us;
+    ev.ack_us = time_us + 1U;
+    return ev;
+}
+
+class EventQueueTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ptx_event_queue_reset();
+    }
+};
+
+TEST_F(EventQueueTest, FifoOrder) {
+    ptx_event_t ev;
+    EXPECT_FALSE(ptx_event_pop(&ev));
+
+    for (uint8_t i = 0; i < 3; ++i) {
+        ev = make_event(i, 100U * i);
+        ASSERT_TRUE(ptx_event_push(&ev));
+    }
+    for (uint8_t i = 0; i < 3; ++i) {
+        ASSERT_TRUE(ptx_event_pop(&ev));
+        EXPECT_EQ(i, ev.value);
+        EXPECT_EQ(100U * i, ev.time_us);
+    }
+    EXPECT_FALSE(ptx_event_pop(&ev));
+}
+
+TEST_F(EventQueueTest, FullQueueDropsNewest) {
+    ptx_event_t ev;
+    for (uint32_t i = 0; i < PTX_EVENT_QUEUE_SIZE; ++i) {
+        ev = make_event(1, i);
+        ASSERT_TRUE(ptx_event_push(&ev));
+    }
+    ev = make_event(1, 999);
+    EXPECT_FALSE(ptx_event_push(&ev));
+    EXPECT_EQ(1U, ptx_event_dropped());
+
+    ASSERT_TRUE(ptx_event_pop(&ev));
+    EXPECT_EQ(0U, ev.time_us);
+}
+
+TEST_F(EventQueueTest, IndicesWrapAround) {
+    ptx_event_t ev;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        ev = make_event((uint8_t)i, i);
+        ASSERT_TRUE(ptx_event_push(&ev));
+        ASSERT_TRUE(ptx_event_pop(&ev));
+        ASSERT_EQ(i, ev.time_us);
+    }
+    EXPECT_EQ(0U, ptx_event_dropped());
+}
+
+TEST_F(EventQueueTest, ConcurrentProducerAndConsumer) {
+    const uint32_t kEvents = 10000;
+    std::atomic<bool> stop(false);
+
+    std::thread producer([&]() {
+        for (uint32_t i = 0; (i < kEvents) && !stop.load(); ++i) {
+            ptx_event_t ev = make_event((uint8_t)i, i);
+            while (!ptx_event_push(&ev) && !stop.load()) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    // Every event arrives once, complete and in order; checked after the join
+    uint32_t expected = 0;
+    bool intact = true;
+    ptx_event_t bad = {};
+    while (expected < kEvents) {
+        ptx_event_t ev;
+        if (!ptx_event_pop(&ev)) {
+            std::this_thread::yield();
+            continue;
+        }
+        if ((ev.time_us != expected) || (ev.ack_us != expected + 1U) || (ev.value != (uint8_t)expected)) {
+            intact = false;
+            bad = ev;
+            stop.store(true);
+            break;
+        }
+        expected++;
+    }
+    producer.join();
+    EXPECT_TRUE(intact) << "event " << expected << ": time_us=" << bad.time_us
+                        << " ack_us=" << bad.ack_us << " value=" << (int)bad.value;
+    EXPECT_EQ(kEvents, expected);
+}
+
+TEST(LatencyHistTest, PowerOfTwoBuckets) {
+    ptx_hist_t hist;
+    ptx_hist_reset(&hist);
+
+    const uint32_t samples[] = {0, 1, 2, 3, 4, 100, 1000000};
+    for (uint32_t us : samples) ptx_hist_add(&hist, us);
+
+    EXPECT_EQ(2U, hist.bucket[0]);
+    EXPECT_EQ(2U, hist.bucket[1]);
+    EXPECT_EQ(1U, hist.bucket[2]);
+    EXPECT_EQ(1U, hist.bucket[6]);
+    EXPECT_EQ(1U, hist.bucket[PTX_HIST_BUCKETS - 1U]);
+    EXPECT_EQ(7U, hist.count);
+    EXPECT_EQ(1000000U, hist.max_us);
+}
+
+TEST(DoorIsrTest, StopsGasAtOnceAndRecordsLatency) {
+    ptx_event_queue_reset();
+    ptx_oven_reset_config_to_defaults();
+    mock_reset_time(0);
+    mock_set_vref_mv(5000);
+    mock_set_signal_mv(1500);       // Cold: heating demanded
+    ptx_oven_set_door_state(false);
+    ptx_oven_control_init();
+
+    for (int i = 0; i < 10; ++i) {
+        mock_advance_ms(100);
+        ptx_oven_control_update();
+    }
+    ASSERT_TRUE(mock_get_gas_output());
+
+    ptx_oven_door_isr(true);
+    EXPECT_FALSE(mock_get_gas_output()) << "Gas must close in the interrupt, not on the next update";
+    EXPECT_EQ(0U, ptx_oven_get_door_latency()->count);
+
+    mock_advance_ms(100);
+    ptx_oven_control_update();
+    EXPECT_FALSE(mock_get_gas_output()) << "Control loop must see the door level";
+    EXPECT_TRUE(ptx_oven_get_status()->door_open);
+    EXPECT_EQ(1U, ptx_oven_get_door_latency()->count);
+
+    ptx_oven_door_isr(false);
+    mock_advance_ms(100);
+    ptx_oven_control_update();
+    EXPECT_FALSE(ptx_oven_get_status()->door_open);
+    EXPECT_EQ(1U, ptx_oven_get_door_latency()->count);
+}
@@ -0,0 +1,247 @@
+/**
+ * @file test_flame_gtest.cpp
+ * @brief Google Test suite for rate-of-rise flame detection (PTX_FLAME_DETECT_ENABLED=1)
+ */
+#include <gtest/gtest.h>
+#include "ptx_slope.h"
+#include "ptx_oven_control.h"
+#include "ptx_oven_config.h"
+#include "tests/sim/ptx_sim.h"
+
+static_assert(PTX_FLAME_DETECT_ENABLED, "build this suite with PTX_FLAME_DETECT_ENABLED=1");
+
+static const uint32_t kHourMs = 3600U * 1000U;
+
+TEST(SlopeTest, ExactLine) {
+    ptx_slope_t s;
+    ptx_slope_reset(&s);
+    for (uint32_t t = 0; t <= 5000U; t += 100U) {
+        ptx_slope_add(&s, t, (int32_t)(t * 2U / 10U) + 700);    /* 200 per s */
+    }
+    EXPECT_EQ(200, ptx_slope_per_s(&s));
+    EXPECT_TRUE(ptx_slope_at_least(&s, 200));
+    EXPECT_FALSE(ptx_slope_at_least(&s, 201));
+}
+
+TEST(SlopeTest, FlatAndFallingAreNotARise) {
+    ptx_slope_t flat, falling;
+    ptx_slope_reset(&flat);
+    ptx_slope_reset(&falling);
+    for (uint32_t t = 0; t <= 3000U; t += 100U) {
+        ptx_slope_add(&flat, t, (t % 200U == 0U) ? 50 : -50);   /* Noise around a constant */
+        ptx_slope_add(&falling, t, -(int32_t)t);
+    }
+    EXPECT_FALSE(ptx_slope_at_least(&flat, 100));
+    EXPECT_TRUE(ptx_slope_at_least(&flat, -100));
+    EXPECT_EQ(-1000, ptx_slope_per_s(&falling));
+    EXPECT_FALSE(ptx_slope_at_least(&falling, 0));
+}
+
+TEST(SlopeTest, NoVerdictWithoutTwoTimes) {
+    ptx_slope_t s;
+    ptx_slope_reset(&s);
+    EXPECT_FALSE(ptx_slope_at_least(&s, -1000000));
+    ptx_slope_add(&s, 0U, 0);
+    ptx_slope_add(&s, 0U, 100);
+    EXPECT_FALSE(ptx_slope_at_least(&s, -1000000));
+    EXPECT_EQ(0, ptx_slope_per_s(&s));
+}
+
+TEST(SlopeTest, LongWindowStopsFittingInsteadOfOverflowing) {
+    /* 100 000 samples over 10 000 s, well past the fitted window */
+    ptx_slope_t s;
+    ptx_slope_reset(&s);
+    for (uint32_t i = 0; i < 100000U; ++i) {
+        uint32_t t = i * 100U;
+        ptx_slope_add(&s, t, (int32_t)(t / 2U));               /* 500 per s */
+    }
+    EXPECT_EQ(PTX_SLOPE_MAX_SAMPLES, s.n);
+    EXPECT_EQ(500, ptx_slope_per_s(&s));
+    EXPECT_TRUE(ptx_slope_at_least(&s, 500));
+    EXPECT_FALSE(ptx_slope_at_least(&s, 501));
+    EXPECT_FALSE(ptx_slope_at_least(&s, PTX_SLOPE_MAX_RATE));
+}
+
+class FlameTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ptx_oven_reset_config_to_defaults();
+        ptx_sim_default_params(&params);
+        params.dead_time_ms = 1000U;        /* Probe close to the burner */
+    }
+
+    void start(void) {
+        ptx_sim_init(&sim, &params, 0);
+        io = ptx_sim_io(&sim);
+        ptx_oven_control_init_ctx(&ctx, NULL, &io);
+    }
+
+    // Hold ignition off (door open) until the probe filter has a full window
+    void settle(void) {
+        ptx_sim_set_door(&sim, true);
+        ptx_oven_set_door_state_ctx(&ctx, true);
+        ptx_sim_run(&sim, &ctx, 2000U, 100U);
+        ptx_sim_set_door(&sim, false);
+        ptx_oven_set_door_state_ctx(&ctx, false);
+    }
+
+    // Run until the state changes from `from` (or max_ms passes); returns the time taken
+    uint32_t run_while(ptx_heating_state_t from, uint32_t max_ms) {
+        uint32_t t0 = sim.now_ms;
+        while ((ctx.status.state == from) && ((sim.now_ms - t0) < max_ms)) {
+            ptx_sim_run(&sim, &ctx, 100U, 100U);
+        }
+        return sim.now_ms - t0;
+    }
+
+    ptx_sim_params_t params;
+    ptx_sim_t sim;
+    ptx_io_table_t io;
+    ptx_oven_ctx_t ctx;
+};
+
+TEST_F(FlameTest, ColdStartConfirmsFlameBeforeWindowEnds) {
+    start();
+    run_while(PTX_HEATING_STATE_IDLE, 1000U);
+    ASSERT_EQ(PTX_HEATING_STATE_IGNITING, ctx.status.state);
+
+    uint32_t igniting_ms = run_while(PTX_HEATING_STATE_IGNITING, 10000U);
+    EXPECT_EQ(PTX_HEATING_STATE_HEATING, ctx.status.state);
+    EXPECT_LT(igniting_ms, ctx.config.ignition_duration_ms) << "Igniter off early";
+    EXPECT_FALSE(ctx.status.igniter_on);
+    EXPECT_TRUE(ctx.status.gas_on);
+    EXPECT_EQ(0U, ctx.ignition_attempt);
+}
+
+TEST_F(FlameTest, HotReignitionConfirmsFlame) {
+    start();
+    ptx_sim_run(&sim, &ctx, 2U * kHourMs, 100U);
+
+    /* Every cycle near the target ignited: no failed attempt, no lockout */
+    EXPECT_NE(PTX_HEATING_STATE_LOCKOUT, ctx.status.state);
+    EXPECT_GT(sim.stats.ignitions, 5U);
+    EXPECT_NEAR(ctx.config.temp_target_c, sim.temp_c, ctx.config.temp_delta_c + 5.0);
+}
+
+TEST_F(FlameTest, NoFlameRetriesAfterPurgeThenLocksOut) {
+    params.gain_c = 0.0;                    /* Gas never lights */
+    start();
+
+    for (uint8_t attempt = 1; attempt <= ctx.config.max_ignition_attempts; ++attempt) {
+        run_while(PTX_HEATING_STATE_IDLE, 2U * PTX_IGNITION_PURGE_MS);
+        ASSERT_EQ(PTX_HEATING_STATE_IGNITING, ctx.status.state) << "attempt " << (int)attempt;
+        EXPECT_EQ(attempt, ctx.ignition_attempt);
+
+        uint32_t igniting_ms = run_while(PTX_HEATING_STATE_IGNITING, 10000U);
+        EXPECT_GE(igniting_ms, ctx.config.ignition_duration_ms);
+        EXPECT_FALSE(ctx.status.gas_on) << "Gas closed when no flame";
+        EXPECT_FALSE(ctx.status.igniter_on);
+
+        if (attempt < ctx.config.max_ignition_attempts) {
+            ASSERT_EQ(PTX_HEATING_STATE_IDLE, ctx.status.state);
+            uint32_t purge_ms = run_while(PTX_HEATING_STATE_IDLE, 2U * PTX_IGNITION_PURGE_MS);
+            EXPECT_GE(purge_ms, PTX_IGNITION_PURGE_MS - 100U) << "Purge before the next attempt";
+            EXPECT_LE(purge_ms, PTX_IGNITION_PURGE_MS + 100U);
+        }
+    }
+    EXPECT_EQ(PTX_HEATING_STATE_LOCKOUT, ctx.status.state);
+    EXPECT_TRUE(ctx.status.ignition_lockout);
+
+    /* Lockout survives the door and needs a manual reset */
+    ptx_sim_set_door(&sim, true);
+    ptx_oven_set_door_state_ctx(&ctx, true);
+    ptx_sim_run(&sim, &ctx, 1000U, 100U);
+    ptx_sim_set_door(&sim, false);
+    ptx_oven_set_door_state_ctx(&ctx, false);
+    ptx_sim_run(&sim, &ctx, 60000U, 100U);
+    EXPECT_EQ(PTX_HEATING_STATE_LOCKOUT, ctx.status.state);
+    EXPECT_FALSE(ctx.status.gas_on);
+
+    ptx_oven_reset_ignition_lockout_ctx(&ctx);
+    EXPECT_FALSE(ctx.status.ignition_lockout);
+    ptx_sim_run(&sim, &ctx, 1000U, 100U);
+    EXPECT_EQ(PTX_HEATING_STATE_IGNITING, ctx.status.state);
+}
+
+TEST_F(FlameTest, DoorOpenedDuringPurgeDoesNotSkipIt) {
+    params.gain_c = 0.0;
+    start();
+    run_while(PTX_HEATING_STATE_IDLE, 1000U);
+    run_while(PTX_HEATING_STATE_IGNITING, 10000U);
+    ASSERT_EQ(PTX_HEATING_STATE_IDLE, ctx.status.state);
+    uint32_t purge_start_ms = ctx.purge_start_ms;
+
+    /* Door open and shut a few seconds into the purge */
+    ptx_sim_run(&sim, &ctx, 3000U, 100U);
+    ptx_sim_set_door(&sim, true);
+    ptx_oven_set_door_state_ctx(&ctx, true);
+    ptx_sim_run(&sim, &ctx, 500U, 100U);
+    ptx_sim_set_door(&sim, false);
+    ptx_oven_set_door_state_ctx(&ctx, false);
+
+    run_while(PTX_HEATING_STATE_IDLE, 2U * PTX_IGNITION_PURGE_MS);
+    ASSERT_EQ(PTX_HEATING_STATE_IGNITING, ctx.status.state);
+    EXPECT_GE(sim.now_ms - purge_start_ms, PTX_IGNITION_PURGE_MS) << "Purge ran to the end";
+    EXPECT_EQ(2U, ctx.ignition_attempt) << "Count kept across the door";
+}
+
+TEST_F(FlameTest, FaultsBetweenAttemptsStillLockOut) {
+    params.gain_c = 0.0;
+    start();
+
+    /* Fail every attempt, with a vref glitch or a door cycle during each purge */
+    for (uint8_t attempt = 1; attempt < ctx.config.max_ignition_attempts; ++attempt) {
+        run_while(PTX_HEATING_STATE_IDLE, 2U * PTX_IGNITION_PURGE_MS);
+        run_while(PTX_HEATING_STATE_IGNITING, 10000U);
+        ASSERT_EQ(PTX_HEATING_STATE_IDLE, ctx.status.state) << "attempt " << (int)attempt;
+
+        uint16_t vref_mv = sim.p.vref_mv;
+        sim.p.vref_mv = 3000U;
+        bool faulted = false;
+        for (uint8_t i = 0; i < 10U; ++i) {
+            ptx_sim_run(&sim, &ctx, 100U, 100U);
+            faulted = faulted || ctx.status.sensor_fault;
+        }
+        sim.p.vref_mv = vref_mv;
+        EXPECT_TRUE(faulted) << "Glitch seen as a sensor fault";
+        EXPECT_EQ(attempt, ctx.ignition_attempt);
+    }
+
+    run_while(PTX_HEATING_STATE_IDLE, 2U * PTX_IGNITION_PURGE_MS);
+    ASSERT_EQ(PTX_HEATING_STATE_IGNITING, ctx.status.state);
+
+    /* Door opened on the last attempt: interrupted counts as failed */
+    ptx_sim_set_door(&sim, true);
+    ptx_oven_set_door_state_ctx(&ctx, true);
+    ptx_sim_run(&sim, &ctx, 500U, 100U);
+    EXPECT_EQ(PTX_HEATING_STATE_LOCKOUT, ctx.status.state);
+    EXPECT_TRUE(ctx.status.ignition_lockout);
+    EXPECT_FALSE(ctx.status.gas_on);
+}
+
+TEST_F(FlameTest, NoisyProbeDoesNotFakeAFlame) {
+    params.gain_c = 0.0;                    /* Default probe noise, no flame */
+    for (uint32_t seed = 1; seed <= 50U; ++seed) {
+        params.seed = seed;
+        start();
+        settle();
+        run_while(PTX_HEATING_STATE_IDLE, 1000U);
+        ASSERT_EQ(PTX_HEATING_STATE_IGNITING, ctx.status.state);
+        run_while(PTX_HEATING_STATE_IGNITING, 10000U);
+        EXPECT_NE(PTX_HEATING_STATE_HEATING, ctx.status.state) << "seed " << seed;
+    }
+}
+
+TEST_F(FlameTest, NextEventCoversPurgeAndConfirmation) {
+    params.gain_c = 0.0;
+    start();
+    run_while(PTX_HEATING_STATE_IDLE, 1000U);
+    ASSERT_EQ(PTX_HEATING_STATE_IGNITING, ctx.status.state);
+    EXPECT_EQ(0U, ptx_oven_next_event_ctx(&ctx, sim.now_ms, PTX_NEXT_TEMP, NULL, NULL))
+        << "Flame confirmation needs every reading";
+
+    run_while(PTX_HEATING_STATE_IGNITING, 10000U);
+    ASSERT_EQ(PTX_HEATING_STATE_IDLE, ctx.status.state);
+    uint32_t next = ptx_oven_next_event_ctx(&ctx, sim.now_ms, PTX_NEXT_IGNITION, NULL, NULL);
+    EXPECT_EQ(PTX_IGNITION_PURGE_MS - (sim.now_ms - ctx.purge_start_ms), next);
+}
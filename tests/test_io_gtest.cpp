@@ -0,0 +1,51 @@
+/**
+ * @file test_io_gtest.cpp
+ * @brief Google Test suite for the compile-time I/O bindings
+ */
+#include <gtest/gtest.h>
+#include "ptx_io.h"
+#include "tests/mocks/mock_api.h"
+
+static_assert(ptx_output_traits<GAS_VALVE>::pin == GAS_VALVE_PIN, "gas valve pin");
+static_assert(ptx_output_traits<IGNITER>::pin == IGNITER_PIN, "igniter pin");
+static_assert(ptx_output_traits<SYS_LED_STATUS>::pin == SYS_LED_STATUS_PIN, "status LED pin");
+static_assert(ptx_input_traits<TEMPERATURE_SENSOR>::channel == 0U, "signal on A0");
+static_assert(ptx_input_traits<TEMPERATURE_SENSOR_REFERENCE>::channel == 1U, "reference on A1");
+
+TEST(IoBindingTest, HostOutputsRouteToMock) {
+    ptx_io_write<GAS_VALVE>(true);
+    EXPECT_TRUE(mock_get_gas_output());
+    EXPECT_TRUE(ptx_io_read<GAS_VALVE>());
+
+    ptx_io_write<IGNITER>(true);
+    EXPECT_TRUE(mock_get_igniter_output());
+
+    ptx_io_write<GAS_VALVE>(false);
+    ptx_io_write<IGNITER>(false);
+    EXPECT_FALSE(mock_get_gas_output());
+    EXPECT_FALSE(ptx_io_read<IGNITER>());
+}
+
+TEST(IoBindingTest, HostInputsRouteToMock) {
+    mock_set_vref_mv(4900);
+    mock_set_signal_mv(1234);
+    EXPECT_EQ(4900U, ptx_io_read_mv<TEMPERATURE_SENSOR_REFERENCE>());
+    EXPECT_EQ(1234U, ptx_io_read_mv<TEMPERATURE_SENSOR>());
+}
+
+TEST(IoBindingTest, AdcScaling) {
+    typedef ptx_input_traits<TEMPERATURE_SENSOR> signal;
+    typedef ptx_input_traits<TEMPERATURE_SENSOR_REFERENCE> vref;
+
+    EXPECT_EQ(0U, signal::to_mv(0));
+    EXPECT_EQ(5000U, signal::to_mv(1023));
+    EXPECT_EQ(4500U, vref::to_mv(0));
+    EXPECT_EQ(5500U, vref::to_mv(1023));
+
+    /* Two fractional bits in and out: 512 counts is 2502.44 mV, i.e. 10009 quarter-mV */
+    EXPECT_EQ(2502U, signal::to_mv(512));
+    EXPECT_EQ(10009U, signal::to_mv_q(4 * 512, 2));
+    EXPECT_EQ(10014U, signal::to_mv_q(4 * 512 + 1, 2)) << "A quarter count is 1.22 mV";
+    EXPECT_EQ(4U * 4500U, vref::to_mv_q(0, 2));
+    EXPECT_EQ(4U * 5500U, vref::to_mv_q(4 * 1023, 2));
+}
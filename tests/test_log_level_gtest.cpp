@@ -0,0 +1,61 @@
+/**
+ * @file test_log_level_gtest.cpp
+ * @brief Google Test suite for compile-time log levels and the constexpr file name
+ */
+/* This module logs warnings and errors only */
+#define PTX_LOG_MODULE_LEVEL PTX_LOG_LEVEL_WARN
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include "ptx_logging.h"
+
+static int pti_evaluated = 0;
+
+static int count_evaluation(void) {
+    return ++pti_evaluated;
+}
+
+static const char* filename_a(void) { return PTX_LOG_FILENAME; }
+static const char* filename_b(void) { return PTX_LOG_FILENAME; }
+
+static_assert(ptx_get_filename("/a/b/ptx_oven_control.cpp")[0] == 'p', "basename is computed at compile time");
+static_assert(ptx_log_strlen(ptx_get_filename("C:\\src\\x.cpp")) == 5U, "backslash paths are handled");
+
+TEST(LogLevelTest, DisabledLevelsDoNotEvaluateArguments) {
+    pti_evaluated = 0;
+    PTX_LOG_TRACE("trace %d", count_evaluation());
+    PTX_LOG_DEBUG("debug %d", count_evaluation());
+    PTX_LOG_INFO("info %d", count_evaluation());
+    PTX_DBG_LOGF("debug %d", count_evaluation());
+    EXPECT_EQ(0, pti_evaluated);
+
+    PTX_LOG_WARN("warn %d", count_evaluation());
+    PTX_LOG_ERROR("error %d", count_evaluation());
+    EXPECT_EQ(2, pti_evaluated);
+}
+
+TEST(LogLevelTest, DisabledCallIsAVoidExpression) {
+    // Usable wherever a statement is, e.g. an unbraced if/else
+    if (pti_evaluated >= 0)
+        PTX_LOG_DEBUG("never");
+    else
+        PTX_LOG_ERROR("never");
+    SUCCEED();
+}
+
+TEST(LogLevelTest, FilenameIsBasenameOnly) {
+    EXPECT_STREQ("test_log_level_gtest.cpp", PTX_LOG_FILENAME);
+    EXPECT_STREQ("ptx_oven_control.cpp", ptx_get_filename("/a/b/ptx_oven_control.cpp"));
+}
+
+TEST(LogLevelTest, FilenameIsSharedBetweenCallSites) {
+    EXPECT_EQ(filename_a(), filename_b());
+}
+
+TEST(LogLevelTest, FlashFormatHelpersFormatLikePrintf) {
+    char buffer[48];
+    int n = ptx_snprintf_P(buffer, sizeof(buffer), PTX_PSTR("[%lu][%" PTX_PRI_PSTR ":%d] "),
+                           12UL, PTX_LOG_FILENAME, 34);
+    EXPECT_STREQ("[12][test_log_level_gtest.cpp:34] ", buffer);
+    EXPECT_EQ((int)strlen(buffer), n);
+}
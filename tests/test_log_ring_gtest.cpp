@@ -0,0 +1,157 @@
+/**
+ * @file test_log_ring_gtest.cpp
+ * @brief Google Test suite for deferred binary logging records and the log ring
+ */
+#include <gtest/gtest.h>
+#include <vector>
+#include "ptx_logging.h"
+#include "tests/mocks/mock_api.h"
+
+// Drain everything currently in the ring
+static std::vector<uint8_t> drain_ring() {
+    std::vector<uint8_t> out;
+    const uint8_t* data;
+    uint16_t n;
+    while ((n = ptx_log_ring_peek(&data)) > 0U) {
+        out.insert(out.end(), data, data + n);
+        ptx_log_ring_consume(n);
+    }
+    return out;
+}
+
+static int32_t read_i32(const std::vector<uint8_t>& b, size_t pos) {
+    return (int32_t)((uint32_t)b[pos] | ((uint32_t)b[pos + 1] << 8) |
+                     ((uint32_t)b[pos + 2] << 16) | ((uint32_t)b[pos + 3] << 24));
+}
+
+class LogRingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ptx_log_ring_reset();
+        mock_reset_time(0);
+    }
+};
+
+TEST_F(LogRingTest, FileIdIsFnvOfBasename) {
+    // Same hash the host decoder computes from the file name
+    uint32_t h = 2166136261UL;
+    for (const char* p = "test_log_ring_gtest.cpp"; *p; ++p) {
+        h = (h ^ (uint8_t)*p) * 16777619UL;
+    }
+    uint16_t expected = (uint16_t)((h >> 16) ^ (h & 0xFFFFUL));
+    EXPECT_EQ(expected, PTX_LOG_FILE_ID);
+    EXPECT_EQ(expected, ptx_log_file_id("/some/dir/test_log_ring_gtest.cpp"));
+}
+
+TEST_F(LogRingTest, RecordLayout) {
+    mock_reset_time(0x01020304UL);
+    ptx_log_deferred(0xBEEF, 321, PTX_TX_PRIO_NORMAL, 7, "OPEN", -3, true);
+
+    std::vector<uint8_t> b = drain_ring();
+    ASSERT_EQ(PTX_LOG_HEADER_SIZE + 5U + 6U + 5U + 5U, b.size());
+    EXPECT_EQ(PTX_LOG_SYNC, b[0]);
+    EXPECT_EQ(b.size() - 2U, b[1]);
+    EXPECT_EQ(0x01020304, read_i32(b, 2));
+    EXPECT_EQ(0xEF, b[6]);
+    EXPECT_EQ(0xBE, b[7]);
+    EXPECT_EQ(321 & 0xFF, b[8]);
+    EXPECT_EQ(321 >> 8, b[9]);
+
+    size_t pos = PTX_LOG_HEADER_SIZE;
+    EXPECT_EQ(PTX_LOG_ARG_INT, b[pos]);
+    EXPECT_EQ(7, read_i32(b, pos + 1));
+    pos += 5;
+    EXPECT_EQ(PTX_LOG_ARG_STR, b[pos]);
+    EXPECT_EQ(4, b[pos + 1]);
+    EXPECT_EQ(0, memcmp(&b[pos + 2], "OPEN", 4));
+    pos += 6;
+    EXPECT_EQ(-3, read_i32(b, pos + 1));
+    pos += 5;
+    EXPECT_EQ(1, read_i32(b, pos + 1));
+}
+
+TEST_F(LogRingTest, RecordIsBoundedAndStringsTruncated) {
+    ptx_log_deferred(1, 1, PTX_TX_PRIO_NORMAL, "a string that is much longer than the limit", 1, 2, 3, 4, 5, 6, 7, 8, 9);
+    std::vector<uint8_t> b = drain_ring();
+    EXPECT_LE(b.size(), PTX_LOG_RECORD_MAX);
+    EXPECT_EQ(PTX_LOG_STR_MAX, b[PTX_LOG_HEADER_SIZE + 1]);
+}
+
+TEST_F(LogRingTest, FullRingDropsWholeRecords) {
+    uint8_t rec[40];
+    memset(rec, 0x11, sizeof(rec));
+
+    int written = 0;
+    while (ptx_log_ring_write(rec, sizeof(rec), PTX_TX_PRIO_HIGH)) written++;
+    EXPECT_EQ(PTX_LOG_RING_SIZE / sizeof(rec), (size_t)written);
+    EXPECT_EQ(1, ptx_log_ring_dropped());
+    EXPECT_EQ(written * sizeof(rec), ptx_log_ring_used());
+}
+
+TEST_F(LogRingTest, PriorityLimitsReserveSpace) {
+    uint8_t rec[16];
+    memset(rec, 0x22, sizeof(rec));
+
+    // Periodic records stop at half the ring
+    while (ptx_log_ring_write(rec, sizeof(rec), PTX_TX_PRIO_LOW)) {}
+    EXPECT_EQ(PTX_LOG_RING_SIZE / 2U, ptx_log_ring_used());
+
+    // Events stop at three quarters
+    while (ptx_log_ring_write(rec, sizeof(rec), PTX_TX_PRIO_NORMAL)) {}
+    EXPECT_EQ((PTX_LOG_RING_SIZE / 4U) * 3U, ptx_log_ring_used());
+
+    // Errors still get in, up to the whole ring
+    EXPECT_TRUE(ptx_log_ring_write(rec, sizeof(rec), PTX_TX_PRIO_HIGH));
+    while (ptx_log_ring_write(rec, sizeof(rec), PTX_TX_PRIO_HIGH)) {}
+    EXPECT_EQ(PTX_LOG_RING_SIZE, ptx_log_ring_used());
+}
+
+TEST_F(LogRingTest, DeferredPriorityFollowsTextMode) {
+    static_assert(ptx_log_classify("[ERROR] ignition failed", PTX_TX_PRIO_NORMAL) == PTX_TX_PRIO_HIGH, "");
+    static_assert(ptx_log_classify("[WARN] door", PTX_TX_PRIO_LOW) == PTX_TX_PRIO_HIGH, "");
+    static_assert(ptx_log_classify("[ERR", PTX_TX_PRIO_NORMAL) == PTX_TX_PRIO_NORMAL, "");
+    static_assert(ptx_log_level_prio(PTX_LOG_LEVEL_DEBUG, "[ERROR]") == PTX_TX_PRIO_LOW, "");
+    static_assert(ptx_log_level_prio(PTX_LOG_LEVEL_INFO, "x") == PTX_TX_PRIO_NORMAL, "");
+    static_assert(ptx_log_level_prio(PTX_LOG_LEVEL_INFO, "[WARN] x") == PTX_TX_PRIO_HIGH, "");
+    static_assert(ptx_log_level_prio(PTX_LOG_LEVEL_ERROR, "x") == PTX_TX_PRIO_HIGH, "");
+
+    // A ring full of periodic status still takes the error
+    while (ptx_log_ring_dropped() == 0U) {
+        ptx_log_deferred(1, 10, PTX_TX_PRIO_LOW, 1, 2, 3);
+    }
+    EXPECT_LE(ptx_log_ring_used(), PTX_LOG_RING_SIZE / 2U);
+
+    uint16_t used = ptx_log_ring_used();
+    ptx_log_deferred(1, 12, ptx_log_level_prio(PTX_LOG_LEVEL_ERROR, "x"), 1);
+    EXPECT_GT(ptx_log_ring_used(), used);
+}
+
+TEST_F(LogRingTest, WrapsAround) {
+    uint8_t rec[48];
+    for (int round = 0; round < 100; ++round) {
+        memset(rec, round, sizeof(rec));
+        ASSERT_TRUE(ptx_log_ring_write(rec, sizeof(rec), PTX_TX_PRIO_NORMAL));
+        std::vector<uint8_t> b = drain_ring();
+        ASSERT_EQ(sizeof(rec), b.size());
+        ASSERT_EQ(std::vector<uint8_t>(rec, rec + sizeof(rec)), b);
+    }
+    EXPECT_EQ(0, ptx_log_ring_dropped());
+}
+
+TEST_F(LogRingTest, PeekRecordCopiesWholeRecordAcrossWrap) {
+    uint8_t rec[PTX_LOG_RECORD_MAX];
+    uint8_t out[PTX_LOG_RECORD_MAX];
+
+    for (int round = 0; round < 100; ++round) {
+        uint8_t len = (uint8_t)(PTX_LOG_HEADER_SIZE + round % 40);
+        rec[0] = PTX_LOG_SYNC;
+        rec[1] = (uint8_t)(len - 2U);
+        for (uint8_t i = 2; i < len; ++i) rec[i] = (uint8_t)(round + i);
+
+        ASSERT_TRUE(ptx_log_ring_write(rec, len, PTX_TX_PRIO_NORMAL));
+        ASSERT_EQ(len, ptx_log_ring_peek_record(out));
+        ASSERT_EQ(0, memcmp(rec, out, len));
+        ptx_log_ring_consume(len);
+    }
+    EXPECT_EQ(0U, ptx_log_ring_peek_record(out));
+}
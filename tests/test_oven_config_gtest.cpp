@@ -0,0 +1,182 @@
+/**
+ * @file test_oven_config_gtest.cpp
+ * @brief Google Test suite for the validated, double-buffered configuration
+ */
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include "ptx_oven_config.h"
+#include "ptx_calibration.h"
+
+class OvenConfigTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ptx_oven_reset_config_to_defaults();
+        base = *ptx_oven_get_config();
+    }
+    void TearDown() override {
+        ptx_oven_reset_config_to_defaults();
+    }
+
+    ptx_oven_config_t base;
+};
+
+TEST_F(OvenConfigTest, DefaultsAreValid) {
+    EXPECT_EQ(PTX_CONFIG_OK, ptx_oven_config_validate(&base));
+    EXPECT_EQ(PTX_CONFIG_ERR_NULL, ptx_oven_config_validate(NULL));
+}
+
+TEST_F(OvenConfigTest, ResetRestoresTheBootDefaults) {
+    const ptx_oven_config_t* defaults = ptx_oven_get_config_defaults();
+    EXPECT_FLOAT_EQ(2.0f, defaults->temp_delta_c);
+    EXPECT_EQ(100U, defaults->iteration_period);
+
+    ptx_oven_set_temp_delta_c(5.0f);
+    ptx_oven_reset_config_to_defaults();
+    EXPECT_EQ(0, memcmp(defaults, ptx_oven_get_config(), sizeof(ptx_oven_config_t)));
+}
+
+TEST_F(OvenConfigTest, RoundsToTheNearestMilliUnit) {
+    EXPECT_EQ(4500, ptx_oven_round_milli(4.5f));
+    EXPECT_EQ(182001, ptx_oven_round_milli(182.0006f));
+    EXPECT_EQ(-48750, ptx_oven_round_milli(-48.75f));
+    EXPECT_EQ(-1, ptx_oven_round_milli(-0.0006f)) << "Halves away from zero";
+
+    ptx_oven_thresholds_t th;
+    ptx_oven_config_thresholds(&base, &th);
+    EXPECT_EQ(ptx_oven_round_milli(base.temp_target_c + base.temp_delta_c), th.temp_off_mc);
+}
+
+TEST_F(OvenConfigTest, ValidateNamesTheBrokenRule) {
+    ptx_oven_config_t cfg = base;
+    cfg.iteration_period = 0U;
+    EXPECT_EQ(PTX_CONFIG_ERR_TIMING, ptx_oven_config_validate(&cfg));
+
+    cfg = base;
+    cfg.vref_min_v = 5.5f;
+    cfg.vref_max_v = 4.5f;
+    EXPECT_EQ(PTX_CONFIG_ERR_VREF_RANGE, ptx_oven_config_validate(&cfg));
+    cfg.vref_min_v = NAN;
+    cfg.vref_max_v = 5.5f;
+    EXPECT_EQ(PTX_CONFIG_ERR_VREF_RANGE, ptx_oven_config_validate(&cfg));
+    cfg.vref_min_v = 4.5f;
+    cfg.vref_max_v = PTX_CONFIG_VREF_LIMIT_V + 0.5f;
+    EXPECT_EQ(PTX_CONFIG_ERR_VREF_RANGE, ptx_oven_config_validate(&cfg));
+
+    cfg = base;
+    cfg.temp_delta_c = 0.0f;
+    EXPECT_EQ(PTX_CONFIG_ERR_TEMPERATURE, ptx_oven_config_validate(&cfg)) << "No hysteresis";
+    cfg.temp_delta_c = 5.0f;
+    cfg.temp_target_c = 298.0f;
+    EXPECT_EQ(PTX_CONFIG_ERR_TEMPERATURE, ptx_oven_config_validate(&cfg)) << "Never reaches off";
+    cfg.temp_target_c = NAN;
+    EXPECT_EQ(PTX_CONFIG_ERR_TEMPERATURE, ptx_oven_config_validate(&cfg));
+
+    cfg = base;
+    cfg.max_ignition_attempts = 0U;
+    EXPECT_EQ(PTX_CONFIG_ERR_IGNITION_ATTEMPTS, ptx_oven_config_validate(&cfg));
+    cfg.max_ignition_attempts = PTX_CONFIG_MAX_IGNITION_ATTEMPTS + 1U;
+    EXPECT_EQ(PTX_CONFIG_ERR_IGNITION_ATTEMPTS, ptx_oven_config_validate(&cfg));
+
+    cfg = base;
+    cfg.probe_profile = PTX_CAL_PROFILE_COUNT;
+    EXPECT_EQ(PTX_CONFIG_ERR_PROBE_PROFILE, ptx_oven_config_validate(&cfg));
+}
+
+TEST_F(OvenConfigTest, PublishBumpsTheGeneration) {
+    uint16_t generation = ptx_oven_get_config_revision();
+
+    EXPECT_TRUE(ptx_oven_set_temp_target_c(150.0f));
+    EXPECT_EQ((uint16_t)(generation + 1U), ptx_oven_get_config_revision());
+    EXPECT_FLOAT_EQ(150.0f, ptx_oven_get_temp_target_c());
+
+    ptx_oven_config_t cfg = *ptx_oven_get_config();
+    cfg.ignition_duration_ms = 4000U;
+    cfg.temp_delta_c = 3.0f;
+    EXPECT_TRUE(ptx_oven_set_config(&cfg));
+    EXPECT_EQ((uint16_t)(generation + 2U), ptx_oven_get_config_revision());
+    EXPECT_EQ(4000U, ptx_oven_get_ignition_duration_ms());
+    EXPECT_FLOAT_EQ(3.0f, ptx_oven_get_temp_delta_c());
+}
+
+TEST_F(OvenConfigTest, RejectedChangeKeepsTheActiveConfig) {
+    uint16_t generation = ptx_oven_get_config_revision();
+
+    EXPECT_FALSE(ptx_oven_set_vref_range_v(5.5f, 4.5f));
+    EXPECT_FALSE(ptx_oven_set_temp_delta_c(-1.0f));
+    EXPECT_FALSE(ptx_oven_set_max_ignition_attempts(0U));
+    EXPECT_FALSE(ptx_oven_set_probe_profile(PTX_CAL_PROFILE_COUNT));
+    EXPECT_FALSE(ptx_oven_set_periodic_log_ms(0U));
+    EXPECT_FALSE(ptx_oven_set_config(NULL));
+
+    ptx_oven_config_t cfg = base;
+    cfg.temp_target_c = 400.0f;
+    EXPECT_FALSE(ptx_oven_set_config(&cfg));
+
+    EXPECT_EQ(generation, ptx_oven_get_config_revision()) << "Nothing published";
+    EXPECT_EQ(0, memcmp(&base, ptx_oven_get_config(), sizeof(base)));
+
+    /* The next change starts from the active config, not the rejected one */
+    EXPECT_TRUE(ptx_oven_set_auto_resume_delay_ms(2000U));
+    EXPECT_FLOAT_EQ(base.temp_target_c, ptx_oven_get_temp_target_c());
+    EXPECT_FLOAT_EQ(base.temp_delta_c, ptx_oven_get_temp_delta_c());
+}
+
+TEST_F(OvenConfigTest, VrefRangeChangesBothBoundsAtOnce) {
+    /* Min above the old max: one bound at a time would pass through min > max */
+    EXPECT_TRUE(ptx_oven_set_vref_range_v(6.0f, 7.0f));
+    EXPECT_FLOAT_EQ(6.0f, ptx_oven_get_vref_min_v());
+    EXPECT_FLOAT_EQ(7.0f, ptx_oven_get_vref_max_v());
+}
+
+TEST_F(OvenConfigTest, SnapshotCopiesTheActiveGeneration) {
+    ptx_oven_set_temp_target_c(120.0f);
+
+    ptx_oven_config_t copy;
+    EXPECT_EQ(ptx_oven_get_config_revision(), ptx_oven_config_snapshot(&copy));
+    EXPECT_EQ(0, memcmp(&copy, ptx_oven_get_config(), sizeof(copy)));
+    EXPECT_FLOAT_EQ(120.0f, copy.temp_target_c);
+}
+
+TEST_F(OvenConfigTest, ConcurrentSnapshotsAreNeverTorn) {
+    ptx_oven_config_t a = base;
+    a.vref_min_v = 4.0f;
+    a.vref_max_v = 5.0f;
+    a.temp_target_c = 100.0f;
+    a.ignition_duration_ms = 1000U;
+    ptx_oven_config_t b = base;
+    b.vref_min_v = 4.5f;
+    b.vref_max_v = 6.0f;
+    b.temp_target_c = 200.0f;
+    b.ignition_duration_ms = 2000U;
+
+    const uint32_t kChanges = 20000U;
+    std::atomic<bool> done(false);
+    ASSERT_TRUE(ptx_oven_set_config(&a));
+
+    /* One writer retunes continuously while the control loop copies */
+    std::thread writer([&]() {
+        for (uint32_t i = 0; i < kChanges; ++i) {
+            ptx_oven_set_config(&b);
+            ptx_oven_set_config(&a);
+        }
+        done.store(true);
+    });
+
+    uint32_t snapshots = 0;
+    uint32_t torn = 0;                      /* Checked after the join */
+    bool finished;
+    do {
+        finished = done.load();
+        ptx_oven_config_t copy;
+        ptx_oven_config_snapshot(&copy);
+        bool is_a = (memcmp(&copy, &a, sizeof(copy)) == 0);
+        bool is_b = (memcmp(&copy, &b, sizeof(copy)) == 0);
+        if (!is_a && !is_b) torn++;
+        snapshots++;
+    } while (!finished);
+    writer.join();
+    EXPECT_EQ(0U, torn) << "of " << snapshots << " snapshots";
+}
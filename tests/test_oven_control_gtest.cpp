@@ -79,14 +79,36 @@ TEST_F(OvenControlTest, HysteresisControl) {
     EXPECT_FALSE(st->igniter_on) << "Igniter should turn OFF after ignition";
 
     // Move above OFF threshold (185°C) - need to fill filter with new values
+    // (a step shows through a 5-sample median after 3 samples)
     mock_set_signal_mv(mv_for_temp(5000, 186.0f));
-    ptx_oven_control_update();
+    for (int i = 0; i < 3; ++i) {
+        mock_advance_ms(100);
+        ptx_oven_control_update();
+    }
 
     st = ptx_oven_get_status();    
     EXPECT_FALSE(st->gas_on) << "Gas should turn OFF above OFF threshold";
     EXPECT_FALSE(st->igniter_on) << "Igniter should turn OFF above OFF threshold";
 }
 
+TEST_F(OvenControlTest, ActuatorApiSharesTheControllerCache) {
+    mock_set_vref_mv(5000);
+    mock_set_signal_mv(mv_for_temp(5000, 160.0f));
+    ptx_oven_control_update();
+    ASSERT_TRUE(mock_get_gas_output());
+
+    // A stop through the single-oven actuator API, e.g. the hardware test loop
+    ptx_actuator_emergency_stop();
+    EXPECT_FALSE(mock_get_gas_output());
+
+    // The controller sees the outputs off and commands them on again
+    mock_advance_ms(100);
+    ptx_oven_control_update();
+    EXPECT_TRUE(ptx_oven_get_status()->gas_on);
+    EXPECT_TRUE(mock_get_gas_output()) << "A stale cache would skip the write";
+    EXPECT_TRUE(mock_get_igniter_output());
+}
+
 // Main function for running all tests
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
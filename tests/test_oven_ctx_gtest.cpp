@@ -0,0 +1,138 @@
+/**
+ * @file test_oven_ctx_gtest.cpp
+ * @brief Google Test suite for independent oven instances with injected I/O
+ */
+#include <gtest/gtest.h>
+#include <vector>
+#include "ptx_oven_control.h"
+#include "ptx_oven_config.h"
+#include "tests/mocks/mock_api.h"
+
+// Simulated I/O of one oven
+struct FakeOven {
+    uint16_t vref_mv = 5000;
+    uint16_t signal_mv = 0;
+    bool gas = false;
+    bool igniter = false;
+    bool led = false;
+    uint32_t writes = 0;
+};
+
+static uint16_t fake_read_mv(void* user, input_t input) {
+    FakeOven* oven = static_cast<FakeOven*>(user);
+    return (input == TEMPERATURE_SENSOR_REFERENCE) ? oven->vref_mv : oven->signal_mv;
+}
+
+static void fake_write(void* user, output_t output, bool on) {
+    FakeOven* oven = static_cast<FakeOven*>(user);
+    oven->writes++;
+    switch (output) {
+        case GAS_VALVE:      oven->gas = on; break;
+        case IGNITER:        oven->igniter = on; break;
+        case SYS_LED_STATUS: oven->led = on; break;
+    }
+}
+
+static bool fake_read(void* user, output_t output) {
+    FakeOven* oven = static_cast<FakeOven*>(user);
+    switch (output) {
+        case GAS_VALVE:      return oven->gas;
+        case IGNITER:        return oven->igniter;
+        case SYS_LED_STATUS: return oven->led;
+    }
+    return false;
+}
+
+static ptx_io_table_t make_io(FakeOven* oven) {
+    ptx_io_table_t io = { oven, fake_read_mv, fake_write, fake_read };
+    return io;
+}
+
+// Inverse of the nominal probe mapping
+static uint16_t mv_for_temp(float vref_mv, float temp_c) {
+    float x = (temp_c + 48.75f) / 387.5f;
+    return (uint16_t)(x * vref_mv);
+}
+
+class OvenCtxTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ptx_oven_reset_config_to_defaults();
+        mock_reset_time(0);
+    }
+};
+
+TEST_F(OvenCtxTest, InstancesAreIndependent) {
+    const int kOvens = 64;
+    std::vector<FakeOven> ovens(kOvens);
+    std::vector<ptx_io_table_t> io(kOvens);
+    std::vector<ptx_oven_ctx_t> ctx(kOvens);
+    uint32_t board_writes = mock_get_output_writes();
+
+    for (int i = 0; i < kOvens; ++i) {
+        ovens[i].signal_mv = mv_for_temp(5000, (i % 2) ? 160.0f : 200.0f);
+        io[i] = make_io(&ovens[i]);
+        ptx_oven_control_init_ctx(&ctx[i], NULL, &io[i]);
+    }
+    ptx_oven_set_door_state_ctx(&ctx[2], true);
+
+    for (uint32_t t = 100; t <= 1000; t += 100) {
+        for (int i = 0; i < kOvens; ++i) {
+            ptx_oven_control_update_ctx(&ctx[i], &io[i], t);
+        }
+    }
+
+    for (int i = 0; i < kOvens; ++i) {
+        const ptx_oven_status_t* st = ptx_oven_get_status_ctx(&ctx[i]);
+        bool cold = (i % 2) != 0;
+        EXPECT_EQ(cold, st->gas_on) << "oven " << i;
+        EXPECT_EQ(cold, ovens[i].gas) << "oven " << i;
+        EXPECT_EQ(cold, ovens[i].igniter) << "oven " << i;
+    }
+    EXPECT_TRUE(ptx_oven_get_status_ctx(&ctx[2])->door_open);
+    EXPECT_FALSE(ptx_oven_get_status_ctx(&ctx[4])->door_open);
+
+    // Instances never touch the board pins
+    EXPECT_EQ(board_writes, mock_get_output_writes());
+}
+
+TEST_F(OvenCtxTest, ConfigIsPerInstance) {
+    FakeOven a, b;
+    a.signal_mv = b.signal_mv = mv_for_temp(5000, 170.0f);
+    ptx_io_table_t io_a = make_io(&a);
+    ptx_io_table_t io_b = make_io(&b);
+    ptx_oven_ctx_t ctx_a, ctx_b;
+
+    ptx_oven_control_init_ctx(&ctx_a, NULL, &io_a);
+    ptx_oven_control_init_ctx(&ctx_b, NULL, &io_b);
+
+    ptx_oven_config_t cfg = *ptx_oven_get_config();
+    cfg.temp_target_c = 160.0f;
+    ptx_oven_set_config_ctx(&ctx_b, &cfg);
+
+    for (uint32_t t = 100; t <= 500; t += 100) {
+        ptx_oven_control_update_ctx(&ctx_a, &io_a, t);
+        ptx_oven_control_update_ctx(&ctx_b, &io_b, t);
+    }
+
+    EXPECT_TRUE(a.gas) << "170C is below the default band";
+    EXPECT_FALSE(b.gas) << "170C is above a 160C target";
+    EXPECT_FLOAT_EQ(180.0f, ptx_oven_get_config()->temp_target_c) << "Process-wide config untouched";
+}
+
+TEST_F(OvenCtxTest, OutputsWrittenOnlyOnChange) {
+    FakeOven oven;
+    oven.signal_mv = mv_for_temp(5000, 160.0f);
+    ptx_io_table_t io = make_io(&oven);
+    ptx_oven_ctx_t ctx;
+
+    ptx_oven_control_init_ctx(&ctx, NULL, &io);
+    ptx_oven_control_update_ctx(&ctx, &io, 100);
+    uint32_t writes = oven.writes;
+
+    for (uint32_t t = 200; t <= 400; t += 100) {
+        ptx_oven_control_update_ctx(&ctx, &io, t);
+    }
+    EXPECT_EQ(writes, oven.writes);
+    EXPECT_EQ(0U, ptx_actuator_get_readback_faults_ctx(&ctx.actuator));
+}
@@ -0,0 +1,101 @@
+/**
+ * @file test_profile_gtest.cpp
+ * @brief Google Test suite for the per-stage execution time probes
+ */
+#include <gtest/gtest.h>
+#include "ptx_profile.h"
+#include "ptx_oven_control.h"
+#include "tests/mocks/mock_api.h"
+
+// Fake clock: every read advances by the current step
+static uint32_t pti_fake_us = 0;
+static uint32_t pti_fake_step_us = 0;
+
+static uint32_t fake_clock(void) {
+    uint32_t now = pti_fake_us;
+    pti_fake_us += pti_fake_step_us;
+    return now;
+}
+
+class ProfileTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        pti_fake_us = 0;
+        pti_fake_step_us = 0;
+        ptx_profile_set_clock(fake_clock);
+        ptx_profile_reset();
+    }
+    void TearDown() override {
+        ptx_profile_set_clock(NULL);
+    }
+};
+
+TEST_F(ProfileTest, TracksMinMaxMean) {
+    const uint32_t durations[] = {40, 10, 70, 20};
+    for (uint32_t d : durations) {
+        pti_fake_step_us = d;
+        ptx_profile_begin(PTX_STAGE_FILTER);
+        ptx_profile_end(PTX_STAGE_FILTER);
+    }
+
+    ptx_profile_stats_t st;
+    ASSERT_TRUE(ptx_profile_get(PTX_STAGE_FILTER, &st));
+    EXPECT_EQ(4U, st.count);
+    EXPECT_EQ(10U, st.min_us);
+    EXPECT_EQ(70U, st.max_us);
+    EXPECT_EQ(35U, st.mean_us);
+
+    ASSERT_TRUE(ptx_profile_get(PTX_STAGE_LOG, &st));
+    EXPECT_EQ(0U, st.count);
+    EXPECT_FALSE(ptx_profile_get(PTX_STAGE_COUNT, &st));
+}
+
+TEST_F(ProfileTest, HandlesClockWraparound) {
+    pti_fake_us = 0xFFFFFFF0UL;
+    pti_fake_step_us = 0x20;
+    ptx_profile_begin(PTX_STAGE_HEATING);
+    ptx_profile_end(PTX_STAGE_HEATING);
+
+    ptx_profile_stats_t st;
+    ptx_profile_get(PTX_STAGE_HEATING, &st);
+    EXPECT_EQ(0x20U, st.max_us);
+}
+
+TEST_F(ProfileTest, MeanStaysCorrectOverLongRuns) {
+    pti_fake_step_us = 1000000UL;      // Long enough to overflow a plain 32-bit sum
+    for (int i = 0; i < 10000; ++i) {
+        ptx_profile_begin(PTX_STAGE_TOTAL);
+        ptx_profile_end(PTX_STAGE_TOTAL);
+    }
+    ptx_profile_stats_t st;
+    ptx_profile_get(PTX_STAGE_TOTAL, &st);
+    EXPECT_EQ(10000U, st.count);
+    EXPECT_EQ(1000000U, st.mean_us);
+}
+
+TEST_F(ProfileTest, ControlUpdateProfilesEveryStage) {
+    mock_reset_time(0);
+    mock_set_vref_mv(5000);
+    mock_set_signal_mv(2000);
+    ptx_oven_control_init();        // Resets the statistics
+
+    pti_fake_step_us = 3;
+    for (int i = 0; i < 5; ++i) {
+        mock_advance_ms(100);
+        ptx_oven_control_update();
+    }
+
+    ptx_profile_stats_t total;
+    ptx_profile_get(PTX_STAGE_TOTAL, &total);
+    EXPECT_EQ(5U, total.count);
+
+    uint32_t sum_of_stages = 0;
+    for (int s = 0; s < PTX_STAGE_TOTAL; ++s) {
+        ptx_profile_stats_t st;
+        ptx_profile_get((ptx_stage_t)s, &st);
+        EXPECT_EQ(5U, st.count) << "stage " << s;
+        EXPECT_EQ(3U, st.max_us) << "stage " << s;
+        sum_of_stages += st.max_us;
+    }
+    EXPECT_GT(total.max_us, sum_of_stages);
+}
@@ -0,0 +1,210 @@
+/**
+ * @file test_replay_gtest.cpp
+ * @brief Google Test suite for trace recording and replay
+ */
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "tests/replay/ptx_replay.h"
+#include "tests/sim/ptx_sim.h"
+#include "tests/mocks/mock_api.h"
+#include "tests/test_temp_path.h"
+#include "ptx_oven_control.h"
+#include "ptx_event_queue.h"
+#include "ptx_sensor_filter.h"
+
+class ReplayTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path = test_temp_path("ptx_replay");
+        ptx_oven_reset_config_to_defaults();
+        mock_reset_time(1000);
+        ptx_event_queue_reset();
+        ptx_oven_set_door_state(false);
+        ptx_oven_control_init();
+    }
+    void TearDown() override {
+        ptx_oven_set_trace_sink(NULL, NULL);
+        mock_set_input_hook(NULL, NULL);
+        ptx_oven_set_door_state(false);
+        remove(path.c_str());
+    }
+
+    // Two simulated hours with a door opening through the interrupt path
+    void record(ptx_trace_writer_t* writer) {
+        ptx_sim_params_t p;
+        ptx_sim_default_params(&p);
+        ptx_sim_t sim;
+        ptx_sim_init(&sim, &p, 1000);
+
+        ASSERT_TRUE(ptx_trace_writer_open(writer, path.c_str()));
+        ptx_sim_run_global(&sim, 3600U * 1000U, 100U);
+        ptx_oven_door_isr(true);
+        ptx_sim_set_door(&sim, true);
+        ptx_sim_run_global(&sim, 60U * 1000U, 100U);
+        ptx_oven_door_isr(false);
+        ptx_sim_set_door(&sim, false);
+        ptx_sim_run_global(&sim, 3600U * 1000U, 100U);
+        ASSERT_TRUE(ptx_trace_writer_close(writer));
+    }
+
+    std::string path;
+};
+
+TEST_F(ReplayTest, RecordedRunReplaysIdentically) {
+    ptx_trace_writer_t writer;
+    record(&writer);
+    EXPECT_EQ(72600U + 2U, writer.records) << "One record per update plus two door edges";
+
+    ptx_trace_map_t map;
+    ASSERT_TRUE(ptx_trace_map(&map, path.c_str()));
+    ASSERT_EQ(writer.records, map.count);
+    EXPECT_EQ(1000U, map.header->start_ms);
+
+    ptx_replay_result_t r;
+    EXPECT_TRUE(ptx_replay_run(&map, &r));
+    EXPECT_EQ(0U, r.mismatches);
+    EXPECT_EQ(PTX_REPLAY_NONE, r.first_mismatch);
+    EXPECT_EQ(72600U, r.updates);
+    EXPECT_EQ(2U, r.doors);
+
+    /* The trace covers heating and the door */
+    bool gas = false, door = false;
+    for (uint32_t i = 0; i < map.count; ++i) {
+        gas |= (map.records[i].flags & PTX_TRACE_GAS) != 0U;
+        door |= (map.records[i].kind == PTX_TRACE_UPDATE) && (map.records[i].flags & PTX_TRACE_DOOR_OPEN);
+    }
+    EXPECT_TRUE(gas);
+    EXPECT_TRUE(door);
+    ptx_trace_unmap(&map);
+}
+
+TEST_F(ReplayTest, RecordingStartedMidRunReplaysIdentically) {
+    ptx_sim_params_t p;
+    ptx_sim_default_params(&p);
+    ptx_sim_t sim;
+    ptx_sim_init(&sim, &p, 1000);
+
+    /* Heating, window full, timers running when the capture starts */
+    ptx_sim_run_global(&sim, 600U * 1000U, 100U);
+    ASSERT_TRUE(ptx_oven_get_status()->gas_on);
+
+    ptx_trace_writer_t writer;
+    ASSERT_TRUE(ptx_trace_writer_open(&writer, path.c_str()));
+    ptx_sim_run_global(&sim, 600U * 1000U, 100U);
+    ASSERT_TRUE(ptx_trace_writer_close(&writer));
+
+    ptx_trace_map_t map;
+    ASSERT_TRUE(ptx_trace_map(&map, path.c_str()));
+    ptx_replay_result_t r;
+    EXPECT_TRUE(ptx_replay_run(&map, &r));
+    EXPECT_EQ(PTX_REPLAY_NONE, r.first_mismatch);
+    EXPECT_EQ(6000U, r.updates);
+    ptx_trace_unmap(&map);
+}
+
+TEST_F(ReplayTest, ReadingsFromTheSamplerPathReplayIdentically) {
+    /* Readings handed over already sampled, as the ADC sampler does */
+    ptx_trace_writer_t writer;
+    ASSERT_TRUE(ptx_trace_writer_open(&writer, path.c_str()));
+    for (uint32_t i = 0; i < 3000U; ++i) {
+        mock_advance_ms(100);
+        uint16_t vref_q = (uint16_t)((5000U + i % 7U) << PTX_OVERSAMPLE_BITS);
+        uint16_t signal_q = (uint16_t)(((1500U + i / 2U) << PTX_OVERSAMPLE_BITS) + (i & 1U));
+        ptx_oven_control_update_q(vref_q, signal_q);
+    }
+    ASSERT_TRUE(ptx_trace_writer_close(&writer));
+
+    ptx_trace_map_t map;
+    ASSERT_TRUE(ptx_trace_map(&map, path.c_str()));
+    EXPECT_EQ((uint8_t)PTX_OVERSAMPLE_BITS, map.header->oversample_bits);
+    EXPECT_EQ((uint16_t)((1500U << PTX_OVERSAMPLE_BITS) + 1U), map.records[1].signal_mv_q)
+        << "Readings recorded as filtered, fractional bits included";
+
+    ptx_replay_result_t r;
+    EXPECT_TRUE(ptx_replay_run(&map, &r));
+    EXPECT_EQ(3000U, r.updates);
+    ptx_trace_unmap(&map);
+}
+
+TEST_F(ReplayTest, RejectsOtherOversampling) {
+    ptx_trace_writer_t writer;
+    ASSERT_TRUE(ptx_trace_writer_open(&writer, path.c_str()));
+    ptx_oven_control_update();
+    ASSERT_TRUE(ptx_trace_writer_close(&writer));
+
+    ptx_trace_map_t file;
+    ASSERT_TRUE(ptx_trace_map(&file, path.c_str()));
+    std::vector<uint8_t> copy((const uint8_t*)file.base, (const uint8_t*)file.base + file.size);
+    ptx_trace_unmap(&file);
+    ((ptx_trace_header_t*)copy.data())->oversample_bits = (uint8_t)(PTX_OVERSAMPLE_BITS + 1U);
+
+    ptx_trace_map_t map;
+    ASSERT_TRUE(ptx_trace_view(&map, copy.data(), copy.size()));
+    ptx_replay_result_t r;
+    EXPECT_FALSE(ptx_replay_run(&map, &r));
+    EXPECT_EQ(0U, r.first_mismatch);
+}
+
+TEST_F(ReplayTest, ReportsFirstDifferentCommand) {
+    ptx_trace_writer_t writer;
+    record(&writer);
+
+    ptx_trace_map_t file;
+    ASSERT_TRUE(ptx_trace_map(&file, path.c_str()));
+    std::vector<uint8_t> copy((const uint8_t*)file.base, (const uint8_t*)file.base + file.size);
+    ptx_trace_unmap(&file);
+
+    ptx_trace_map_t map;
+    ASSERT_TRUE(ptx_trace_view(&map, copy.data(), copy.size()));
+    ptx_trace_record_t* recs = (ptx_trace_record_t*)(copy.data() + sizeof(ptx_trace_header_t));
+    uint32_t target = 0;
+    for (uint32_t i = 100; i < map.count; ++i) {
+        if ((recs[i].kind == PTX_TRACE_UPDATE) && (recs[i].flags & PTX_TRACE_GAS)) {
+            target = i;
+            break;
+        }
+    }
+    ASSERT_NE(0U, target);
+    recs[target].flags &= (uint8_t)~PTX_TRACE_GAS;     /* As if the unit had closed the valve */
+
+    ptx_replay_result_t r;
+    EXPECT_FALSE(ptx_replay_run(&map, &r));
+    EXPECT_EQ(1U, r.mismatches);
+    EXPECT_EQ(target, r.first_mismatch);
+    EXPECT_EQ(0U, r.expected_flags & PTX_TRACE_GAS);
+    EXPECT_NE(0U, r.actual_flags & PTX_TRACE_GAS);
+}
+
+TEST_F(ReplayTest, RejectsForeignData) {
+    ptx_trace_map_t map;
+    uint8_t junk[64] = { 0 };
+    EXPECT_FALSE(ptx_trace_view(&map, junk, sizeof(junk)));
+    EXPECT_FALSE(ptx_trace_view(&map, junk, 4));
+    EXPECT_FALSE(ptx_trace_map(&map, (path + ".missing").c_str()));
+
+    ptx_trace_header_t header;
+    ptx_oven_trace_header(&header);
+    header.version = PTX_TRACE_VERSION + 1U;
+    EXPECT_FALSE(ptx_trace_view(&map, &header, sizeof(header)));
+    header.version = PTX_TRACE_VERSION;
+    EXPECT_TRUE(ptx_trace_view(&map, &header, sizeof(header)));
+    EXPECT_EQ(0U, map.count);
+}
+
+TEST_F(ReplayTest, HeaderCarriesTheConfiguration) {
+    ptx_oven_config_t cfg = *ptx_oven_get_config();
+    cfg.temp_target_c = 150.0f;
+    cfg.ignition_duration_ms = 4200U;
+    ptx_oven_set_config(&cfg);
+
+    ptx_trace_header_t header;
+    ptx_oven_trace_header(&header);
+    ptx_oven_config_t back;
+    ptx_trace_config(&header, &back);
+    EXPECT_FLOAT_EQ(150.0f, back.temp_target_c);
+    EXPECT_EQ(4200U, back.ignition_duration_ms);
+    EXPECT_EQ(cfg.probe_profile, back.probe_profile);
+    EXPECT_EQ(cfg.iteration_period, back.iteration_period);
+}
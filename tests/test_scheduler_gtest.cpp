@@ -0,0 +1,148 @@
+/**
+ * @file test_scheduler_gtest.cpp
+ * @brief Google Test suite for the deadline-driven cooperative scheduler
+ */
+#include <gtest/gtest.h>
+#include <vector>
+#include "ptx_scheduler.h"
+
+static std::vector<uint32_t> pti_runs_a;
+static std::vector<uint32_t> pti_runs_b;
+
+static void task_a(uint32_t now_ms) { pti_runs_a.push_back(now_ms); }
+static void task_b(uint32_t now_ms) { pti_runs_b.push_back(now_ms); }
+
+class SchedulerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ptx_sched_init();
+        pti_runs_a.clear();
+        pti_runs_b.clear();
+    }
+
+    // Poll the scheduler every step_ms, like loop() does
+    static void run_until(uint32_t from_ms, uint32_t to_ms, uint32_t step_ms) {
+        for (uint32_t t = from_ms; t != to_ms; t += step_ms) {
+            ptx_sched_run(t);
+        }
+    }
+};
+
+TEST_F(SchedulerTest, RejectsInvalidTasks) {
+    EXPECT_EQ(PTX_SCHED_INVALID, ptx_sched_add(task_a, 0, 0));
+    EXPECT_EQ(PTX_SCHED_INVALID, ptx_sched_add(nullptr, 10, 0));
+    for (unsigned i = 0; i < PTX_SCHED_MAX_TASKS; ++i) {
+        EXPECT_EQ((int8_t)i, ptx_sched_add(task_a, 10, 0));
+    }
+    EXPECT_EQ(PTX_SCHED_INVALID, ptx_sched_add(task_a, 10, 0));
+}
+
+TEST_F(SchedulerTest, IndependentRatesWithoutDrift) {
+    ptx_sched_add(task_a, 100, 0);
+    ptx_sched_add(task_b, 30, 0);
+
+    // Polled every 7 ms: releases are seen late but the grid does not drift
+    run_until(0, 7 * 143, 7);
+
+    ASSERT_EQ(10U, pti_runs_a.size());
+    for (size_t i = 0; i < pti_runs_a.size(); ++i) {
+        EXPECT_LT(pti_runs_a[i] - 100U * i, 7U) << "run " << i;
+    }
+    ASSERT_EQ(34U, pti_runs_b.size());
+    for (size_t i = 0; i < pti_runs_b.size(); ++i) {
+        EXPECT_LT(pti_runs_b[i] - 30U * i, 7U) << "run " << i;
+    }
+
+    ptx_sched_stats_t stats;
+    ASSERT_TRUE(ptx_sched_get_stats(0, &stats));
+    EXPECT_EQ(10U, stats.runs);
+    EXPECT_EQ(0U, stats.overruns);
+    EXPECT_EQ(6U, stats.max_lateness_ms);
+}
+
+TEST_F(SchedulerTest, OverrunSkipsMissedReleases) {
+    ptx_sched_add(task_a, 100, 0);
+    ptx_sched_run(0);
+    ptx_sched_run(350);      // Releases at 100, 200 and 300 all passed
+    ptx_sched_run(399);
+    ptx_sched_run(400);
+
+    ASSERT_EQ(3U, pti_runs_a.size());
+    EXPECT_EQ(350U, pti_runs_a[1]);
+    EXPECT_EQ(400U, pti_runs_a[2]);
+
+    ptx_sched_stats_t stats;
+    ptx_sched_get_stats(0, &stats);
+    EXPECT_EQ(2U, stats.overruns);
+    EXPECT_EQ(250U, stats.max_lateness_ms);
+    EXPECT_EQ(0U, stats.last_lateness_ms);
+
+    ptx_sched_reset_stats();
+    ptx_sched_get_stats(0, &stats);
+    EXPECT_EQ(0U, stats.runs);
+    EXPECT_EQ(0U, stats.overruns);
+}
+
+TEST_F(SchedulerTest, SurvivesMillisWraparound) {
+    const uint32_t start = 0xFFFFFF00UL;
+    ptx_sched_add(task_a, 100, start);
+    run_until(start, start + 1000U, 1);
+
+    ASSERT_EQ(10U, pti_runs_a.size());
+    for (size_t i = 0; i < pti_runs_a.size(); ++i) {
+        EXPECT_EQ((uint32_t)(start + 100U * i), pti_runs_a[i]);
+    }
+    ptx_sched_stats_t stats;
+    ptx_sched_get_stats(0, &stats);
+    EXPECT_EQ(0U, stats.overruns);
+    EXPECT_EQ(0U, stats.max_lateness_ms);
+}
+
+TEST_F(SchedulerTest, ReportsTimeUntilNextRelease) {
+    ptx_sched_add(task_a, 100, 0);
+    ptx_sched_add(task_b, 30, 10);
+
+    EXPECT_EQ(10U, ptx_sched_run(0));
+    EXPECT_EQ(30U, ptx_sched_run(10));
+    EXPECT_EQ(30U, ptx_sched_run(40));
+    EXPECT_EQ(20U, ptx_sched_run(200));     // task_b skipped to its 190 release
+}
+
+TEST_F(SchedulerTest, PeriodChangeKeepsLastRelease) {
+    int8_t id = ptx_sched_add(task_a, 100, 0);
+    ptx_sched_run(0);
+    ptx_sched_set_period(id, 50);
+    ptx_sched_set_period(id, 0);     // Ignored
+    run_until(1, 201, 1);
+
+    ASSERT_EQ(5U, pti_runs_a.size());
+    EXPECT_EQ(50U, pti_runs_a[1]);
+    EXPECT_EQ(200U, pti_runs_a[4]);
+}
+
+TEST_F(SchedulerTest, PeriodChangeAfterLateRunIsNoOverrun) {
+    int8_t id = ptx_sched_add(task_a, 100, 0);
+    ptx_sched_run(0);
+    ptx_sched_run(170);              // Released at 100, started 70 ms late
+    ptx_sched_set_period(id, 30);
+    run_until(171, 231, 1);
+
+    ASSERT_EQ(4U, pti_runs_a.size());
+    EXPECT_EQ(200U, pti_runs_a[2]);
+    EXPECT_EQ(230U, pti_runs_a[3]);
+
+    ptx_sched_stats_t stats;
+    ptx_sched_get_stats(id, &stats);
+    EXPECT_EQ(0U, stats.overruns);
+    EXPECT_EQ(70U, stats.max_lateness_ms);
+}
+
+TEST_F(SchedulerTest, PeriodChangeBeforeFirstRunKeepsFirstRelease) {
+    int8_t id = ptx_sched_add(task_a, 100, 40);
+    ptx_sched_set_period(id, 20);
+    run_until(0, 81, 1);
+
+    ASSERT_EQ(3U, pti_runs_a.size());
+    EXPECT_EQ(40U, pti_runs_a[0]);
+    EXPECT_EQ(80U, pti_runs_a[2]);
+}
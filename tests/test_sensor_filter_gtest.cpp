@@ -0,0 +1,140 @@
+/**
+ * @file test_sensor_filter_gtest.cpp
+ * @brief Google Test suite for the sliding-window median filter and the decimator
+ */
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <vector>
+#include "ptx_sensor_filter.h"
+
+// Reference median: sort a copy of the window
+static uint16_t brute_median(const std::deque<uint16_t>& window) {
+    std::vector<uint16_t> v(window.begin(), window.end());
+    std::sort(v.begin(), v.end());
+    size_t n = v.size();
+    if (n % 2U == 1U) return v[n / 2U];
+    return (uint16_t)(((uint32_t)v[n / 2U - 1U] + v[n / 2U]) / 2U);
+}
+
+TEST(MedianFilterTest, MatchesSortedWindowForAllSizes) {
+    srand(1234);
+    for (uint8_t size = 1; size <= PTX_SENSOR_FILTER_MAX_WINDOW; ++size) {
+        ptx_median_t m;
+        ptx_median_init(&m, size);
+        std::deque<uint16_t> window;
+
+        for (int i = 0; i < 500; ++i) {
+            // Narrow value range so duplicates are common
+            uint16_t sample = (uint16_t)(rand() % 64);
+            ptx_median_push(&m, sample);
+            window.push_back(sample);
+            if (window.size() > size) window.pop_front();
+
+            ASSERT_EQ(brute_median(window), ptx_median_value(&m))
+                << "window=" << (int)size << " step=" << i;
+        }
+    }
+}
+
+TEST(MedianFilterTest, RejectsSpikes) {
+    ptx_median_t m;
+    ptx_median_init(&m, 5);
+    const uint16_t samples[] = {2000, 2001, 4900, 1999, 2002, 50, 2000};
+    for (uint16_t s : samples) ptx_median_push(&m, s);
+    EXPECT_EQ(2000, ptx_median_value(&m));
+}
+
+TEST(MedianFilterTest, WindowIsClamped) {
+    ptx_median_t m;
+    ptx_median_init(&m, 0);
+    EXPECT_EQ(1, m.size);
+    ptx_median_init(&m, 255);
+    EXPECT_EQ(PTX_SENSOR_FILTER_MAX_WINDOW, m.size);
+}
+
+TEST(MedianFilterTest, SensorFilterValidWhenWindowFull) {
+    ptx_sensor_filter_init(3);
+    ptx_sensor_reading_t r = ptx_sensor_filter_update(5000, 2000);
+    EXPECT_FALSE(r.valid);
+    EXPECT_EQ(2000, r.signal_mv);
+    ptx_sensor_filter_update(5000, 2000);
+    r = ptx_sensor_filter_update(5000, 4000);
+    EXPECT_TRUE(r.valid);
+    EXPECT_EQ(5000, r.vref_mv);
+    EXPECT_EQ(2000, r.signal_mv);
+
+    ptx_sensor_filter_reset();
+    r = ptx_sensor_filter_update(4800, 1000);
+    EXPECT_FALSE(r.valid);
+    EXPECT_EQ(1000, r.signal_mv);
+}
+
+TEST(DecimatorTest, PassThroughWithoutExtraBits) {
+    ptx_decimator_t d;
+    ptx_decimator_init(&d, 0);
+    uint16_t v = 0, s = 0;
+    ASSERT_TRUE(ptx_decimator_push(&d, 1023, 7, &v, &s));
+    EXPECT_EQ(1023U, v);
+    EXPECT_EQ(7U, s);
+}
+
+TEST(DecimatorTest, FourToTheNSamplesPerOutput) {
+    for (uint8_t bits = 1; bits <= PTX_OVERSAMPLE_MAX_BITS; ++bits) {
+        ptx_decimator_t d;
+        ptx_decimator_init(&d, bits);
+        uint16_t per_output = (uint16_t)(1U << (2U * bits));
+        uint16_t v = 0, s = 0;
+
+        for (uint16_t i = 1; i < per_output; ++i) {
+            ASSERT_FALSE(ptx_decimator_push(&d, 1023, 512, &v, &s));
+        }
+        ASSERT_TRUE(ptx_decimator_push(&d, 1023, 512, &v, &s));
+        EXPECT_EQ((uint32_t)1023U << bits, v) << "Full scale still fits";
+        EXPECT_EQ((uint32_t)512U << bits, s);
+
+        /* The sums restart after each output */
+        for (uint16_t i = 1; i < per_output; ++i) {
+            ASSERT_FALSE(ptx_decimator_push(&d, 0, 0, &v, &s));
+        }
+        ASSERT_TRUE(ptx_decimator_push(&d, 0, 0, &v, &s));
+        EXPECT_EQ(0U, v);
+    }
+}
+
+TEST(DecimatorTest, DitheredInputGainsResolution) {
+    /* 512.25 counts, seen by a 10-bit ADC with one count of noise: three
+       samples in four read 512, one reads 513 */
+    ptx_decimator_t d;
+    ptx_decimator_init(&d, 2);
+    uint16_t v = 0, s = 0;
+    bool ready = false;
+    for (uint16_t i = 0; i < 16U; ++i) {
+        uint16_t raw = (i % 4U == 0U) ? 513U : 512U;
+        ready = ptx_decimator_push(&d, raw, (uint16_t)(1023U - raw), &v, &s);
+    }
+    ASSERT_TRUE(ready);
+    EXPECT_EQ(4U * 512U + 1U, v);       /* 512.25 with two fractional bits */
+    EXPECT_EQ(4U * 511U - 1U, s);       /* 510.75 */
+
+    ptx_decimator_init(&d, PTX_OVERSAMPLE_MAX_BITS + 3U);
+    EXPECT_EQ(PTX_OVERSAMPLE_MAX_BITS, d.bits) << "Extra bits are clamped";
+}
+
+TEST(MedianFilterTest, FractionalReadingsRoundToWholeMillivolts) {
+    ptx_sensor_filter_t f;
+    ptx_sensor_filter_init_ctx(&f, 1);
+    uint16_t half = (uint16_t)(1U << PTX_OVERSAMPLE_BITS) / 2U;
+    uint16_t vq = (uint16_t)((5000U << PTX_OVERSAMPLE_BITS) + half);
+    uint16_t sq = (uint16_t)(2000U << PTX_OVERSAMPLE_BITS);
+    ptx_sensor_reading_t r = ptx_sensor_filter_update_q_ctx(&f, vq, sq);
+    EXPECT_EQ(vq, r.vref_mv_q);
+    EXPECT_EQ(sq, r.signal_mv_q);
+    EXPECT_EQ((PTX_OVERSAMPLE_BITS > 0U) ? 5001U : 5000U, r.vref_mv);
+    EXPECT_EQ(2000U, r.signal_mv);
+
+    r = ptx_sensor_filter_update_ctx(&f, 4900, 1000);
+    EXPECT_EQ((uint16_t)(4900U << PTX_OVERSAMPLE_BITS), r.vref_mv_q) << "Whole mV shifted up";
+    EXPECT_EQ(4900U, r.vref_mv);
+}
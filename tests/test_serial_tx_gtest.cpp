@@ -0,0 +1,121 @@
+/**
+ * @file test_serial_tx_gtest.cpp
+ * @brief Google Test suite for the serial TX queue and its backpressure policy
+ */
+#include <gtest/gtest.h>
+#include <string>
+#include "ptx_serial_tx.h"
+
+// Drain everything currently queued, as serial_service() would
+static std::string drain_tx() {
+    std::string out;
+    const uint8_t* data;
+    uint16_t n;
+    while ((n = ptx_serial_tx_peek(&data)) > 0U) {
+        out.append((const char*)data, n);
+        ptx_serial_tx_consume(n);
+    }
+    return out;
+}
+
+static bool queue(const std::string& msg, ptx_tx_prio_t prio) {
+    return ptx_serial_tx_write(msg.data(), (uint16_t)msg.size(), prio);
+}
+
+class SerialTxTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ptx_serial_tx_reset();
+    }
+};
+
+TEST_F(SerialTxTest, QueuesMessagesInOrder) {
+    EXPECT_TRUE(queue("one\r\n", PTX_TX_PRIO_LOW));
+    EXPECT_TRUE(queue("two\r\n", PTX_TX_PRIO_HIGH));
+    EXPECT_TRUE(queue("three\r\n", PTX_TX_PRIO_NORMAL));
+    EXPECT_EQ(17U, ptx_serial_tx_used());
+    EXPECT_EQ("one\r\ntwo\r\nthree\r\n", drain_tx());
+    EXPECT_EQ(0U, ptx_serial_tx_used());
+}
+
+TEST_F(SerialTxTest, PriorityLimitsReserveSpace) {
+    const std::string msg(64, 'x');
+
+    int low = 0;
+    while (queue(msg, PTX_TX_PRIO_LOW)) low++;
+    EXPECT_EQ(PTX_SERIAL_TX_SIZE / 2U / msg.size(), (size_t)low);
+    EXPECT_EQ(PTX_SERIAL_TX_SIZE / 2U, ptx_serial_tx_used());
+
+    // Normal messages fill up to 3/4 (the first one carries the drop notice)
+    int normal = 0;
+    while (queue(msg, PTX_TX_PRIO_NORMAL)) normal++;
+    EXPECT_GT(normal, 0);
+    EXPECT_LE(ptx_serial_tx_used(), PTX_SERIAL_TX_SIZE / 4U * 3U);
+    EXPECT_GT(ptx_serial_tx_used() + msg.size(), PTX_SERIAL_TX_SIZE / 4U * 3U);
+
+    // The last quarter is left for errors and warnings
+    int high = 0;
+    while (queue(msg, PTX_TX_PRIO_HIGH)) high++;
+    EXPECT_GT(high, 0);
+    EXPECT_GT(ptx_serial_tx_used() + msg.size(), PTX_SERIAL_TX_SIZE);
+
+    ptx_serial_tx_stats_t stats;
+    ptx_serial_tx_get_stats(&stats);
+    EXPECT_EQ(1U, stats.dropped_msgs[PTX_TX_PRIO_LOW]);
+    EXPECT_EQ(1U, stats.dropped_msgs[PTX_TX_PRIO_NORMAL]);
+    EXPECT_EQ(1U, stats.dropped_msgs[PTX_TX_PRIO_HIGH]);
+    EXPECT_EQ(3U * msg.size(), stats.dropped_bytes);
+    EXPECT_EQ(ptx_serial_tx_used(), stats.high_water);
+}
+
+TEST_F(SerialTxTest, RoomFollowsPriority) {
+    EXPECT_EQ(PTX_SERIAL_TX_SIZE / 2U, ptx_serial_tx_room(PTX_TX_PRIO_LOW));
+    EXPECT_EQ(PTX_SERIAL_TX_SIZE, ptx_serial_tx_room(PTX_TX_PRIO_HIGH));
+
+    const std::string msg(PTX_SERIAL_TX_SIZE / 2U + 10U, 'x');
+    ASSERT_TRUE(queue(msg, PTX_TX_PRIO_NORMAL));
+    EXPECT_EQ(0U, ptx_serial_tx_room(PTX_TX_PRIO_LOW));
+    EXPECT_EQ(PTX_SERIAL_TX_SIZE / 4U - 10U, ptx_serial_tx_room(PTX_TX_PRIO_NORMAL));
+}
+
+TEST_F(SerialTxTest, DropsAreReportedAheadOfNextMessage) {
+    const std::string big(PTX_SERIAL_TX_SIZE / 2U, 'x');
+    ASSERT_TRUE(queue(big, PTX_TX_PRIO_LOW));
+    EXPECT_FALSE(queue("status 1\r\n", PTX_TX_PRIO_LOW));
+    EXPECT_FALSE(queue("status 2\r\n", PTX_TX_PRIO_LOW));
+    EXPECT_EQ(big, drain_tx());
+
+    ASSERT_TRUE(queue("event\r\n", PTX_TX_PRIO_NORMAL));
+    EXPECT_EQ("[tx] dropped 2\r\nevent\r\n", drain_tx());
+
+    // Counted once only
+    ASSERT_TRUE(queue("event\r\n", PTX_TX_PRIO_NORMAL));
+    EXPECT_EQ("event\r\n", drain_tx());
+}
+
+TEST_F(SerialTxTest, HighPriorityGetsThroughWithoutRoomForNotice) {
+    const std::string fill(PTX_SERIAL_TX_SIZE - 8U, 'x');
+    ASSERT_TRUE(queue(fill, PTX_TX_PRIO_HIGH));
+    EXPECT_FALSE(queue("dropped\r\n", PTX_TX_PRIO_NORMAL));
+
+    // Fits only without the notice: the notice stays pending
+    ASSERT_TRUE(queue("[ERR]\r\n", PTX_TX_PRIO_HIGH));
+    EXPECT_EQ(fill + "[ERR]\r\n", drain_tx());
+
+    ASSERT_TRUE(queue("next\r\n", PTX_TX_PRIO_LOW));
+    EXPECT_EQ("[tx] dropped 1\r\nnext\r\n", drain_tx());
+}
+
+TEST_F(SerialTxTest, WrapsAround) {
+    std::string msg(100, ' ');
+    for (int round = 0; round < 200; ++round) {
+        msg.assign(100, (char)('a' + round % 26));
+        ASSERT_TRUE(queue(msg, PTX_TX_PRIO_LOW));
+        ASSERT_EQ(msg, drain_tx());
+    }
+
+    ptx_serial_tx_stats_t stats;
+    ptx_serial_tx_get_stats(&stats);
+    EXPECT_EQ(200U * msg.size(), stats.queued_bytes);
+    EXPECT_EQ(0U, stats.dropped_bytes);
+}
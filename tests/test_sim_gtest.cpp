@@ -0,0 +1,258 @@
+/**
+ * @file test_sim_gtest.cpp
+ * @brief Google Test suite for the closed-loop plant simulator
+ */
+#include <gtest/gtest.h>
+#include <chrono>
+#include <math.h>
+#include "tests/sim/ptx_sim.h"
+#include "ptx_oven_control.h"
+#include "ptx_oven_config.h"
+#include "ptx_temperature.h"
+#include "tests/mocks/mock_api.h"
+
+static const uint32_t kHourMs = 3600U * 1000U;
+
+static ptx_sim_params_t quiet_params(void) {
+    ptx_sim_params_t p;
+    ptx_sim_default_params(&p);
+    p.noise_mv = 0.0;
+    return p;
+}
+
+TEST(SimPlantTest, DeadTimeAndFirstOrderResponse) {
+    ptx_sim_params_t p = quiet_params();
+    ptx_sim_t sim;
+    ptx_sim_init(&sim, &p, 0);
+
+    ptx_sim_set_gas(&sim, true);
+    ptx_sim_advance(&sim, p.dead_time_ms);
+    EXPECT_DOUBLE_EQ(p.ambient_c, sim.temp_c) << "Nothing reaches the probe within the dead time";
+
+    ptx_sim_advance(&sim, p.dead_time_ms + (uint32_t)(p.tau_s * 1000.0));
+    EXPECT_NEAR(p.ambient_c + p.gain_c * (1.0 - exp(-1.0)), sim.temp_c, 1e-6);
+}
+
+TEST(SimPlantTest, StepSizeDoesNotMatter) {
+    ptx_sim_params_t p = quiet_params();
+    ptx_sim_t coarse, fine;
+    ptx_sim_init(&coarse, &p, 0);
+    ptx_sim_init(&fine, &p, 0);
+
+    ptx_sim_set_gas(&coarse, true);
+    ptx_sim_set_gas(&fine, true);
+    ptx_sim_advance(&coarse, 600000U);
+    for (uint32_t t = 100U; t <= 600000U; t += 100U) {
+        ptx_sim_advance(&fine, t);
+    }
+    EXPECT_NEAR(coarse.temp_c, fine.temp_c, 1e-9);
+    EXPECT_EQ(coarse.stats.gas_on_ms, fine.stats.gas_on_ms);
+}
+
+TEST(SimPlantTest, OpenDoorLosesHeat) {
+    ptx_sim_params_t p = quiet_params();
+    ptx_sim_t closed, open;
+    ptx_sim_init(&closed, &p, 0);
+    closed.temp_c = 180.0;
+    open = closed;
+    ptx_sim_set_door(&open, true);
+
+    ptx_sim_advance(&closed, 60000U);
+    ptx_sim_advance(&open, 60000U);
+    EXPECT_LT(open.temp_c, closed.temp_c - 10.0);
+}
+
+TEST(SimPlantTest, ProbeReadingMapsBackToTemperature) {
+    ptx_sim_params_t p = quiet_params();
+    ptx_sim_t sim;
+    ptx_sim_init(&sim, &p, 0);
+
+    const double temps[] = { 20.0, 100.0, 180.0, 250.0 };
+    for (double t : temps) {
+        sim.temp_c = t;
+        uint16_t vref = ptx_sim_read_mv(&sim, TEMPERATURE_SENSOR_REFERENCE);
+        uint16_t signal = ptx_sim_read_mv(&sim, TEMPERATURE_SENSOR);
+        float c = ptx_temp_compute_c(ptx_cal_get_table(p.probe_profile), vref, signal);
+        EXPECT_NEAR(t, c, 0.5) << "at " << t;
+    }
+}
+
+class SimClosedLoopTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ptx_oven_reset_config_to_defaults();
+        mock_reset_time(0);
+        ptx_oven_set_door_state(false);
+        ptx_oven_control_init();
+    }
+    void TearDown() override {
+        mock_set_input_hook(NULL, NULL);
+    }
+};
+
+TEST_F(SimClosedLoopTest, DayOfHeatingFasterThanRealTime) {
+    ptx_sim_params_t p;
+    ptx_sim_default_params(&p);
+    ptx_sim_t sim;
+    ptx_sim_init(&sim, &p, 0);
+
+    auto t0 = std::chrono::steady_clock::now();
+    ptx_sim_run_global(&sim, 24U * kHourMs, ptx_oven_get_iteration_period());
+    double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    RecordProperty("wall_ms", (int)(wall_s * 1000.0));
+
+    const ptx_oven_config_t* cfg = ptx_oven_get_config();
+    ASSERT_NE(PTX_SIM_NEVER, sim.stats.reach_ms);
+    EXPECT_LT(sim.stats.reach_ms, kHourMs);
+    EXPECT_LT(sim.stats.max_temp_c, cfg->temp_target_c + cfg->temp_delta_c + 5.0);
+    EXPECT_NEAR(cfg->temp_target_c, sim.temp_c, cfg->temp_delta_c + 5.0);
+    EXPECT_GT(sim.stats.ignitions, 10U);
+    EXPECT_LT(sim.stats.gas_on_ms, 24U * kHourMs);
+    EXPECT_LT(wall_s, 5.0) << "24 h of control updates should take a fraction of a second";
+}
+
+TEST_F(SimClosedLoopTest, InstanceRunMatchesGlobalRun) {
+    ptx_sim_params_t p;
+    ptx_sim_default_params(&p);
+    ptx_sim_t global, local;
+    ptx_sim_init(&global, &p, 0);
+    ptx_sim_init(&local, &p, 0);
+
+    ptx_oven_ctx_t ctx;
+    ptx_io_table_t io = ptx_sim_io(&local);
+    ptx_oven_control_init_ctx(&ctx, NULL, &io);
+
+    ptx_sim_run_global(&global, 2U * kHourMs, 100U);
+    ptx_sim_run(&local, &ctx, 2U * kHourMs, 100U);
+
+    EXPECT_EQ(global.stats.gas_on_ms, local.stats.gas_on_ms);
+    EXPECT_EQ(global.stats.ignitions, local.stats.ignitions);
+    EXPECT_EQ(global.stats.reach_ms, local.stats.reach_ms);
+    EXPECT_DOUBLE_EQ(global.temp_c, local.temp_c);
+}
+
+TEST(SimPlantTest, PredictsThresholdCrossing) {
+    ptx_sim_params_t p = quiet_params();
+    ptx_sim_t sim;
+    ptx_sim_init(&sim, &p, 0);
+    ptx_sim_set_gas(&sim, true);
+
+    /* Through the dead time, then the rising exponential */
+    uint32_t t = ptx_sim_predict_ms(&sim, 100.0, true);
+    ASSERT_NE(PTX_SIM_NEVER, t);
+    EXPECT_GT(t, p.dead_time_ms);
+    ptx_sim_t probe = sim;
+    ptx_sim_advance(&probe, t);
+    EXPECT_LT(probe.temp_c, 100.0);
+    ptx_sim_advance(&probe, t + 1U);
+    EXPECT_GE(probe.temp_c, 100.0);
+
+    EXPECT_EQ(0U, ptx_sim_predict_ms(&sim, 20.0, true)) << "Already above";
+    EXPECT_EQ(PTX_SIM_NEVER, ptx_sim_predict_ms(&sim, p.ambient_c + p.gain_c + 1.0, true));
+    EXPECT_EQ(PTX_SIM_NEVER, ptx_sim_predict_ms(&sim, 20.0, false));
+
+    /* Valve closed again while the opening is still in flight */
+    ptx_sim_advance(&sim, 600000U);
+    ptx_sim_set_gas(&sim, false);
+    double peak_start = sim.temp_c;
+    t = ptx_sim_predict_ms(&sim, peak_start - 1.0, false);
+    ASSERT_NE(PTX_SIM_NEVER, t);
+    EXPECT_GT(t, p.dead_time_ms);
+    ptx_sim_advance(&sim, sim.now_ms + t + 1U);
+    EXPECT_LE(sim.temp_c, peak_start - 1.0);
+}
+
+TEST(SimNextEventTest, ReportsIgnitionTimeLeft) {
+    ptx_oven_reset_config_to_defaults();
+    ptx_sim_params_t p = quiet_params();
+    ptx_sim_t sim;
+    ptx_sim_init(&sim, &p, 0);
+    ptx_oven_ctx_t ctx;
+    ptx_io_table_t io = ptx_sim_io(&sim);
+    ptx_oven_control_init_ctx(&ctx, NULL, &io);
+
+    ptx_sim_run(&sim, &ctx, 1000U, 100U);
+    ASSERT_EQ(PTX_HEATING_STATE_IGNITING, ctx.status.state) << "Cold start ignites";
+
+    uint32_t elapsed = sim.now_ms - ctx.ignition_start_ms;
+    EXPECT_EQ(ctx.config.ignition_duration_ms - elapsed,
+              ptx_oven_next_event_ctx(&ctx, sim.now_ms, PTX_NEXT_IGNITION, NULL, NULL));
+    EXPECT_EQ(0U, ptx_oven_next_event_ctx(&ctx, ctx.ignition_start_ms + ctx.config.ignition_duration_ms,
+                                          PTX_NEXT_IGNITION, NULL, NULL));
+    EXPECT_EQ(PTX_NEXT_NONE, ptx_oven_next_event_ctx(&ctx, sim.now_ms, PTX_NEXT_TEMP, NULL, NULL))
+        << "No temperature event while igniting";
+
+    ptx_oven_set_door_state_ctx(&ctx, true);
+    ptx_sim_set_door(&sim, true);
+    ptx_sim_run(&sim, &ctx, 100U, 100U);
+    EXPECT_EQ(PTX_NEXT_NONE, ptx_oven_next_event_ctx(&ctx, sim.now_ms, PTX_NEXT_IGNITION, NULL, NULL))
+        << "Door open: heating is off";
+}
+
+class SimSkipTest : public ::testing::TestWithParam<uint8_t> {
+protected:
+    void SetUp() override { ptx_oven_reset_config_to_defaults(); }
+};
+
+TEST_P(SimSkipTest, MatchesFixedStepRun) {
+    const uint32_t duration = 12U * kHourMs;
+    const uint32_t period = 100U;
+    ptx_sim_params_t p = quiet_params();
+    ptx_sim_t fixed, skip;
+    ptx_sim_init(&fixed, &p, 0);
+    ptx_sim_init(&skip, &p, 0);
+
+    ptx_oven_ctx_t fixed_ctx, skip_ctx;
+    ptx_io_table_t fixed_io = ptx_sim_io(&fixed);
+    ptx_io_table_t skip_io = ptx_sim_io(&skip);
+    ptx_oven_control_init_ctx(&fixed_ctx, NULL, &fixed_io);
+    ptx_oven_control_init_ctx(&skip_ctx, NULL, &skip_io);
+
+    ptx_sim_run(&fixed, &fixed_ctx, duration, period);
+    ptx_sim_run_skip(&skip, &skip_ctx, duration, period, GetParam());
+
+    EXPECT_EQ(fixed.now_ms, skip.now_ms);
+    EXPECT_EQ(fixed.stats.gas_on_ms, skip.stats.gas_on_ms);
+    EXPECT_EQ(fixed.stats.ignitions, skip.stats.ignitions);
+    EXPECT_NEAR((double)fixed.stats.reach_ms, (double)skip.stats.reach_ms, 1.0);
+    EXPECT_NEAR(fixed.stats.max_temp_c, skip.stats.max_temp_c, 1e-6);
+    EXPECT_NEAR(fixed.temp_c, skip.temp_c, 1e-6);
+    EXPECT_EQ(fixed_ctx.status.state, skip_ctx.status.state);
+    EXPECT_EQ(fixed_ctx.status.temperature_mc, skip_ctx.status.temperature_mc);
+    EXPECT_EQ(fixed_ctx.ignition_attempt, skip_ctx.ignition_attempt);
+    if (GetParam() & PTX_NEXT_LED) {
+        EXPECT_EQ(fixed.led, skip.led);
+    }
+
+    EXPECT_EQ(duration / period, fixed.stats.updates);
+    RecordProperty("skip_updates", (int)skip.stats.updates);
+    if (!(GetParam() & PTX_NEXT_LED)) {
+        EXPECT_LT(skip.stats.updates * 10U, fixed.stats.updates) << "Most updates are skipped";
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Events, SimSkipTest,
+                         ::testing::Values((uint8_t)(PTX_NEXT_IGNITION | PTX_NEXT_TEMP),
+                                           (uint8_t)PTX_NEXT_ALL));
+
+TEST(SimSkipNoiseTest, NoisyProbeFallsBackToFixedStep) {
+    ptx_oven_reset_config_to_defaults();
+    ptx_sim_params_t p;
+    ptx_sim_default_params(&p);
+    ptx_sim_t fixed, skip;
+    ptx_sim_init(&fixed, &p, 0);
+    ptx_sim_init(&skip, &p, 0);
+
+    ptx_oven_ctx_t fixed_ctx, skip_ctx;
+    ptx_io_table_t fixed_io = ptx_sim_io(&fixed);
+    ptx_io_table_t skip_io = ptx_sim_io(&skip);
+    ptx_oven_control_init_ctx(&fixed_ctx, NULL, &fixed_io);
+    ptx_oven_control_init_ctx(&skip_ctx, NULL, &skip_io);
+
+    ptx_sim_run(&fixed, &fixed_ctx, kHourMs, 100U);
+    ptx_sim_run_skip(&skip, &skip_ctx, kHourMs, 100U, PTX_NEXT_ALL);
+
+    EXPECT_EQ(fixed.stats.updates, skip.stats.updates);
+    EXPECT_EQ(fixed.stats.gas_on_ms, skip.stats.gas_on_ms);
+    EXPECT_DOUBLE_EQ(fixed.temp_c, skip.temp_c);
+}
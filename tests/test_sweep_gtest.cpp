@@ -0,0 +1,102 @@
+/**
+ * @file test_sweep_gtest.cpp
+ * @brief Google Test suite for the parallel configuration sweep
+ */
+#include <gtest/gtest.h>
+#include <vector>
+#include "tools/ptx_sweep.h"
+
+static const uint32_t kHourMs = 3600U * 1000U;
+
+class SweepTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ptx_oven_reset_config_to_defaults();
+        base = *ptx_oven_get_config();
+        ptx_sim_default_params(&settings.plant);
+        settings.duration_ms = 2U * kHourMs;
+        settings.skip_events = 0;
+    }
+
+    ptx_oven_config_t base;
+    ptx_sweep_settings_t settings;
+};
+
+TEST_F(SweepTest, GridCoversEverySpaceCorner) {
+    ptx_sweep_space_t space = { { 160.0, 200.0, 3U }, { 2.0, 4.0, 2U }, { 3000.0, 3000.0, 1U } };
+    ASSERT_EQ(6U, ptx_sweep_grid(&base, &space, NULL, 0));
+
+    ptx_sweep_result_t r[6];
+    ASSERT_EQ(6U, ptx_sweep_grid(&base, &space, r, 6));
+    EXPECT_FLOAT_EQ(160.0f, r[0].config.temp_target_c);
+    EXPECT_FLOAT_EQ(2.0f, r[0].config.temp_delta_c);
+    EXPECT_FLOAT_EQ(180.0f, r[2].config.temp_target_c);
+    EXPECT_FLOAT_EQ(200.0f, r[5].config.temp_target_c);
+    EXPECT_FLOAT_EQ(4.0f, r[5].config.temp_delta_c);
+    for (const ptx_sweep_result_t& x : r) {
+        EXPECT_EQ(3000U, x.config.ignition_duration_ms);
+        EXPECT_EQ(base.max_ignition_attempts, x.config.max_ignition_attempts) << "Unswept fields from base";
+    }
+}
+
+TEST_F(SweepTest, SampleStaysInsideTheSpace) {
+    ptx_sweep_space_t space = { { 150.0, 210.0, 0U }, { 1.0, 8.0, 0U }, { 2000.0, 6000.0, 0U } };
+    ptx_sweep_result_t a[64], b[64];
+    ptx_sweep_sample(&base, &space, 7U, a, 64);
+    ptx_sweep_sample(&base, &space, 7U, b, 64);
+
+    for (int i = 0; i < 64; ++i) {
+        EXPECT_GE(a[i].config.temp_target_c, 150.0f);
+        EXPECT_LE(a[i].config.temp_target_c, 210.0f);
+        EXPECT_GE(a[i].config.temp_delta_c, 1.0f);
+        EXPECT_LE(a[i].config.temp_delta_c, 8.0f);
+        EXPECT_GE(a[i].config.ignition_duration_ms, 2000U);
+        EXPECT_LE(a[i].config.ignition_duration_ms, 6000U);
+        EXPECT_EQ(a[i].config.temp_target_c, b[i].config.temp_target_c) << "Same seed, same sample";
+    }
+}
+
+TEST_F(SweepTest, WiderBandFewerIgnitions) {
+    ptx_sweep_result_t narrow, wide;
+    narrow.config = base;
+    narrow.config.temp_delta_c = 1.0f;
+    wide.config = base;
+    wide.config.temp_delta_c = 10.0f;
+
+    ptx_sweep_run_one(&settings, &narrow);
+    ptx_sweep_run_one(&settings, &wide);
+
+    ASSERT_NE(PTX_SIM_NEVER, narrow.reach_ms);
+    ASSERT_NE(PTX_SIM_NEVER, wide.reach_ms);
+    EXPECT_GT(narrow.ignitions, wide.ignitions);
+    EXPECT_LT(narrow.overshoot_c, wide.overshoot_c);
+}
+
+TEST_F(SweepTest, ThreadCountDoesNotChangeResults) {
+    ptx_sweep_space_t space = { { 170.0, 190.0, 3U }, { 2.0, 6.0, 3U }, { 3000.0, 5000.0, 2U } };
+    uint32_t n = ptx_sweep_grid(&base, &space, NULL, 0);
+    std::vector<ptx_sweep_result_t> serial(n), parallel(n);
+    ptx_sweep_grid(&base, &space, serial.data(), n);
+    ptx_sweep_grid(&base, &space, parallel.data(), n);
+
+    EXPECT_EQ(1U, ptx_sweep_run(&settings, serial.data(), n, 1));
+    EXPECT_EQ(4U, ptx_sweep_run(&settings, parallel.data(), n, 4));
+
+    for (uint32_t i = 0; i < n; ++i) {
+        EXPECT_EQ(serial[i].ignitions, parallel[i].ignitions) << "run " << i;
+        EXPECT_EQ(serial[i].gas_on_ms, parallel[i].gas_on_ms) << "run " << i;
+        EXPECT_EQ(serial[i].reach_ms, parallel[i].reach_ms) << "run " << i;
+        EXPECT_DOUBLE_EQ(serial[i].overshoot_c, parallel[i].overshoot_c) << "run " << i;
+        EXPECT_GT(parallel[i].gas_on_ms, 0U) << "every run executed";
+    }
+}
+
+TEST_F(SweepTest, MoreThreadsThanRuns) {
+    ptx_sweep_result_t r[2];
+    r[0].config = base;
+    r[1].config = base;
+    settings.duration_ms = 60000U;
+    EXPECT_EQ(2U, ptx_sweep_run(&settings, r, 2, 16));
+    EXPECT_EQ(r[0].gas_on_ms, r[1].gas_on_ms);
+    EXPECT_GT(r[0].ignitions, 0U);
+}
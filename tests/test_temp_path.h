@@ -0,0 +1,28 @@
+/**
+ * @file test_temp_path.h
+ * @brief Scratch file names for tests that write files
+ * @details The same test can run in several executables at once under
+ *          ctest -j: the name carries the test and the process id.
+ */
+#pragma once
+
+#include <gtest/gtest.h>
+#include <string>
+
+#if defined(_WIN32)
+#include <process.h>
+#define PTI_TEST_PID() _getpid()
+#else
+#include <unistd.h>
+#define PTI_TEST_PID() getpid()
+#endif
+
+// TempDir()/<prefix>_<suite>.<test>_<pid>.bin
+static inline std::string test_temp_path(const char* prefix) {
+    const ::testing::TestInfo* info = ::testing::UnitTest::GetInstance()->current_test_info();
+    std::string name = prefix;
+    if (info != NULL) {
+        name += std::string("_") + info->test_suite_name() + "." + info->name();
+    }
+    return ::testing::TempDir() + name + "_" + std::to_string((long)PTI_TEST_PID()) + ".bin";
+}
@@ -0,0 +1,136 @@
+/**
+ * @file test_temperature_gtest.cpp
+ * @brief Google Test suite for the float/fixed-point sensor pipelines and calibration tables
+ */
+#include <gtest/gtest.h>
+#include <cmath>
+#include "ptx_temperature.h"
+#include "ptx_oven_config.h"
+
+// Documented agreement of the fixed-point path with the float path
+static const int32_t kToleranceMc = 2;
+
+TEST(TemperatureTest, FixedPointMatchesFloatAcrossRange) {
+    const ptx_cal_table_t* cal = ptx_cal_get_table(PTX_CAL_PROFILE_NOMINAL);
+    ptx_temp_recip_t cache;
+    ptx_temp_recip_reset(&cache);
+
+    for (uint32_t vref = 4000; vref <= 6000; vref += 7) {
+        for (uint32_t signal = 0; signal <= vref; signal += 3) {
+            uint16_t v = (uint16_t)vref;
+            uint16_t s = (uint16_t)signal;
+            bool on_boundary = (signal * 100U == vref * PTX_SIGNAL_MIN_PCT) ||
+                               (signal * 100U == vref * PTX_SIGNAL_MAX_PCT);
+            if (on_boundary) continue;
+
+            float expected_c = ptx_temp_compute_c(cal, (float)v, (float)s);
+            int32_t fixed_mc = ptx_temp_compute_mc(cal, &cache, v, s);
+            int32_t float_mc = (int32_t)lroundf(expected_c * 1000.0f);
+            ASSERT_NEAR(float_mc, fixed_mc, kToleranceMc) << "vref=" << vref << " signal=" << signal;
+
+            float lo = 0.10f * v;
+            float hi = 0.90f * v;
+            bool float_in_range = !((s < lo) || (s > hi));
+            ASSERT_EQ(float_in_range, ptx_temp_signal_in_range(v, s)) << "vref=" << vref << " signal=" << signal;
+        }
+    }
+}
+
+TEST(TemperatureTest, FixedPointSaturates) {
+    const ptx_cal_table_t* cal = ptx_cal_get_table(PTX_CAL_PROFILE_NOMINAL);
+    ptx_temp_recip_t cache;
+    ptx_temp_recip_reset(&cache);
+
+    EXPECT_EQ(PTX_TEMP_MIN_MC, ptx_temp_compute_mc(cal, &cache, 5000, 500));
+    EXPECT_EQ(PTX_TEMP_MAX_MC, ptx_temp_compute_mc(cal, &cache, 5000, 4500));
+    EXPECT_EQ(PTX_TEMP_MAX_MC, ptx_temp_compute_mc(cal, &cache, 0, 10));
+    EXPECT_EQ(PTX_TEMP_MIN_MC, ptx_temp_compute_mc(cal, &cache, 0, 0));
+}
+
+TEST(TemperatureTest, ReciprocalFollowsVref) {
+    const ptx_cal_table_t* cal = ptx_cal_get_table(PTX_CAL_PROFILE_NOMINAL);
+    ptx_temp_recip_t cache;
+    ptx_temp_recip_reset(&cache);
+
+    // 180 °C is ratio 0.59032 of vref
+    EXPECT_NEAR(180000, ptx_temp_compute_mc(cal, &cache, 5000, 2952), 100);
+    EXPECT_EQ(5000, cache.vref_mv);
+    EXPECT_NEAR(180000, ptx_temp_compute_mc(cal, &cache, 4600, 2715), 100);
+    EXPECT_EQ(4600, cache.vref_mv);
+}
+
+TEST(CalibrationTest, NominalTableReproducesDatasheetCurve) {
+    const ptx_cal_table_t* cal = ptx_cal_get_table(PTX_CAL_PROFILE_NOMINAL);
+    for (int i = 100; i <= 900; ++i) {
+        double ratio = i / 1000.0;
+        double expected_mc = (387.5 * ratio - 48.75) * 1000.0;
+        uint32_t ratio_q32 = (uint32_t)(ratio * 4294967296.0);
+        ASSERT_NEAR(expected_mc, ptx_cal_lookup_mc(cal, ratio_q32), 2.0) << "ratio=" << ratio;
+        ASSERT_NEAR(expected_mc / 1000.0, ptx_cal_lookup_c(cal, (float)ratio), 0.002) << "ratio=" << ratio;
+    }
+    EXPECT_EQ(-10000, ptx_cal_temp_min_mc(cal));
+    EXPECT_EQ(300000, ptx_cal_temp_max_mc(cal));
+}
+
+TEST(CalibrationTest, MultiPointProfileFollowsItsPoints) {
+    const ptx_cal_table_t* cal = ptx_cal_get_table(PTX_CAL_PROFILE_BENCH_5PT);
+    const double points[][2] = {{0.30, 68.0}, {0.50, 145.6}, {0.70, 222.1}};
+    for (const auto& p : points) {
+        uint32_t ratio_q32 = (uint32_t)(p[0] * 4294967296.0);
+        // Grid interpolation rounds the corners between calibration points slightly
+        EXPECT_NEAR(p[1] * 1000.0, ptx_cal_lookup_mc(cal, ratio_q32), 500.0) << "ratio=" << p[0];
+    }
+    EXPECT_EQ(-10000, ptx_cal_temp_min_mc(cal));
+    EXPECT_EQ(297000, ptx_cal_temp_max_mc(cal));
+
+    // Monotonic over the valid window
+    int32_t prev = INT32_MIN;
+    for (uint32_t r = 429496730U; r < 3865470566U; r += 1000003U) {
+        int32_t t = ptx_cal_lookup_mc(cal, r);
+        ASSERT_GE(t, prev);
+        prev = t;
+    }
+}
+
+TEST(CalibrationTest, UnknownProfileFallsBackToNominal) {
+    EXPECT_EQ(ptx_cal_get_table(PTX_CAL_PROFILE_NOMINAL), ptx_cal_get_table(PTX_CAL_PROFILE_COUNT));
+}
+
+TEST(CalibrationTest, RatioThresholdMatchesLookupDecision) {
+    for (uint8_t profile = 0; profile < PTX_CAL_PROFILE_COUNT; ++profile) {
+        const ptx_cal_table_t* cal = ptx_cal_get_table(profile);
+        for (int32_t temp_mc = -20000; temp_mc <= 320000; temp_mc += 4999) {
+            uint32_t r = ptx_cal_ratio_above_q32(cal, temp_mc);
+            if ((r != 0U) && (r != 0xFFFFFFFFUL)) {
+                EXPECT_LE(ptx_cal_lookup_mc(cal, r - 1U), temp_mc) << "profile " << (int)profile;
+                EXPECT_GT(ptx_cal_lookup_mc(cal, r), temp_mc) << "profile " << (int)profile;
+            }
+            /* Any ratio: above the threshold exactly when the lookup is */
+            for (uint32_t ratio = 0x01234567UL; ratio < 0xF0000000UL; ratio += 0x0F0F0F0FUL) {
+                ASSERT_EQ(ptx_cal_lookup_mc(cal, ratio) > temp_mc, ratio >= r);
+            }
+        }
+    }
+}
+
+TEST(CalibrationTest, ConfigThresholdsAsRatios) {
+    ptx_oven_config_t config = *ptx_oven_get_config();
+    config.temp_target_c = 180.0f;
+    config.temp_delta_c = 2.0f;
+    ptx_oven_thresholds_t th;
+    ptx_oven_config_thresholds(&config, &th);
+
+    const ptx_cal_table_t* cal = ptx_cal_get_table(config.probe_profile);
+    ptx_temp_recip_t cache;
+    ptx_temp_recip_reset(&cache);
+
+    /* Deciding on the ratio is deciding on the temperature, reading by reading */
+    for (uint16_t signal = 500; signal <= 4500; ++signal) {
+        int32_t mc = ptx_temp_compute_mc(cal, &cache, 5000, signal);
+        uint32_t ratio = ptx_temp_ratio_q32(&cache, 5000, signal);
+        ASSERT_EQ(mc <= th.temp_on_mc, ratio < th.on_ratio_q32) << signal;
+        ASSERT_EQ(mc >= th.temp_off_mc, ratio >= th.off_ratio_q32) << signal;
+    }
+    EXPECT_LT(th.on_ratio_q32, th.off_ratio_q32);
+    EXPECT_EQ(0xFFFFFFFFUL, ptx_temp_ratio_q32(&cache, 5000, 5000)) << "Saturates instead of wrapping";
+}
@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""Decode a PTX deferred-log capture back into text.
+
+The firmware built with PTX_LOG_DEFERRED=1 sends binary records (see
+ptx_log_ring.h). Each record carries a file id and a line number instead of
+the format string. This tool scans the sources for log calls to rebuild the
+(file id, line) -> format table, then prints every record as
+
+    [time][file:line] message
+
+Bytes outside records (e.g. serial_printf() text) are passed through unchanged.
+
+Usage:
+    ptx_log_decode.py [--src DIR] [capture.bin]     (reads stdin if no file)
+"""
+import argparse
+import os
+import re
+import struct
+import sys
+
+SYNC = 0xA5
+HEADER_PAYLOAD = 8          # timestamp, file id, line
+SOURCE_EXTS = (".c", ".cpp", ".h", ".ino")
+LOG_CALL = re.compile(r"\bPTX_(?:DBG_)?LOG\w*\s*\(")
+STRING = re.compile(r'\s*"((?:[^"\\]|\\.)*)"')
+C_SPEC = re.compile(r"%([-+ 0#]*\d*(?:\.\d+)?)(?:hh|h|ll|l|z|j|t)?([diuxXcs%])")
+
+
+def fnv1a_fold16(name):
+    h = 2166136261
+    for b in name.encode():
+        h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    return ((h >> 16) ^ (h & 0xFFFF)) & 0xFFFF
+
+
+def unescape(literal):
+    return bytes(literal, "utf-8").decode("unicode_escape").encode("latin-1").decode("utf-8", "replace")
+
+
+def scan_sources(src_dir):
+    """Map (file id, line) -> (basename, format)."""
+    table = {}
+    for root, dirs, files in os.walk(src_dir):
+        dirs[:] = [d for d in dirs if not d.startswith((".", "_", "build"))]
+        for name in files:
+            if not name.endswith(SOURCE_EXTS):
+                continue
+            with open(os.path.join(root, name), encoding="utf-8", errors="replace") as f:
+                text = f.read()
+            file_id = fnv1a_fold16(name)
+            for call in LOG_CALL.finditer(text):
+                line = text.count("\n", 0, call.start()) + 1
+                pos = call.end()
+                parts = []
+                while True:
+                    m = STRING.match(text, pos)
+                    if not m:
+                        break
+                    parts.append(unescape(m.group(1)))
+                    pos = m.end()
+                # PTX_LOG(msg) with a non-literal message carries it as a string argument
+                fmt = "".join(parts) if parts else "%s"
+                table[(file_id, line)] = (name, fmt)
+    return table
+
+
+def to_python_format(fmt):
+    def conv(m):
+        flags, kind = m.group(1), m.group(2)
+        if kind == "%":
+            return "%%"
+        if kind in "iu":
+            kind = "d"
+        return "%" + flags + kind
+    return C_SPEC.sub(conv, fmt)
+
+
+def parse_args(payload):
+    args = []
+    pos = HEADER_PAYLOAD
+    while pos < len(payload):
+        tag = payload[pos]
+        if tag == ord("i") and pos + 5 <= len(payload):
+            args.append(struct.unpack_from("<i", payload, pos + 1)[0])
+            pos += 5
+        elif tag == ord("s") and pos + 2 <= len(payload):
+            n = payload[pos + 1]
+            args.append(payload[pos + 2:pos + 2 + n].decode("utf-8", "replace"))
+            pos += 2 + n
+        else:
+            return None
+    return args
+
+
+def format_record(table, payload):
+    time_ms, file_id, line = struct.unpack_from("<IHH", payload, 0)
+    args = parse_args(payload)
+    name, fmt = table.get((file_id, line), ("%04x" % file_id, None))
+    if fmt is None or args is None:
+        msg = "<unknown record %r>" % (args,)
+    else:
+        try:
+            msg = to_python_format(fmt) % tuple(args)
+        except (TypeError, ValueError):
+            msg = "%s %r" % (fmt, args)
+    return "[%d][%s:%d] %s" % (time_ms, name, line, msg)
+
+
+def decode(stream, table, out):
+    data = stream.read()
+    pos = 0
+    text = bytearray()
+    while pos < len(data):
+        if data[pos] == SYNC and pos + 2 <= len(data):
+            length = data[pos + 1]
+            payload = data[pos + 2:pos + 2 + length]
+            if length >= HEADER_PAYLOAD and len(payload) == length and parse_args(payload) is not None:
+                if text:
+                    out.write(text.decode("utf-8", "replace"))
+                    text.clear()
+                out.write(format_record(table, payload) + "\n")
+                pos += 2 + length
+                continue
+        text.append(data[pos])
+        pos += 1
+    if text:
+        out.write(text.decode("utf-8", "replace"))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--src", default=os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."),
+                        help="source tree to scan for log calls (default: repository root)")
+    parser.add_argument("capture", nargs="?", help="binary capture file (default: stdin)")
+    opts = parser.parse_args()
+
+    table = scan_sources(opts.src)
+    if opts.capture:
+        with open(opts.capture, "rb") as f:
+            decode(f, table, sys.stdout)
+    else:
+        decode(sys.stdin.buffer, table, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
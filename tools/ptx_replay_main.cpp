@@ -0,0 +1,56 @@
+/**
+ * @file ptx_replay_main.cpp
+ * @brief Replay captured traces through the controller and report differences
+ * @details Usage: ptx_replay TRACE...
+ *
+ *          Exit status 0 if every trace replays to the same commands, 1 if any
+ *          differs, 2 if a file is not a trace or was recorded with other
+ *          PTX_OVERSAMPLE_BITS.
+ */
+#include <stdio.h>
+#include <chrono>
+#include "tests/replay/ptx_replay.h"
+#include "ptx_sensor_filter.h"
+
+int main(int argc, char** argv) {
+    int status = 0;
+
+    if (argc < 2) {
+        fprintf(stderr, "usage: ptx_replay TRACE...\n");
+        return 2;
+    }
+    for (int i = 1; i < argc; ++i) {
+        ptx_trace_map_t map;
+        ptx_replay_result_t r;
+
+        if (!ptx_trace_map(&map, argv[i])) {
+            fprintf(stderr, "%s: not a trace (version %u)\n", argv[i], (unsigned)PTX_TRACE_VERSION);
+            status = 2;
+            continue;
+        }
+        if (map.header->oversample_bits != PTX_OVERSAMPLE_BITS) {
+            fprintf(stderr, "%s: recorded with PTX_OVERSAMPLE_BITS=%u, this build has %u\n", argv[i],
+                    (unsigned)map.header->oversample_bits, (unsigned)PTX_OVERSAMPLE_BITS);
+            ptx_trace_unmap(&map);
+            status = 2;
+            continue;
+        }
+
+        auto t0 = std::chrono::steady_clock::now();
+        bool same = ptx_replay_run(&map, &r);
+        double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        printf("%s: %lu updates, %lu door edges in %.2f s: ", argv[i],
+               (unsigned long)r.updates, (unsigned long)r.doors, wall_s);
+        if (same) {
+            printf("identical\n");
+        } else {
+            printf("%lu mismatches, first at record %lu: flags %02x, replay %02x\n",
+                   (unsigned long)r.mismatches, (unsigned long)r.first_mismatch,
+                   r.expected_flags, r.actual_flags);
+            if (status == 0) status = 1;
+        }
+        ptx_trace_unmap(&map);
+    }
+    return status;
+}
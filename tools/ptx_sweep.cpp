@@ -0,0 +1,173 @@
+/**
+ * @file ptx_sweep.cpp
+ * @brief Implementation of the parallel configuration sweep
+ */
+#include "tools/ptx_sweep.h"
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Value k of a range
+static double pti_sweep_value(const ptx_sweep_range_t* r, uint32_t k) {
+    if (r->steps <= 1U) return r->min;
+    return r->min + (r->max - r->min) * (double)k / (double)(r->steps - 1U);
+}
+
+static uint32_t pti_sweep_steps(const ptx_sweep_range_t* r) {
+    return (r->steps == 0U) ? 1U : r->steps;
+}
+
+static void pti_sweep_apply(ptx_oven_config_t* cfg, double target_c, double delta_c, double ignition_ms) {
+    cfg->temp_target_c = (float)target_c;
+    cfg->temp_delta_c = (float)delta_c;
+    cfg->ignition_duration_ms = (uint32_t)(ignition_ms + 0.5);
+}
+
+uint32_t ptx_sweep_grid(const ptx_oven_config_t* base, const ptx_sweep_space_t* space,
+                        ptx_sweep_result_t* results, uint32_t max) {
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < pti_sweep_steps(&space->temp_target_c); ++i) {
+        for (uint32_t j = 0; j < pti_sweep_steps(&space->temp_delta_c); ++j) {
+            for (uint32_t k = 0; k < pti_sweep_steps(&space->ignition_duration_ms); ++k, ++n) {
+                if (n >= max) continue;
+                results[n].config = *base;
+                pti_sweep_apply(&results[n].config,
+                                pti_sweep_value(&space->temp_target_c, i),
+                                pti_sweep_value(&space->temp_delta_c, j),
+                                pti_sweep_value(&space->ignition_duration_ms, k));
+            }
+        }
+    }
+    return n;
+}
+
+// Uniform sample in [min, max] (xorshift32)
+static double pti_sweep_uniform(uint32_t* rng, const ptx_sweep_range_t* r) {
+    uint32_t x = *rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *rng = x;
+    return r->min + (r->max - r->min) * ((double)x / 4294967295.0);
+}
+
+void ptx_sweep_sample(const ptx_oven_config_t* base, const ptx_sweep_space_t* space,
+                      uint32_t seed, ptx_sweep_result_t* results, uint32_t count) {
+    uint32_t rng = (seed != 0U) ? seed : 1U;
+    for (uint32_t n = 0; n < count; ++n) {
+        double target_c = pti_sweep_uniform(&rng, &space->temp_target_c);
+        double delta_c = pti_sweep_uniform(&rng, &space->temp_delta_c);
+        double ignition_ms = pti_sweep_uniform(&rng, &space->ignition_duration_ms);
+        results[n].config = *base;
+        pti_sweep_apply(&results[n].config, target_c, delta_c, ignition_ms);
+    }
+}
+
+void ptx_sweep_run_one(const ptx_sweep_settings_t* settings, ptx_sweep_result_t* result) {
+    const ptx_oven_config_t* cfg = &result->config;
+    uint32_t period_ms = (cfg->iteration_period != 0U) ? cfg->iteration_period : 100U;
+
+    ptx_sim_params_t plant = settings->plant;
+    plant.setpoint_c = cfg->temp_target_c;
+    ptx_sim_t sim;
+    ptx_sim_init(&sim, &plant, 0);
+
+    ptx_oven_ctx_t ctx;
+    ptx_io_table_t io = ptx_sim_io(&sim);
+    ptx_oven_control_init_ctx(&ctx, cfg, &io);
+
+    if (settings->skip_events != 0U) {
+        ptx_sim_run_skip(&sim, &ctx, settings->duration_ms, period_ms, settings->skip_events);
+    } else {
+        ptx_sim_run(&sim, &ctx, settings->duration_ms, period_ms);
+    }
+
+    double over = sim.stats.max_temp_c - cfg->temp_target_c;
+    result->overshoot_c = (over > 0.0) ? over : 0.0;
+    result->ignitions = sim.stats.ignitions;
+    result->gas_on_ms = sim.stats.gas_on_ms;
+    result->reach_ms = sim.stats.reach_ms;
+    result->final_temp_c = sim.temp_c;
+}
+
+/* Work-stealing pool: one slice of run indices per worker */
+typedef struct {
+    std::mutex lock;
+    uint32_t   begin;
+    uint32_t   end;
+} pti_sweep_slice_t;
+
+// Next index of the worker's own slice, false if empty
+static bool pti_sweep_take(pti_sweep_slice_t* slice, uint32_t* index) {
+    std::lock_guard<std::mutex> guard(slice->lock);
+    if (slice->begin == slice->end) return false;
+    *index = slice->begin++;
+    return true;
+}
+
+// Move the upper half of the largest other slice into the worker's own, false if all are empty
+static bool pti_sweep_steal(pti_sweep_slice_t* slices, uint32_t workers, uint32_t self) {
+    for (;;) {
+        uint32_t victim = self;
+        uint32_t most = 0;
+        for (uint32_t w = 0; w < workers; ++w) {
+            if (w == self) continue;
+            std::lock_guard<std::mutex> guard(slices[w].lock);
+            uint32_t left = slices[w].end - slices[w].begin;
+            if (left > most) {
+                most = left;
+                victim = w;
+            }
+        }
+        if (victim == self) return false;
+
+        uint32_t begin, end;
+        {
+            std::lock_guard<std::mutex> guard(slices[victim].lock);
+            uint32_t left = slices[victim].end - slices[victim].begin;
+            if (left == 0U) continue;       /* Drained meanwhile: look again */
+            end = slices[victim].end;
+            begin = end - (left + 1U) / 2U;
+            slices[victim].end = begin;
+        }
+        std::lock_guard<std::mutex> guard(slices[self].lock);
+        slices[self].begin = begin;
+        slices[self].end = end;
+        return true;
+    }
+}
+
+uint32_t ptx_sweep_run(const ptx_sweep_settings_t* settings, ptx_sweep_result_t* results,
+                       uint32_t count, uint32_t threads) {
+    if (threads == 0U) {
+        threads = std::thread::hardware_concurrency();
+        if (threads == 0U) threads = 1U;
+    }
+    if (threads > count) threads = (count > 0U) ? count : 1U;
+
+    std::unique_ptr<pti_sweep_slice_t[]> slices(new pti_sweep_slice_t[threads]);
+    for (uint32_t w = 0; w < threads; ++w) {
+        slices[w].begin = (uint32_t)((uint64_t)count * w / threads);
+        slices[w].end = (uint32_t)((uint64_t)count * (w + 1U) / threads);
+    }
+
+    auto worker = [&](uint32_t self) {
+        uint32_t index;
+        do {
+            while (pti_sweep_take(&slices[self], &index)) {
+                ptx_sweep_run_one(settings, &results[index]);
+            }
+        } while (pti_sweep_steal(slices.get(), threads, self));
+    };
+
+    std::vector<std::thread> pool;
+    for (uint32_t w = 1; w < threads; ++w) {
+        pool.emplace_back(worker, w);
+    }
+    worker(0);
+    for (std::thread& t : pool) {
+        t.join();
+    }
+    return threads;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file ptx_sweep.h
+ * @brief Parallel closed-loop parameter sweep over oven configurations (host tool)
+ * @details Every configuration is run as an independent ptx_oven_ctx_t against
+ *          its own simulated plant (tests/sim/ptx_sim.h) and scored on
+ *          overshoot, ignition count, gas-on time and time to setpoint. Runs
+ *          are spread across threads by a work-stealing pool: each worker
+ *          owns a contiguous slice of the configurations, and an idle worker
+ *          takes the upper half of the largest slice left, so slow runs
+ *          (e.g. a configuration that never settles) do not hold the others up.
+ *
+ *          All runs use the same plant parameters and noise seed, so results
+ *          differ only by configuration, and a sweep gives the same numbers
+ *          for any thread count.
+ *
+ * @note Build with PTX_PROFILE_ENABLED=0: the stage profiler is process-wide
+ *       and is not meant to be updated from several threads.
+ */
+#ifndef PTX_SWEEP_H
+#define PTX_SWEEP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ptx_oven_config.h"
+#include "tests/sim/ptx_sim.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief One swept parameter: steps values evenly spaced over [min, max]
+ * @note steps == 1 uses min only.
+ */
+typedef struct {
+    double   min;
+    double   max;
+    uint32_t steps;
+} ptx_sweep_range_t;
+
+/**
+ * @brief Parameter space of a sweep
+ */
+typedef struct {
+    ptx_sweep_range_t temp_target_c;
+    ptx_sweep_range_t temp_delta_c;
+    ptx_sweep_range_t ignition_duration_ms;
+} ptx_sweep_space_t;
+
+/**
+ * @brief Settings shared by every run of a sweep
+ */
+typedef struct {
+    ptx_sim_params_t plant;     // setpoint_c is replaced by each run's temp_target_c
+    uint32_t duration_ms;       // Simulated time per run
+    uint8_t  skip_events;       // 0: fixed-step runs, else PTX_NEXT_* mask for ptx_sim_run_skip()
+} ptx_sweep_settings_t;
+
+/**
+ * @brief One configuration and its score
+ */
+typedef struct {
+    ptx_oven_config_t config;   // Input
+    double   overshoot_c;       // Highest plant temperature above temp_target_c (0 if never above)
+    uint32_t ignitions;         // Igniter off-to-on edges
+    uint32_t gas_on_ms;         // Time with the valve open
+    uint32_t reach_ms;          // Time to temp_target_c, PTX_SIM_NEVER if not reached
+    double   final_temp_c;      // Plant temperature at the end of the run
+} ptx_sweep_result_t;
+
+/**
+ * @brief Fill results with the full grid of a parameter space
+ * @param base Configuration for every parameter not swept
+ * @return Number of grid points; only the first max are written
+ */
+uint32_t ptx_sweep_grid(const ptx_oven_config_t* base, const ptx_sweep_space_t* space,
+                        ptx_sweep_result_t* results, uint32_t max);
+
+/**
+ * @brief Fill results with count configurations sampled uniformly from a parameter space
+ * @note Reproducible for a given seed; steps is ignored.
+ */
+void ptx_sweep_sample(const ptx_oven_config_t* base, const ptx_sweep_space_t* space,
+                      uint32_t seed, ptx_sweep_result_t* results, uint32_t count);
+
+/**
+ * @brief Run and score one configuration (results->config must be set)
+ */
+void ptx_sweep_run_one(const ptx_sweep_settings_t* settings, ptx_sweep_result_t* result);
+
+/**
+ * @brief Run and score count configurations
+ * @param threads Worker threads, 0 for one per hardware thread
+ * @return Threads used
+ */
+uint32_t ptx_sweep_run(const ptx_sweep_settings_t* settings, ptx_sweep_result_t* results,
+                       uint32_t count, uint32_t threads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_SWEEP_H */
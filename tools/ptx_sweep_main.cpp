@@ -0,0 +1,124 @@
+/**
+ * @file ptx_sweep_main.cpp
+ * @brief Command line front end of the configuration sweep
+ * @details Prints one CSV line per configuration:
+ *
+ *              target_c,delta_c,ignition_ms,overshoot_c,ignitions,gas_on_s,reach_s,final_c
+ *
+ *          reach_s is empty when the setpoint was never reached.
+ *
+ * Usage:
+ *     ptx_sweep [--target MIN:MAX:STEPS] [--delta MIN:MAX:STEPS] [--ignition MIN:MAX:STEPS]
+ *               [--random N] [--seed S] [--hours H] [--noise MV] [--threads T] [--skip]
+ *
+ *     --random N  sample N configurations instead of the grid (STEPS ignored)
+ *     --skip      next-event time skipping (forces a noise-free probe)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+#include "tools/ptx_sweep.h"
+
+static void pti_usage(void) {
+    fprintf(stderr,
+            "usage: ptx_sweep [--target MIN:MAX:STEPS] [--delta MIN:MAX:STEPS]\n"
+            "                 [--ignition MIN:MAX:STEPS] [--random N] [--seed S]\n"
+            "                 [--hours H] [--noise MV] [--threads T] [--skip]\n");
+}
+
+static bool pti_parse_range(const char* text, ptx_sweep_range_t* r) {
+    unsigned steps = 1U;
+    int n = sscanf(text, "%lf:%lf:%u", &r->min, &r->max, &steps);
+    if (n == 1) r->max = r->min;
+    r->steps = steps;
+    return (n >= 1) && (steps >= 1U);
+}
+
+int main(int argc, char** argv) {
+    ptx_sweep_space_t space = {
+        { 160.0, 200.0, 5U },       /* temp_target_c */
+        { 1.0, 10.0, 10U },         /* temp_delta_c */
+        { 2000.0, 8000.0, 4U },     /* ignition_duration_ms */
+    };
+    uint32_t random_count = 0;
+    uint32_t seed = 1U;
+    double hours = 8.0;
+    uint32_t threads = 0;
+
+    ptx_sweep_settings_t settings;
+    ptx_sim_default_params(&settings.plant);
+    settings.skip_events = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        bool ok = true;
+
+        if (strcmp(arg, "--skip") == 0) {
+            settings.skip_events = PTX_NEXT_IGNITION | PTX_NEXT_TEMP;
+            continue;
+        }
+        if (val == NULL) {
+            ok = false;
+        } else if (strcmp(arg, "--target") == 0) {
+            ok = pti_parse_range(val, &space.temp_target_c);
+        } else if (strcmp(arg, "--delta") == 0) {
+            ok = pti_parse_range(val, &space.temp_delta_c);
+        } else if (strcmp(arg, "--ignition") == 0) {
+            ok = pti_parse_range(val, &space.ignition_duration_ms);
+        } else if (strcmp(arg, "--random") == 0) {
+            random_count = (uint32_t)strtoul(val, NULL, 10);
+        } else if (strcmp(arg, "--seed") == 0) {
+            seed = (uint32_t)strtoul(val, NULL, 10);
+        } else if (strcmp(arg, "--hours") == 0) {
+            hours = atof(val);
+        } else if (strcmp(arg, "--noise") == 0) {
+            settings.plant.noise_mv = atof(val);
+        } else if (strcmp(arg, "--threads") == 0) {
+            threads = (uint32_t)strtoul(val, NULL, 10);
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            pti_usage();
+            return 2;
+        }
+        ++i;
+    }
+    settings.duration_ms = (uint32_t)(hours * 3600.0 * 1000.0);
+    if (settings.skip_events != 0U) {
+        settings.plant.noise_mv = 0.0;
+    }
+
+    ptx_oven_reset_config_to_defaults();
+    const ptx_oven_config_t* base = ptx_oven_get_config();
+
+    std::vector<ptx_sweep_result_t> results;
+    if (random_count > 0U) {
+        results.resize(random_count);
+        ptx_sweep_sample(base, &space, seed, results.data(), random_count);
+    } else {
+        results.resize(ptx_sweep_grid(base, &space, NULL, 0));
+        ptx_sweep_grid(base, &space, results.data(), (uint32_t)results.size());
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    uint32_t used = ptx_sweep_run(&settings, results.data(), (uint32_t)results.size(), threads);
+    double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    printf("target_c,delta_c,ignition_ms,overshoot_c,ignitions,gas_on_s,reach_s,final_c\n");
+    for (const ptx_sweep_result_t& r : results) {
+        printf("%.3f,%.3f,%lu,%.3f,%lu,%.1f,", r.config.temp_target_c, r.config.temp_delta_c,
+               (unsigned long)r.config.ignition_duration_ms, r.overshoot_c,
+               (unsigned long)r.ignitions, r.gas_on_ms / 1000.0);
+        if (r.reach_ms != PTX_SIM_NEVER) {
+            printf("%.1f", r.reach_ms / 1000.0);
+        }
+        printf(",%.3f\n", r.final_temp_c);
+    }
+    fprintf(stderr, "%zu runs x %.1f h on %lu threads in %.2f s\n",
+            results.size(), hours, (unsigned long)used, wall_s);
+    return 0;
+}